@@ -0,0 +1,1781 @@
+/*
+=============================================================================
+BENCHMARK UNIFICADO - PAA Assignment 1
+=============================================================================
+
+Substitui scalable_benchmark.cpp, benchmark_recursivo_vs_iterativo.cpp e
+benchmark_100M_only.cpp: tudo que era fixo em cada main() agora e flag,
+sem recompilar.
+
+  --structures L       linear,hash,hashdyn,octree,quadtree,octree-iter,quadtree-iter,hash-sharded,
+                       linear-par,octree-par,quadtree-par,linear-sorted,hybrid,hash-quantile,
+                       linear-t,hash-t,octree-t,quadtree-t,planner (lista em kStructureKeys)
+  --scales L           100,1K,10K,1M,50M (sufixos K/M)
+  --distributions L    uniforme,gaussiana,clusters,diagonal,real
+  --images DIR         pasta da distribuicao "real" (padrao ./images/)
+  --thresholds L       50,40
+  --query R,G,B        ponto de consulta (padrao 128,128,128)
+  --cell-size L        varredura do tamanho de celula (hash, hashdyn, hash-sharded, hash-t, hybrid,
+                       hash-quantile: as chaves de usesCellSize)
+  --leaf-capacity L    varredura de maxImagesPerNode (arvores)
+  --coord L            double,float,uint8: coordenada das estruturas -t (padrao double)
+  --frame L            rgb,pca: cada estrutura tambem no referencial dos eixos principais (-t so em rgb)
+  --threads L          1,2,4,8: vazao com consultas concorrentes
+  --queries N          consultas por thread na fase de vazao (padrao 10)
+  --seed N             seed dos datasets sinteticos (padrao 42)
+  --reps N / --json F / --csv F   ver headers/benchmark_report.h
+  --tune               tuner de cellSize/maxImagesPerNode (ver MODO TUNER)
+  --workload N         consultas da carga alvo do tuner (padrao 200)
+  --concurrent         leitores x 1 escritor, RWLock vs RCU (ver MODO CONCORRENTE)
+  --ingest             insercao paralela no hash particionado (ver MODO INGESTAO)
+  --shards L           shards do hash-sharded (padrao 64)
+  --pool L             threads do pool de linear-par/octree-par/quadtree-par (padrao: nucleos)
+  --cache              cache de resultados sob carga Zipf (ver MODO CACHE)
+  --cache-size L       entradas do cache (padrao 1024)
+  --zipf S             expoente da carga Zipf (padrao 1.0)
+  --quantum X          lado do cubo de cor da chave do cache (padrao 1.0)
+  --async              consultas assincronas com prazo e cancelamento (ver MODO ASSINCRONO)
+  --stream             forEachSimilar (visitante) x findSimilar (ver MODO STREAMING)
+  --planner            planejador por custo sobre as --structures (ver MODO PLANEJADOR)
+  --plan-log F         CSV com previsto x real de cada consulta do planejador
+  --selftest           verificacoes de corretude (ver MODO AUTOTESTE); sai com 1 se alguma falhar
+
+Equivalentes dos drivers antigos:
+  scalable_benchmark:     ./benchmark
+  recursivo vs iterativo: ./benchmark --structures quadtree,quadtree-iter,octree,octree-iter
+  100M:                   ./benchmark --scales 100M --seed 20 --leaf-capacity 15
+                                      --structures quadtree,octree,hash,linear
+
+Varreduras (--cell-size/--leaf-capacity com varios valores) geram uma
+configuracao por valor; estruturas que nao usam o parametro rodam uma vez.
+
+=============================================================================
+*/
+
+#include <iostream>
+#include <vector>
+#include <string>
+#include <chrono>
+#include <cmath>
+#include <random>
+#include <algorithm>
+#include <memory>
+#include <thread>
+#include <atomic>
+#include <sstream>
+#include <cstdio>
+#include <fstream>
+#include <future>
+
+#include "../headers/image.h"
+#include "../headers/structure_factory.h"
+#include "../headers/command_line.h"
+#include "../headers/dataset.h"
+#include "../headers/concurrent_index.h"
+#include "../headers/query_cache.h"
+#include "../headers/async_query.h"
+#include "../headers/memory_usage.h"
+#include "../headers/perf_counters.h"
+#include "../headers/query_stats.h"
+#include "../headers/benchmark_report.h"
+
+// ============================================================================
+// CONFIGURACAO (LINHA DE COMANDO)
+// ============================================================================
+struct BenchmarkConfig {
+    std::vector<std::string> structures = {"linear", "hash", "hashdyn", "octree", "quadtree"};
+    std::vector<long long> scales = {100, 1000, 10000, 100000, 500000, 1000000, 5000000, 10000000, 25000000, 50000000};
+    std::vector<std::string> distributions = {"uniforme"};
+    std::vector<double> thresholds = {50.0};
+    std::vector<double> cellSizes;      // vazio = padrao de cada estrutura
+    std::vector<int> leafCapacities;    // vazio = padrao de cada estrutura
+    std::vector<std::string> coords = {"double"};  // tipo de coordenada das estruturas -t
+    std::vector<std::string> frames = {"rgb"};      // referencial: rgb e/ou pca (pca_frame.h)
+    std::vector<int> shards = {ShardedHashSearch::DEFAULT_SHARDS};
+    std::vector<int> poolThreads;       // vazio = pool compartilhado (um worker por nucleo)
+    std::vector<int> threads;           // vazio = sem fase de vazao
+    double queryR = 128, queryG = 128, queryB = 128;
+    unsigned seed = 42;
+    int queriesPerThread = 10;
+    bool tune = false;                  // --tune: varredura + fronteira de Pareto
+    int workloadQueries = 200;          // consultas da carga alvo do tuner
+    bool workloadGiven = false;
+    bool concurrent = false;            // --concurrent: leitores concorrentes com um escritor
+    bool ingest = false;                // --ingest: insercao com varias threads
+    bool cache = false;                 // --cache: cache de resultados sob carga Zipf
+    std::vector<int> cacheSizes = {(int)CachedIndex::DEFAULT_CAPACITY};
+    double zipfExponent = 1.0;
+    double cacheQuantum = CachedIndex::DEFAULT_QUANTUM;
+    bool async = false;                 // --async: futures com prazo e cancelamento
+    bool stream = false;                // --stream: visitante com parada antecipada
+    bool planner = false;               // --planner: uma estrutura escolhida por consulta
+    std::string planLogPath;            // --plan-log: previsto x real por consulta
+    bool selftest = false;              // --selftest: verificacoes de corretude
+    std::string imagesPath = "./images/";
+    ReportOptions report;
+};
+
+const std::vector<std::string> kDistributions = {"uniforme", "gaussiana", "clusters", "diagonal", "real"};
+
+void printUsage(const char* program) {
+    printf("Uso: %s [opcoes]\n", program);
+    printf("  --structures L      linear,hash,hashdyn,octree,quadtree,octree-iter,quadtree-iter,hash-sharded,\n");
+    printf("                      linear-par,octree-par,quadtree-par (uma consulta usa as threads do pool)\n");
+    printf("                      linear-sorted (ordem Morton, blocos com caixa RGB)\n");
+    printf("                      hybrid (grade grossa, octree local nas celulas densas; --cell-size)\n");
+    printf("                      hash-quantile (fronteiras pelos quantis de cada canal; --cell-size)\n");
+    printf("                      linear-t,hash-t,octree-t,quadtree-t (templates, sem virtual por ponto)\n");
+    printf("                      planner (linear+hash+octree-iter, estrutura escolhida por consulta)\n");
+    printf("  --scales L          ex.: 100,10K,1M,50M\n");
+    printf("  --distributions L   uniforme,gaussiana,clusters,diagonal,real\n");
+    printf("  --images DIR        pasta da distribuicao real (padrao ./images/)\n");
+    printf("  --thresholds L      ex.: 40,50\n");
+    printf("  --query R,G,B       ponto de consulta (padrao 128,128,128)\n");
+    printf("  --cell-size L       tamanhos de celula (hash, hashdyn, hash-sharded, hash-t, hybrid, hash-quantile)\n");
+    printf("  --leaf-capacity L   maxImagesPerNode (octree*, quadtree*: -iter, -par e -t inclusos)\n");
+    printf("  --coord L           double,float,uint8: coordenada SO das estruturas -t (as demais sao double)\n");
+    printf("  --frame L           rgb,pca: pca roda pontos e consultas para os eixos principais dos dados (-t so em rgb)\n");
+    printf("  --threads L         vazao com T consultas concorrentes\n");
+    printf("  --queries N         consultas por thread na fase de vazao\n");
+    printf("  --tune              tuner: grade de parametros + fronteira de Pareto por escala\n");
+    printf("  --workload N        consultas da carga alvo do tuner (padrao 200)\n");
+    printf("  --concurrent        T leitores (--threads, padrao 1,2,4,8) + 1 escritor: RWLock vs RCU\n");
+    printf("  --ingest            insercao com T threads (--threads, padrao 1..32) no hash-sharded\n");
+    printf("  --shards L          shards do hash-sharded (padrao 64)\n");
+    printf("  --pool L            threads do pool das estruturas -par, contando a chamadora (padrao: nucleos)\n");
+    printf("  --cache             cache de resultados x estrutura pura, carga Zipf (--workload, padrao 20000)\n");
+    printf("  --cache-size L      entradas do cache (padrao 1024)\n");
+    printf("  --zipf S            expoente da carga Zipf sobre as cores repetidas (padrao 1.0)\n");
+    printf("  --quantum X         lado do cubo de cor da chave do cache (padrao 1.0)\n");
+    printf("  --async             consultas assincronas: prazos (fracoes da latencia mediana) e cancelamento\n");
+    printf("  --stream            forEachSimilar x findSimilar: latencia, primeiro resultado, bytes do vector\n");
+    printf("  --planner           planejador por custo sobre as --structures x cada estrutura fixa e o oraculo\n");
+    printf("  --plan-log F        CSV do planejador: caminho escolhido, custo previsto e real por consulta\n");
+    printf("  --selftest          verificacoes de corretude (pool aninhado...); codigo 1 se alguma falhar\n");
+    printf("  --seed N            seed dos datasets sinteticos\n");
+    printf("  --reps N            repeticoes da consulta (amostras para compare_results)\n");
+    printf("  --json F / --csv F  grava os resultados\n");
+}
+
+// Retorna false em flag desconhecida ou valor invalido
+bool parseArguments(int argc, char** argv, BenchmarkConfig& config) {
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg == "--help" || arg == "-h") return false;
+        if (arg == "--tune") {
+            config.tune = true;
+            continue;
+        }
+        if (arg == "--concurrent") {
+            config.concurrent = true;
+            continue;
+        }
+        if (arg == "--ingest") {
+            config.ingest = true;
+            continue;
+        }
+        if (arg == "--cache") {
+            config.cache = true;
+            continue;
+        }
+        if (arg == "--async") {
+            config.async = true;
+            continue;
+        }
+        if (arg == "--stream") {
+            config.stream = true;
+            continue;
+        }
+        if (arg == "--planner") {
+            config.planner = true;
+            continue;
+        }
+        if (arg == "--selftest") {
+            config.selftest = true;
+            continue;
+        }
+        if (i + 1 >= argc) {
+            printf("ERRO: %s requer um valor\n", arg.c_str());
+            return false;
+        }
+        std::string value = argv[++i];
+
+        if (arg == "--structures") {
+            config.structures = splitList(value);
+            for (const auto& key : config.structures) {
+                if (std::find(kStructureKeys.begin(), kStructureKeys.end(), key) == kStructureKeys.end()) {
+                    printf("ERRO: estrutura desconhecida '%s'\n", key.c_str());
+                    return false;
+                }
+            }
+        } else if (arg == "--scales") {
+            config.scales.clear();
+            for (const auto& item : splitList(value)) config.scales.push_back(parseScale(item));
+        } else if (arg == "--distributions") {
+            config.distributions = splitList(value);
+            for (const auto& dist : config.distributions) {
+                if (std::find(kDistributions.begin(), kDistributions.end(), dist) == kDistributions.end()) {
+                    printf("ERRO: distribuicao desconhecida '%s'\n", dist.c_str());
+                    return false;
+                }
+            }
+        } else if (arg == "--thresholds") {
+            config.thresholds.clear();
+            for (const auto& item : splitList(value)) config.thresholds.push_back(std::atof(item.c_str()));
+        } else if (arg == "--cell-size") {
+            config.cellSizes.clear();
+            for (const auto& item : splitList(value)) {
+                double size = 0.0;
+                if (!parsePositive(item, size)) {
+                    printf("ERRO: --cell-size deve ser positivo ('%s')\n", item.c_str());
+                    return false;
+                }
+                config.cellSizes.push_back(size);
+            }
+        } else if (arg == "--leaf-capacity") {
+            config.leafCapacities.clear();
+            for (const auto& item : splitList(value)) config.leafCapacities.push_back(std::max(1, std::atoi(item.c_str())));
+        } else if (arg == "--coord") {
+            config.coords = splitList(value);
+            for (const auto& coord : config.coords) {
+                if (std::find(kStaticCoords.begin(), kStaticCoords.end(), coord) == kStaticCoords.end()) {
+                    printf("ERRO: coordenada desconhecida '%s' (double,float,uint8)\n", coord.c_str());
+                    return false;
+                }
+            }
+        } else if (arg == "--frame") {
+            config.frames = splitList(value);
+            for (const auto& frame : config.frames) {
+                if (std::find(kFrames.begin(), kFrames.end(), frame) == kFrames.end()) {
+                    printf("ERRO: referencial desconhecido '%s' (rgb,pca)\n", frame.c_str());
+                    return false;
+                }
+            }
+        } else if (arg == "--shards") {
+            config.shards.clear();
+            for (const auto& item : splitList(value)) config.shards.push_back(std::max(1, std::atoi(item.c_str())));
+        } else if (arg == "--pool") {
+            config.poolThreads.clear();
+            for (const auto& item : splitList(value)) config.poolThreads.push_back(std::max(1, std::atoi(item.c_str())));
+        } else if (arg == "--threads") {
+            config.threads.clear();
+            for (const auto& item : splitList(value)) config.threads.push_back(std::max(1, std::atoi(item.c_str())));
+        } else if (arg == "--query") {
+            std::vector<std::string> rgb = splitList(value);
+            if (rgb.size() != 3) {
+                printf("ERRO: --query espera R,G,B\n");
+                return false;
+            }
+            config.queryR = std::atof(rgb[0].c_str());
+            config.queryG = std::atof(rgb[1].c_str());
+            config.queryB = std::atof(rgb[2].c_str());
+        } else if (arg == "--images") {
+            config.imagesPath = value;
+        } else if (arg == "--seed") {
+            config.seed = (unsigned)std::strtoul(value.c_str(), nullptr, 10);
+        } else if (arg == "--workload") {
+            config.workloadQueries = std::max(1, std::atoi(value.c_str()));
+            config.workloadGiven = true;
+        } else if (arg == "--cache-size") {
+            config.cacheSizes.clear();
+            for (const auto& item : splitList(value)) config.cacheSizes.push_back(std::max(1, std::atoi(item.c_str())));
+        } else if (arg == "--zipf") {
+            config.zipfExponent = std::max(0.0, std::atof(value.c_str()));
+        } else if (arg == "--quantum") {
+            config.cacheQuantum = std::atof(value.c_str());
+            if (config.cacheQuantum <= 0) {
+                printf("ERRO: --quantum deve ser positivo\n");
+                return false;
+            }
+        } else if (arg == "--queries") {
+            config.queriesPerThread = std::max(1, std::atoi(value.c_str()));
+        } else if (arg == "--reps") {
+            config.report.searchRepetitions = std::max(1, std::atoi(value.c_str()));
+        } else if (arg == "--plan-log") {
+            config.planLogPath = value;
+        } else if (arg == "--json") {
+            config.report.jsonPath = value;
+        } else if (arg == "--csv") {
+            config.report.csvPath = value;
+        } else {
+            printf("ERRO: opcao desconhecida '%s'\n", arg.c_str());
+            return false;
+        }
+    }
+    // --coord so existe nos templates: as estruturas dinamicas guardam Image (double)
+    bool anyStatic = std::any_of(config.structures.begin(), config.structures.end(), isStaticKey);
+    if (!anyStatic && config.coords != std::vector<std::string>{"double"}) {
+        printf("AVISO: --coord so afeta as estruturas -t (linear-t,hash-t,octree-t,quadtree-t)\n");
+    }
+    return !config.scales.empty() && !config.thresholds.empty() && !config.structures.empty();
+}
+
+// ============================================================================
+// VARREDURA DE PARAMETROS
+// ============================================================================
+// Produto cartesiano: cada estrutura x valores dos parametros que ela usa
+std::vector<StructureVariant> expandVariants(const BenchmarkConfig& config) {
+    std::vector<StructureVariant> variants;
+    for (const auto& key : config.structures) {
+        std::vector<StructureVariant> forKey;
+        if (usesCellSize(key)) {
+            std::vector<double> sizes = config.cellSizes.empty() ? std::vector<double>{defaultCellSize(key)}
+                                                                 : config.cellSizes;
+            for (double size : sizes) forKey.push_back({key, size, 0});
+        } else if (usesLeafCapacity(key)) {
+            std::vector<int> caps = config.leafCapacities.empty() ? std::vector<int>{defaultLeafCapacity(key)}
+                                                                  : config.leafCapacities;
+            for (int cap : caps) forKey.push_back({key, 0.0, cap});
+        } else {
+            forKey.push_back({key});
+        }
+
+        if (key == "hash-sharded") {
+            for (StructureVariant variant : forKey) {
+                for (int shardCount : config.shards) {
+                    variant.shards = shardCount;
+                    variants.push_back(variant);
+                }
+            }
+            continue;
+        }
+        if (usesPool(key) && !config.poolThreads.empty()) {
+            for (StructureVariant variant : forKey) {
+                for (int threads : config.poolThreads) {
+                    variant.poolThreads = threads;
+                    variants.push_back(variant);
+                }
+            }
+            continue;
+        }
+        if (!isStaticKey(key)) {
+            variants.insert(variants.end(), forKey.begin(), forKey.end());
+            continue;
+        }
+        // CellSize e inteiro no template (8 = grade 32^3 do HashSearch padrao)
+        for (StructureVariant variant : forKey) {
+            if (usesCellSize(key)) variant.cellSize = (double)std::lround(variant.cellSize);
+            if (!staticVariantSupported(variant)) continue;
+            for (const auto& coord : config.coords) {
+                variant.coord = coord;
+                variants.push_back(variant);
+            }
+        }
+    }
+    // --frame: cada variante em cada referencial (rgb = estrutura pura)
+    std::vector<StructureVariant> framed;
+    for (const auto& frame : config.frames) {
+        for (StructureVariant variant : variants) {
+            variant.frame = frame == "rgb" ? "" : frame;
+            if (frameSupported(variant)) framed.push_back(variant);
+        }
+    }
+    return framed;
+}
+
+// ============================================================================
+// SISTEMA DE BENCHMARK
+// ============================================================================
+
+// Vazao: T threads executando a mesma consulta sobre a estrutura ja construida
+double measureThroughput(const ImageDatabase& db, const Image& query, double threshold,
+                         int threadCount, int queriesPerThread) {
+    auto start = std::chrono::high_resolution_clock::now();
+    std::vector<std::thread> workers;
+    for (int t = 0; t < threadCount; t++) {
+        workers.emplace_back([&]() {
+            for (int q = 0; q < queriesPerThread; q++) {
+                auto results = db.findSimilar(query, threshold);
+            }
+        });
+    }
+    for (auto& worker : workers) worker.join();
+    auto end = std::chrono::high_resolution_clock::now();
+
+    double seconds = std::chrono::duration<double>(end - start).count();
+    return seconds > 0 ? (double)threadCount * queriesPerThread / seconds : 0.0;
+}
+
+// CREATE→TEST→DESTROY: constroi uma vez e mede uma consulta por threshold.
+// pooled: a busca roda em parte nos workers do pool (-par), fora dos contadores de hardware
+std::vector<BenchmarkRecord> benchmarkStructure(std::unique_ptr<ImageDatabase> db,
+                                                const std::vector<Image>& dataset,
+                                                const Image& query,
+                                                const BenchmarkConfig& config,
+                                                bool pooled = false) {
+    // Linha de base de memoria (dataset ja alocado)
+    resetPeakRSS();
+    RSSSample beforeBuild = sampleRSS();
+    PerfCounters perf;
+
+    // Teste de Insercao
+    perf.start();
+    auto startInsert = std::chrono::high_resolution_clock::now();
+    for (const auto& img : dataset) {
+        db->insert(img);
+    }
+    db->finishBuild();  // Construcao adiada conta como insercao (nao cai no memoryUsage abaixo)
+    auto endInsert = std::chrono::high_resolution_clock::now();
+    PerfSample buildPerf = perf.stop();
+    RSSSample afterBuild = sampleRSS();
+
+    BenchmarkRecord base;
+    base.driver = "benchmark";
+    base.structure = db->getName();
+    base.scale = dataset.size();
+    base.seed = config.seed;
+    base.insertMs = std::chrono::duration<double, std::milli>(endInsert - startInsert).count();
+    base.memory = db->memoryUsage();
+    base.rssBuildBytes = bytesAbove(afterBuild.current, beforeBuild.current);
+    base.buildPerf = buildPerf;
+
+    std::vector<BenchmarkRecord> records;
+    for (double threshold : config.thresholds) {
+        BenchmarkRecord record = base;
+        record.threshold = threshold;
+
+        // Teste de Busca
+        perf.start();
+        auto startSearch = std::chrono::high_resolution_clock::now();
+        auto results = db->findSimilar(query, threshold);
+        auto endSearch = std::chrono::high_resolution_clock::now();
+        record.searchPerf = perf.stop();
+        record.searchPerf.callerThreadOnly = pooled;
+        record.searchMs.push_back(std::chrono::duration<double, std::milli>(endSearch - startSearch).count());
+        record.found = results.size();
+        record.queryStats = db->lastQueryStats();
+
+        // Repeticoes da mesma consulta (amostras para compare_results)
+        for (int rep = 1; rep < config.report.searchRepetitions; rep++) {
+            auto startRep = std::chrono::high_resolution_clock::now();
+            auto repResults = db->findSimilar(query, threshold);
+            auto endRep = std::chrono::high_resolution_clock::now();
+            record.searchMs.push_back(std::chrono::duration<double, std::milli>(endRep - startRep).count());
+        }
+
+        // Busca const e contadores thread_local: leitores concorrentes sem lock
+        for (int threadCount : config.threads) {
+            record.throughput.emplace_back(threadCount,
+                measureThroughput(*db, query, threshold, threadCount, config.queriesPerThread));
+        }
+
+        RSSSample afterSearch = sampleRSS();
+        record.rssPeakBytes = bytesAbove(afterSearch.peak, beforeBuild.current);
+        record.rusagePeakBytes = afterSearch.rusagePeak;
+        records.push_back(record);
+    }
+
+    return records;
+}
+
+void printRecord(const BenchmarkRecord& record) {
+    printf("  %-32s thr=%-5.1f Insert=%.3fms, Search=%.3fms, Found=%lld\n",
+           record.structure.c_str(), record.threshold, record.insertMs, record.searchMs[0], record.found);
+    record.memory.print(record.scale);
+    printf("    RSS: construcao=+%.2fMB pico=+%.2fMB (ru_maxrss processo=%.2fMB)\n",
+           record.rssBuildBytes / 1048576.0, record.rssPeakBytes / 1048576.0,
+           record.rusagePeakBytes / 1048576.0);
+    record.buildPerf.print("insercao", record.scale);  // por imagem inserida
+    record.searchPerf.print("busca", 1);               // por consulta
+    if (kQueryStatsEnabled) record.queryStats.print(record.scale);
+    if (!record.throughput.empty()) {
+        printf("    Vazao:");
+        for (const auto& entry : record.throughput) printf(" %dT=%.0f q/s", entry.first, entry.second);
+        printf("\n");
+    }
+}
+
+// ============================================================================
+// MODO TUNER (--tune) - VARREDURA AUTOMATICA DE PARAMETROS
+// ============================================================================
+/*
+Para cada escala, constroi cada estrutura sobre uma grade de cellSize /
+maxImagesPerNode e mede:
+- construcao (ms), memoria estimada (bytes/imagem)
+- latencia da carga alvo: --workload consultas com pontos sorteados do
+  proprio dataset (a query tipica e uma imagem parecida com a colecao),
+  repetidas para cada --thresholds
+
+Uma configuracao e Pareto-otima quando nenhuma outra e melhor ou igual nas
+tres metricas e estritamente melhor em pelo menos uma. Um registro (e uma
+fronteira) por threshold: o compare_results agrupa por threshold, entao as
+latencias de um registro sao todas do threshold que ele declara.
+*/
+
+const std::vector<double> kTuneCellSizes = {4, 8, 12, 16, 25, 32, 48, 64};
+const std::vector<int> kTuneLeafCapacities = {4, 8, 16, 32, 64, 128};
+
+// Amostra sem reposicao (shuffle parcial com seed fixa)
+std::vector<Image> sampleDataset(const std::vector<Image>& source, long long count, unsigned seed) {
+    if ((long long)source.size() <= count) return source;
+    std::vector<size_t> indices(source.size());
+    for (size_t i = 0; i < indices.size(); i++) indices[i] = i;
+    std::mt19937 gen(seed);
+    std::vector<Image> sample;
+    sample.reserve(count);
+    for (long long i = 0; i < count; i++) {
+        std::uniform_int_distribution<size_t> pick(i, indices.size() - 1);
+        std::swap(indices[i], indices[pick(gen)]);
+        sample.push_back(source[indices[i]]);
+    }
+    return sample;
+}
+
+double meanOf(const std::vector<double>& values) {
+    return summarize(values).mean;
+}
+
+double percentileOf(std::vector<double> values, double p) {
+    if (values.empty()) return 0.0;
+    std::sort(values.begin(), values.end());
+    size_t index = std::min(values.size() - 1, (size_t)std::ceil(p * values.size()) - 1);
+    return values[index];
+}
+
+bool dominates(const BenchmarkRecord& a, const BenchmarkRecord& b) {
+    double aLat = meanOf(a.searchMs), bLat = meanOf(b.searchMs);
+    bool noWorse = a.insertMs <= b.insertMs && a.memory.total() <= b.memory.total() && aLat <= bLat;
+    bool better = a.insertMs < b.insertMs || a.memory.total() < b.memory.total() || aLat < bLat;
+    return noWorse && better;
+}
+
+// Marca record.pareto em cada registro nao dominado do grupo
+void markParetoFront(std::vector<BenchmarkRecord>& group) {
+    for (auto& candidate : group) {
+        candidate.pareto = true;
+        for (const auto& other : group) {
+            if (&other != &candidate && dominates(other, candidate)) {
+                candidate.pareto = false;
+                break;
+            }
+        }
+    }
+}
+
+// Uma construcao, um registro por threshold (mesmos insertMs/memoria, latencias daquele threshold)
+std::vector<BenchmarkRecord> tuneStructure(const StructureVariant& variant, const std::vector<Image>& dataset,
+                                           const std::vector<Image>& workload, const BenchmarkConfig& config) {
+    auto db = makeStructure(variant);
+
+    auto startInsert = std::chrono::high_resolution_clock::now();
+    for (const auto& img : dataset) {
+        db->insert(img);
+    }
+    db->finishBuild();  // Construcao adiada conta como insercao (nao cai no memoryUsage abaixo)
+    auto endInsert = std::chrono::high_resolution_clock::now();
+
+    BenchmarkRecord base;
+    base.driver = "benchmark --tune";
+    base.structure = db->getName();
+    base.scale = dataset.size();
+    base.seed = config.seed;
+    base.cellSize = variant.cellSize;
+    base.leafCapacity = variant.leafCapacity;
+    base.insertMs = std::chrono::duration<double, std::milli>(endInsert - startInsert).count();
+    base.memory = db->memoryUsage();
+
+    // Carga alvo: uma latencia por consulta
+    std::vector<BenchmarkRecord> records;
+    for (double threshold : config.thresholds) {
+        BenchmarkRecord record = base;
+        record.threshold = threshold;
+        for (const auto& query : workload) {
+            auto startSearch = std::chrono::high_resolution_clock::now();
+            auto results = db->findSimilar(query, threshold);
+            auto endSearch = std::chrono::high_resolution_clock::now();
+            record.searchMs.push_back(std::chrono::duration<double, std::milli>(endSearch - startSearch).count());
+            record.found += results.size();
+        }
+        records.push_back(std::move(record));
+    }
+    return records;
+}
+
+int runTuner(BenchmarkConfig& config) {
+    if (config.cellSizes.empty()) config.cellSizes = kTuneCellSizes;
+    if (config.leafCapacities.empty()) config.leafCapacities = kTuneLeafCapacities;
+    std::vector<StructureVariant> variants = expandVariants(config);
+    if (variants.empty()) {
+        // Os AVISOs de expandVariants explicam o motivo (ex.: -t sem instancia para o parametro)
+        printf("ERRO: nenhuma configuracao valida para o tuner\n");
+        return 1;
+    }
+
+    std::cout << "==================================================================================\n";
+    std::cout << " TUNER DE PARAMETROS - PAA Assignment 1\n";
+    std::cout << "==================================================================================\n\n";
+    printf("Configuracoes: %zu | Carga alvo: %d consultas x %zu thresholds | Seed: %u\n",
+           variants.size(), config.workloadQueries, config.thresholds.size(), config.seed);
+
+    // Dataset real carregado uma vez; cada escala usa uma amostra dele
+    std::vector<Image> realDataset;
+    if (std::find(config.distributions.begin(), config.distributions.end(), "real") != config.distributions.end()) {
+        long long maxScale = *std::max_element(config.scales.begin(), config.scales.end());
+        realDataset = loadRealDataset(maxScale, config.imagesPath);
+        printf("Dataset real: %zu imagens de %s\n", realDataset.size(), config.imagesPath.c_str());
+    }
+
+    std::vector<BenchmarkRecord> allResults;
+
+    for (long long scale : config.scales) {
+        for (const std::string& distribution : config.distributions) {
+            std::vector<Image> dataset = distribution == "real"
+                ? sampleDataset(realDataset, scale, config.seed)
+                : generateSyntheticDataset(scale, distribution, config.seed);
+            if (dataset.empty()) {
+                printf("\nAVISO: dataset vazio (%s), escala %lld ignorada\n", distribution.c_str(), scale);
+                continue;
+            }
+
+            std::vector<Image> workload;
+            std::mt19937 gen(config.seed + 1);
+            std::uniform_int_distribution<size_t> pick(0, dataset.size() - 1);
+            for (int q = 0; q < config.workloadQueries; q++) workload.push_back(dataset[pick(gen)]);
+
+            printf("\n[TUNER] Escala: %zu imagens | Distribuicao: %s\n", dataset.size(), distribution.c_str());
+
+            // groups[t]: todas as configuracoes no threshold t
+            std::vector<std::vector<BenchmarkRecord>> groups(config.thresholds.size());
+            for (const StructureVariant& variant : variants) {
+                std::vector<BenchmarkRecord> records = tuneStructure(variant, dataset, workload, config);
+                for (size_t t = 0; t < records.size(); t++) {
+                    records[t].distribution = distribution;
+                    groups[t].push_back(std::move(records[t]));
+                }
+            }
+
+            for (auto& group : groups) {
+                markParetoFront(group);
+
+                printf("  thr=%.1f\n", group.front().threshold);
+                printf("  %-34s %-11s %-10s %-13s %-13s %s\n", "Configuracao", "Build(ms)", "Bytes/img",
+                       "Lat.media(us)", "Lat.p95(us)", "Pareto");
+                for (const auto& record : group) {
+                    printf("  %-34.34s %-11.3f %-10.1f %-13.2f %-13.2f %s\n", record.structure.c_str(),
+                           record.insertMs, record.bytesPerImage(), meanOf(record.searchMs) * 1000.0,
+                           percentileOf(record.searchMs, 0.95) * 1000.0, record.pareto ? "*" : "");
+                }
+
+                printf("  Pareto-otimas:");
+                for (const auto& record : group) {
+                    if (record.pareto) printf(" [%s]", record.structure.c_str());
+                }
+                printf("\n");
+
+                allResults.insert(allResults.end(), group.begin(), group.end());
+            }
+        }
+    }
+
+    if (config.report.enabled()) {
+        std::cout << "\n";
+        writeReports(config.report, allResults);
+    }
+
+    std::cout << "\n==================================================================================\n";
+    std::cout << "Tuner Concluido!\n";
+    std::cout << "==================================================================================\n";
+    return 0;
+}
+
+// ============================================================================
+// MODO CONCORRENTE (--concurrent) - LEITORES x UM ESCRITOR
+// ============================================================================
+/*
+Para cada estrutura, escala e T em --threads (padrao 1,2,4,8):
+- metade do dataset e carregada antes da medicao
+- 1 escritor insere a outra metade o mais rapido possivel
+- T leitores consultam em laco (pontos sorteados da metade ja carregada)
+  ate o escritor terminar
+
+Duas formas de proteger a estrutura (headers/concurrent_index.h):
+- rwlock: SharedMutexIndex, insercao visivel na hora, leitores bloqueiam
+- rcu:    RcuSnapshotIndex, leitores sem lock sobre snapshots imutaveis
+
+Reporta consultas/s somadas dos leitores, insercoes/s do escritor e a
+latencia das consultas (media e p99) durante as insercoes.
+*/
+
+const std::vector<int> kConcurrentThreads = {1, 2, 4, 8};
+constexpr size_t kMaxLatencySamples = 10000;  // por leitor, limita o tamanho do relatorio
+
+std::unique_ptr<ImageDatabase> makeConcurrentIndex(const std::string& mode, const StructureVariant& variant,
+                                                   const std::vector<Image>& preload) {
+    if (mode == "rcu") {
+        return std::make_unique<RcuSnapshotIndex>([variant]() { return makeStructure(variant); }, preload);
+    }
+    auto inner = makeStructure(variant);
+    for (const auto& img : preload) inner->insert(img);
+    return std::make_unique<SharedMutexIndex>(std::move(inner));
+}
+
+BenchmarkRecord runReadersWithWriter(ImageDatabase& db, const std::vector<Image>& preload,
+                                     const std::vector<Image>& incoming, int readerCount,
+                                     double threshold, const BenchmarkConfig& config) {
+    std::atomic<bool> writerDone(false);
+    std::atomic<long long> totalQueries(0);
+    std::atomic<long long> totalFound(0);
+    std::vector<std::vector<double>> latencies(readerCount);
+
+    auto start = std::chrono::high_resolution_clock::now();
+    std::vector<std::thread> readers;
+    for (int t = 0; t < readerCount; t++) {
+        readers.emplace_back([&, t]() {
+            std::mt19937 gen(config.seed + 100 + t);
+            std::uniform_int_distribution<size_t> pick(0, preload.size() - 1);
+            long long queries = 0, found = 0;
+            // Pelo menos uma consulta mesmo se o escritor terminar antes
+            do {
+                const Image& query = preload[pick(gen)];
+                auto startQuery = std::chrono::high_resolution_clock::now();
+                auto results = db.findSimilar(query, threshold);
+                auto endQuery = std::chrono::high_resolution_clock::now();
+                if (latencies[t].size() < kMaxLatencySamples) {
+                    latencies[t].push_back(std::chrono::duration<double, std::milli>(endQuery - startQuery).count());
+                }
+                found += results.size();
+                queries++;
+            } while (!writerDone.load(std::memory_order_acquire));
+            totalQueries += queries;
+            totalFound += found;
+        });
+    }
+
+    auto startWrite = std::chrono::high_resolution_clock::now();
+    for (const auto& img : incoming) db.insert(img);
+    if (auto* rcu = dynamic_cast<RcuSnapshotIndex*>(&db)) rcu->flush();
+    auto endWrite = std::chrono::high_resolution_clock::now();
+    writerDone.store(true, std::memory_order_release);
+    for (auto& reader : readers) reader.join();
+    auto end = std::chrono::high_resolution_clock::now();
+
+    double writeSeconds = std::chrono::duration<double>(endWrite - startWrite).count();
+    double readSeconds = std::chrono::duration<double>(end - start).count();
+
+    BenchmarkRecord record;
+    record.driver = "benchmark --concurrent";
+    // Um registro por T: o numero de leitores entra na chave do compare_results
+    record.structure = db.getName() + " " + formatParam("T", readerCount, 0);
+    record.scale = preload.size() + incoming.size();
+    record.seed = config.seed;
+    record.threshold = threshold;
+    record.insertMs = writeSeconds * 1000.0;
+    for (const auto& samples : latencies) record.searchMs.insert(record.searchMs.end(), samples.begin(), samples.end());
+    record.found = totalFound;
+    record.memory = db.memoryUsage();
+    record.throughput.emplace_back(readerCount, readSeconds > 0 ? totalQueries / readSeconds : 0.0);
+    record.insertThroughput.emplace_back(readerCount, writeSeconds > 0 ? incoming.size() / writeSeconds : 0.0);
+    return record;
+}
+
+int runConcurrent(BenchmarkConfig& config) {
+    if (config.threads.empty()) config.threads = kConcurrentThreads;
+    std::vector<StructureVariant> variants = expandVariants(config);
+    const std::vector<std::string> modes = {"rwlock", "rcu"};
+
+    std::cout << "==================================================================================\n";
+    std::cout << " LEITURAS CONCORRENTES COM UM ESCRITOR - PAA Assignment 1\n";
+    std::cout << "==================================================================================\n\n";
+    printf("Configuracoes: %zu x %zu modos | Leitores:", variants.size(), modes.size());
+    for (int threadCount : config.threads) printf(" %d", threadCount);
+    printf(" | Seed: %u\n", config.seed);
+
+    std::vector<BenchmarkRecord> allResults;
+
+    for (long long scale : config.scales) {
+        for (const std::string& distribution : config.distributions) {
+            std::vector<Image> dataset = distribution == "real"
+                ? loadRealDataset(scale, config.imagesPath)
+                : generateSyntheticDataset(scale, distribution, config.seed);
+            if (dataset.size() < 2) {
+                printf("\nAVISO: dataset pequeno demais (%s), escala %lld ignorada\n", distribution.c_str(), scale);
+                continue;
+            }
+            size_t half = dataset.size() / 2;
+            std::vector<Image> preload(std::make_move_iterator(dataset.begin()),
+                                       std::make_move_iterator(dataset.begin() + half));
+            std::vector<Image> incoming(std::make_move_iterator(dataset.begin() + half),
+                                        std::make_move_iterator(dataset.end()));
+            size_t datasetSize = dataset.size();
+            std::vector<Image>().swap(dataset);
+
+            printf("\n[CONCORRENTE] Escala: %zu imagens (%zu pre-carregadas) | Distribuicao: %s\n",
+                   datasetSize, half, distribution.c_str());
+            printf("  %-40s %-6s %-5s %-12s %-12s %-13s %-13s\n", "Estrutura", "Thr", "T",
+                   "Leituras/s", "Insercoes/s", "Lat.media(us)", "Lat.p99(us)");
+
+            for (const StructureVariant& variant : variants) {
+                for (const std::string& mode : modes) {
+                    for (double threshold : config.thresholds) {
+                        for (int threadCount : config.threads) {
+                            auto db = makeConcurrentIndex(mode, variant, preload);
+                            BenchmarkRecord record = runReadersWithWriter(*db, preload, incoming, threadCount,
+                                                                          threshold, config);
+                            record.distribution = distribution;
+                            record.cellSize = variant.cellSize;
+                            record.leafCapacity = variant.leafCapacity;
+                            printf("  %-40.40s %-6.1f %-5d %-12.0f %-12.0f %-13.2f %-13.2f\n",
+                                   record.structure.c_str(), threshold, threadCount,
+                                   record.throughput[0].second, record.insertThroughput[0].second,
+                                   meanOf(record.searchMs) * 1000.0, percentileOf(record.searchMs, 0.99) * 1000.0);
+                            allResults.push_back(record);
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    if (config.report.enabled()) {
+        std::cout << "\n";
+        writeReports(config.report, allResults);
+    }
+
+    std::cout << "\n==================================================================================\n";
+    std::cout << "Modo Concorrente Concluido!\n";
+    std::cout << "==================================================================================\n";
+    return 0;
+}
+
+// ============================================================================
+// MODO INGESTAO (--ingest) - INSERCAO COM VARIAS THREADS
+// ============================================================================
+/*
+Para cada escala, insere o dataset inteiro com T threads (--threads, padrao
+1,2,4,8,16,32) no hash-sharded; cada thread recebe um bloco contiguo do
+dataset. Estruturas sem insercao thread-safe (ex.: hash) entram so com 1
+thread, como linha de base. Sem hash-sharded em --structures, compara
+hash x hash-sharded.
+
+Depois da construcao, uma consulta (--query, primeiro threshold) confere que
+todas as configuracoes encontram o mesmo numero de imagens.
+*/
+
+const std::vector<int> kIngestThreads = {1, 2, 4, 8, 16, 32};
+
+BenchmarkRecord ingestStructure(const StructureVariant& variant, const std::vector<Image>& dataset,
+                                int threadCount, const Image& query, const BenchmarkConfig& config) {
+    auto db = makeStructure(variant);
+    auto* sharded = dynamic_cast<ShardedHashSearch*>(db.get());
+
+    resetPeakRSS();
+    RSSSample beforeBuild = sampleRSS();
+    auto startInsert = std::chrono::high_resolution_clock::now();
+    if (sharded) {
+        sharded->insertParallel(dataset.data(), dataset.data() + dataset.size(), threadCount);
+    } else {
+        for (const auto& img : dataset) db->insert(img);
+    }
+    db->finishBuild();
+    auto endInsert = std::chrono::high_resolution_clock::now();
+    RSSSample afterBuild = sampleRSS();
+
+    BenchmarkRecord record;
+    record.driver = "benchmark --ingest";
+    record.structure = db->getName() + " " + formatParam("T", threadCount, 0);
+    record.scale = dataset.size();
+    record.seed = config.seed;
+    record.threshold = config.thresholds.front();
+    record.cellSize = variant.cellSize;
+    record.insertMs = std::chrono::duration<double, std::milli>(endInsert - startInsert).count();
+    record.memory = db->memoryUsage();
+    record.rssBuildBytes = bytesAbove(afterBuild.current, beforeBuild.current);
+    record.rssPeakBytes = bytesAbove(afterBuild.peak, beforeBuild.current);
+    record.rusagePeakBytes = afterBuild.rusagePeak;
+    double seconds = record.insertMs / 1000.0;
+    record.insertThroughput.emplace_back(threadCount, seconds > 0 ? dataset.size() / seconds : 0.0);
+
+    auto startSearch = std::chrono::high_resolution_clock::now();
+    record.found = db->findSimilar(query, record.threshold).size();
+    auto endSearch = std::chrono::high_resolution_clock::now();
+    record.searchMs.push_back(std::chrono::duration<double, std::milli>(endSearch - startSearch).count());
+    return record;
+}
+
+int runIngest(BenchmarkConfig& config) {
+    if (config.threads.empty()) config.threads = kIngestThreads;
+    if (std::find(config.structures.begin(), config.structures.end(), "hash-sharded") == config.structures.end()) {
+        config.structures = {"hash", "hash-sharded"};
+    }
+    std::vector<StructureVariant> variants = expandVariants(config);
+    const Image queryPoint(999999, "query.jpg", config.queryR, config.queryG, config.queryB);
+
+    std::cout << "==================================================================================\n";
+    std::cout << " INGESTAO PARALELA - PAA Assignment 1\n";
+    std::cout << "==================================================================================\n\n";
+    printf("Configuracoes: %zu | Threads:", variants.size());
+    for (int threadCount : config.threads) printf(" %d", threadCount);
+    printf(" | Nucleos: %u | Seed: %u\n", std::thread::hardware_concurrency(), config.seed);
+
+    std::vector<BenchmarkRecord> allResults;
+
+    for (long long scale : config.scales) {
+        for (const std::string& distribution : config.distributions) {
+            std::vector<Image> dataset = distribution == "real"
+                ? loadRealDataset(scale, config.imagesPath)
+                : generateSyntheticDataset(scale, distribution, config.seed);
+            if (dataset.empty()) {
+                printf("\nAVISO: dataset vazio (%s), escala %lld ignorada\n", distribution.c_str(), scale);
+                continue;
+            }
+
+            printf("\n[INGESTAO] Escala: %zu imagens | Distribuicao: %s\n", dataset.size(), distribution.c_str());
+            printf("  %-44s %-12s %-14s %-9s %-10s %-8s\n", "Estrutura", "Insert(ms)", "Insercoes/s",
+                   "Speedup", "Bytes/img", "Found");
+
+            for (const StructureVariant& variant : variants) {
+                std::vector<int> threadCounts = variant.key == "hash-sharded" ? config.threads : std::vector<int>{1};
+                double singleThreadMs = 0.0;
+                for (int threadCount : threadCounts) {
+                    BenchmarkRecord record = ingestStructure(variant, dataset, threadCount, queryPoint, config);
+                    record.distribution = distribution;
+                    if (singleThreadMs == 0.0) singleThreadMs = record.insertMs;
+                    printf("  %-44.44s %-12.3f %-14.0f %-9.2f %-10.1f %-8lld\n", record.structure.c_str(),
+                           record.insertMs, record.insertThroughput[0].second,
+                           record.insertMs > 0 ? singleThreadMs / record.insertMs : 0.0,
+                           record.bytesPerImage(), record.found);
+                    allResults.push_back(record);
+                }
+            }
+        }
+    }
+
+    if (config.report.enabled()) {
+        std::cout << "\n";
+        writeReports(config.report, allResults);
+    }
+
+    std::cout << "\n==================================================================================\n";
+    std::cout << "Ingestao Concluida!\n";
+    std::cout << "==================================================================================\n";
+    return 0;
+}
+
+// ============================================================================
+// MODO CACHE (--cache) - CACHE DE RESULTADOS SOB CARGA ZIPF
+// ============================================================================
+/*
+Carga com consultas repetidas: kCacheDistinctColors cores (sorteadas do
+dataset e arredondadas para inteiros, como cores de marca) escolhidas com
+probabilidade proporcional a 1/rank^s (Zipf, --zipf). --workload consultas
+(padrao 20000) por threshold, com 1 insercao a cada kCacheInsertEvery
+consultas (imagens guardadas fora da carga inicial) para exercitar a
+invalidacao.
+
+A mesma sequencia roda na estrutura pura e no CachedIndex
+(headers/query_cache.h): os resultados precisam ser identicos (Found) e a
+economia e a diferenca de tempo total das consultas. Tambem reporta a
+taxa de acertos e a economia estimada pelo proprio cache.
+*/
+
+constexpr int kCacheDistinctColors = 1000;
+constexpr int kCacheDefaultWorkload = 20000;
+constexpr int kCacheInsertEvery = 20;
+
+struct CacheWorkloadRun {
+    std::vector<double> latencyMs;
+    long long found = 0;
+};
+
+// Executa a carga; insere incoming[i] antes da consulta i*kCacheInsertEvery
+CacheWorkloadRun runCacheWorkload(ImageDatabase& db, const std::vector<Image>& colors,
+                                  const std::vector<int>& sequence, const std::vector<Image>& incoming,
+                                  double threshold) {
+    CacheWorkloadRun run;
+    run.latencyMs.reserve(sequence.size());
+    size_t nextInsert = 0;
+    for (size_t q = 0; q < sequence.size(); q++) {
+        if (q % kCacheInsertEvery == 0 && nextInsert < incoming.size()) db.insert(incoming[nextInsert++]);
+        auto startSearch = std::chrono::high_resolution_clock::now();
+        auto results = db.findSimilar(colors[sequence[q]], threshold);
+        auto endSearch = std::chrono::high_resolution_clock::now();
+        run.latencyMs.push_back(std::chrono::duration<double, std::milli>(endSearch - startSearch).count());
+        run.found += results.size();
+    }
+    return run;
+}
+
+int runCache(BenchmarkConfig& config) {
+    int workload = config.workloadGiven ? config.workloadQueries : kCacheDefaultWorkload;
+    std::vector<StructureVariant> variants = expandVariants(config);
+
+    std::cout << "==================================================================================\n";
+    std::cout << " CACHE DE RESULTADOS (CARGA ZIPF) - PAA Assignment 1\n";
+    std::cout << "==================================================================================\n\n";
+    printf("Configuracoes: %zu | Carga: %d consultas, %d cores, zipf=%.2f | quantum=%.1f | Seed: %u\n",
+           variants.size(), workload, kCacheDistinctColors, config.zipfExponent, config.cacheQuantum, config.seed);
+
+    std::vector<BenchmarkRecord> allResults;
+
+    for (long long scale : config.scales) {
+        for (const std::string& distribution : config.distributions) {
+            std::vector<Image> dataset = distribution == "real"
+                ? loadRealDataset(scale, config.imagesPath)
+                : generateSyntheticDataset(scale, distribution, config.seed);
+            if (dataset.size() < 2) {
+                printf("\nAVISO: dataset pequeno demais (%s), escala %lld ignorada\n", distribution.c_str(), scale);
+                continue;
+            }
+
+            // Cauda do dataset chega durante a carga (no maximo 10% dele)
+            size_t insertCount = std::min(dataset.size() / 10, (size_t)workload / kCacheInsertEvery);
+            std::vector<Image> incoming(dataset.end() - insertCount, dataset.end());
+            dataset.erase(dataset.end() - insertCount, dataset.end());
+
+            std::mt19937 gen(config.seed + 2);
+            std::uniform_int_distribution<size_t> pick(0, dataset.size() - 1);
+            std::vector<Image> colors;
+            std::vector<double> weights;
+            for (int c = 0; c < kCacheDistinctColors; c++) {
+                const Image& source = dataset[pick(gen)];
+                colors.emplace_back(999999, "query.jpg", std::round(source.r), std::round(source.g),
+                                    std::round(source.b));
+                weights.push_back(1.0 / std::pow(c + 1.0, config.zipfExponent));
+            }
+            std::discrete_distribution<int> zipf(weights.begin(), weights.end());
+            std::vector<int> sequence(workload);
+            for (int& index : sequence) index = zipf(gen);
+
+            printf("\n[CACHE] Escala: %zu imagens (+%zu durante a carga) | Distribuicao: %s\n",
+                   dataset.size(), incoming.size(), distribution.c_str());
+            printf("  %-30s %-6s %-6s %-8s %-11s %-11s %-12s %-12s %-8s %-8s %s\n", "Estrutura", "Thr", "Cap",
+                   "Acerto%", "Pura(us)", "Cache(us)", "Economia(ms)", "Estimada(ms)", "Invalid.", "Subst.",
+                   "Found");
+
+            for (const StructureVariant& variant : variants) {
+                for (double threshold : config.thresholds) {
+                    auto plain = makeStructure(variant);
+                    for (const auto& img : dataset) plain->insert(img);
+                    CacheWorkloadRun plainRun = runCacheWorkload(*plain, colors, sequence, incoming, threshold);
+                    double plainTotal = summarize(plainRun.latencyMs).mean * plainRun.latencyMs.size();
+
+                    BenchmarkRecord base;
+                    base.driver = "benchmark --cache";
+                    base.structure = plain->getName();
+                    base.scale = dataset.size() + incoming.size();
+                    base.distribution = distribution;
+                    base.seed = config.seed;
+                    base.threshold = threshold;
+                    base.cellSize = variant.cellSize;
+                    base.leafCapacity = variant.leafCapacity;
+                    base.searchMs = plainRun.latencyMs;
+                    base.found = plainRun.found;
+                    base.memory = plain->memoryUsage();
+                    plain.reset();
+                    allResults.push_back(base);
+
+                    for (int capacity : config.cacheSizes) {
+                        CachedIndex cached(makeStructure(variant), capacity, config.cacheQuantum);
+                        for (const auto& img : dataset) cached.insert(img);
+                        CacheWorkloadRun cachedRun = runCacheWorkload(cached, colors, sequence, incoming, threshold);
+                        double cachedTotal = summarize(cachedRun.latencyMs).mean * cachedRun.latencyMs.size();
+                        QueryCacheStats stats = cached.stats();
+
+                        BenchmarkRecord record = base;
+                        record.structure = cached.getName();
+                        record.searchMs = cachedRun.latencyMs;
+                        record.found = cachedRun.found;
+                        record.memory = cached.memoryUsage();
+
+                        printf("  %-30.30s %-6.1f %-6d %-8.1f %-11.2f %-11.2f %-12.2f %-12.2f %-8llu %-8llu %lld%s\n",
+                               base.structure.c_str(), threshold, capacity, stats.hitRate(),
+                               meanOf(plainRun.latencyMs) * 1000.0, meanOf(cachedRun.latencyMs) * 1000.0,
+                               plainTotal - cachedTotal, stats.savedMs(), (unsigned long long)stats.invalidations,
+                               (unsigned long long)stats.evictions, cachedRun.found,
+                               cachedRun.found == plainRun.found ? "" : " (DIVERGE)");
+                        allResults.push_back(record);
+                    }
+                }
+            }
+        }
+    }
+
+    if (config.report.enabled()) {
+        std::cout << "\n";
+        writeReports(config.report, allResults);
+    }
+
+    std::cout << "\n==================================================================================\n";
+    std::cout << "Modo Cache Concluido!\n";
+    std::cout << "==================================================================================\n";
+    return 0;
+}
+
+// ============================================================================
+// MODO ASSINCRONO (--async) - PRAZOS E CANCELAMENTO
+// ============================================================================
+/*
+Para cada estrutura e threshold, --workload consultas (pontos sorteados do
+dataset) rodam primeiro de forma sincrona: resultado exato e latencia
+mediana M. Depois cada consulta e submetida ao AsyncQueryExecutor
+(headers/async_query.h) com prazo = f x M para f em kAsyncDeadlineFractions:
+- completas: % que terminou antes do prazo
+- recall: imagens devolvidas / imagens do resultado exato (parciais incluidas)
+- atraso: quanto o futuro ficou pronto depois do prazo (p50/p99)
+Por fim, cada consulta e cancelada M/2 apos o submit: latencia do cancel()
+ate o futuro ficar pronto (p50/p99).
+*/
+
+const std::vector<double> kAsyncDeadlineFractions = {0.1, 0.25, 0.5, 1.0, 2.0};
+
+int runAsync(BenchmarkConfig& config) {
+    std::vector<StructureVariant> variants = expandVariants(config);
+    using Clock = QueryControl::Clock;
+
+    std::cout << "==================================================================================\n";
+    std::cout << " CONSULTAS ASSINCRONAS (PRAZO E CANCELAMENTO) - PAA Assignment 1\n";
+    std::cout << "==================================================================================\n\n";
+    printf("Configuracoes: %zu | Carga: %d consultas | Prazos: fracoes da latencia mediana sincrona | Seed: %u\n",
+           variants.size(), config.workloadQueries, config.seed);
+
+    std::vector<BenchmarkRecord> allResults;
+
+    for (long long scale : config.scales) {
+        for (const std::string& distribution : config.distributions) {
+            std::vector<Image> dataset = distribution == "real"
+                ? loadRealDataset(scale, config.imagesPath)
+                : generateSyntheticDataset(scale, distribution, config.seed);
+            if (dataset.empty()) {
+                printf("\nAVISO: dataset vazio (%s), escala %lld ignorada\n", distribution.c_str(), scale);
+                continue;
+            }
+
+            std::vector<Image> workload;
+            std::mt19937 gen(config.seed + 1);
+            std::uniform_int_distribution<size_t> pick(0, dataset.size() - 1);
+            for (int q = 0; q < config.workloadQueries; q++) workload.push_back(dataset[pick(gen)]);
+
+            printf("\n[ASSINCRONO] Escala: %zu imagens | Distribuicao: %s\n", dataset.size(), distribution.c_str());
+            printf("  %-32s %-6s %-11s %-10s %-10s %-9s %-14s %-14s\n", "Estrutura", "Thr", "Prazo(us)",
+                   "Completas%", "Recall%", "Lat(us)", "Atraso p50(us)", "Atraso p99(us)");
+
+            for (const StructureVariant& variant : variants) {
+                auto db = makeStructure(variant);
+                for (const auto& img : dataset) db->insert(img);
+                AsyncQueryExecutor executor(*db);
+
+                for (double threshold : config.thresholds) {
+                    std::vector<double> syncMs;
+                    long long exactFound = 0;
+                    for (const auto& query : workload) {
+                        auto startSearch = std::chrono::high_resolution_clock::now();
+                        exactFound += db->findSimilar(query, threshold).size();
+                        auto endSearch = std::chrono::high_resolution_clock::now();
+                        syncMs.push_back(std::chrono::duration<double, std::milli>(endSearch - startSearch).count());
+                    }
+                    double medianMs = percentileOf(syncMs, 0.5);
+                    printf("  %-32.32s %-6.1f %-11s %-10s %-10s %-9.1f (sincrona, mediana)\n", db->getName().c_str(),
+                           threshold, "-", "100.0", "100.0", medianMs * 1000.0);
+
+                    for (double fraction : kAsyncDeadlineFractions) {
+                        auto deadline = std::chrono::microseconds(std::max<long long>(1, (long long)(medianMs * fraction * 1000.0)));
+                        std::vector<double> endToEndMs, lateUs;
+                        long long found = 0, complete = 0;
+                        for (const auto& query : workload) {
+                            QueryHandle handle = executor.submit(query, threshold, deadline);
+                            const AsyncQueryResult& result = handle.get();
+                            double totalMs = result.queuedMs + result.runMs;
+                            endToEndMs.push_back(totalMs);
+                            found += result.images.size();
+                            if (result.partial()) lateUs.push_back(std::max(0.0, totalMs * 1000.0 - deadline.count()));
+                            else complete++;
+                        }
+
+                        BenchmarkRecord record;
+                        record.driver = "benchmark --async";
+                        record.structure = db->getName() + " " + formatParam("deadline_us", (double)deadline.count(), 0);
+                        record.scale = dataset.size();
+                        record.distribution = distribution;
+                        record.seed = config.seed;
+                        record.threshold = threshold;
+                        record.cellSize = variant.cellSize;
+                        record.leafCapacity = variant.leafCapacity;
+                        record.searchMs = endToEndMs;
+                        record.found = found;
+                        allResults.push_back(record);
+
+                        printf("  %-32.32s %-6.1f %-11lld %-10.1f %-10.1f %-9.1f %-14.1f %-14.1f\n",
+                               db->getName().c_str(), threshold, (long long)deadline.count(),
+                               100.0 * complete / workload.size(), exactFound ? 100.0 * found / exactFound : 100.0,
+                               meanOf(endToEndMs) * 1000.0, percentileOf(lateUs, 0.5), percentileOf(lateUs, 0.99));
+                    }
+
+                    // Cancelamento no meio da busca
+                    std::vector<double> cancelUs;
+                    for (const auto& query : workload) {
+                        QueryHandle handle = executor.submit(query, threshold);
+                        std::this_thread::sleep_for(std::chrono::microseconds((long long)(medianMs * 500.0)));
+                        Clock::time_point cancelled = Clock::now();
+                        handle.cancel();
+                        handle.get();
+                        cancelUs.push_back(std::chrono::duration<double, std::micro>(Clock::now() - cancelled).count());
+                    }
+                    printf("  %-32.32s %-6.1f cancelamento apos M/2: cancel() -> pronto p50 %.1fus, p99 %.1fus\n",
+                           db->getName().c_str(), threshold, percentileOf(cancelUs, 0.5), percentileOf(cancelUs, 0.99));
+                }
+            }
+        }
+    }
+
+    if (config.report.enabled()) {
+        std::cout << "\n";
+        writeReports(config.report, allResults);
+    }
+
+    std::cout << "\n==================================================================================\n";
+    std::cout << "Modo Assincrono Concluido!\n";
+    std::cout << "==================================================================================\n";
+    return 0;
+}
+
+// ============================================================================
+// MODO STREAMING (--stream) - VISITANTE x VECTOR MATERIALIZADO
+// ============================================================================
+/*
+Para cada estrutura e threshold, --workload consultas (pontos sorteados do
+dataset) rodam de quatro formas:
+- findSimilar: monta o vector<Image>; Pico(KB) = maior capacity() x sizeof(Image)
+  (sem contar os nomes, que tambem sao copiados)
+- forEachSimilar contando: mesmo percurso, o visitante so soma (sem vector)
+- primeiro resultado: instante da primeira chamada do visitante, que para ali
+  (no findSimilar o primeiro resultado so chega com o vector inteiro)
+- primeiros 10: para depois de 10 resultados
+A coluna Igual confere que o visitante viu exatamente os resultados de findSimilar.
+*/
+
+constexpr size_t kStreamFirstN = 10;
+
+int runStream(BenchmarkConfig& config) {
+    std::vector<StructureVariant> variants = expandVariants(config);
+    using Clock = std::chrono::high_resolution_clock;
+
+    std::cout << "==================================================================================\n";
+    std::cout << " STREAMING DE RESULTADOS (forEachSimilar) - PAA Assignment 1\n";
+    std::cout << "==================================================================================\n\n";
+    printf("Configuracoes: %zu | Carga: %d consultas | Seed: %u\n", variants.size(), config.workloadQueries,
+           config.seed);
+
+    std::vector<BenchmarkRecord> allResults;
+
+    for (long long scale : config.scales) {
+        for (const std::string& distribution : config.distributions) {
+            std::vector<Image> dataset = distribution == "real"
+                ? loadRealDataset(scale, config.imagesPath)
+                : generateSyntheticDataset(scale, distribution, config.seed);
+            if (dataset.empty()) {
+                printf("\nAVISO: dataset vazio (%s), escala %lld ignorada\n", distribution.c_str(), scale);
+                continue;
+            }
+
+            std::vector<Image> workload;
+            std::mt19937 gen(config.seed + 1);
+            std::uniform_int_distribution<size_t> pick(0, dataset.size() - 1);
+            for (int q = 0; q < config.workloadQueries; q++) workload.push_back(dataset[pick(gen)]);
+
+            printf("\n[STREAMING] Escala: %zu imagens | Distribuicao: %s\n", dataset.size(), distribution.c_str());
+            printf("  %-32s %-6s %-9s %-12s %-9s %-13s %-12s %-15s %-6s\n", "Estrutura", "Thr", "Res/cons",
+                   "Vector(us)", "Pico(KB)", "Visitante(us)", "Primeiro(us)", "Primeiros10(us)", "Igual");
+
+            for (const StructureVariant& variant : variants) {
+                auto db = makeStructure(variant);
+                for (const auto& img : dataset) db->insert(img);
+
+                for (double threshold : config.thresholds) {
+                    std::vector<double> vectorMs, visitMs, firstMs, firstNMs;
+                    size_t peakBytes = 0;
+                    long long found = 0;
+                    bool same = true;
+
+                    for (const auto& query : workload) {
+                        auto start = Clock::now();
+                        std::vector<Image> results = db->findSimilar(query, threshold);
+                        vectorMs.push_back(std::chrono::duration<double, std::milli>(Clock::now() - start).count());
+                        peakBytes = std::max(peakBytes, results.capacity() * sizeof(Image));
+                        found += results.size();
+
+                        // Soma de ids: confere o conjunto visitado sem ordenar
+                        long long expectedIds = 0, visitedIds = 0;
+                        for (const auto& img : results) expectedIds += img.id;
+                        size_t visited = 0;
+                        start = Clock::now();
+                        db->forEachSimilar(query, threshold, [&](const Image& img) {
+                            visited++;
+                            visitedIds += img.id;
+                            return true;
+                        });
+                        visitMs.push_back(std::chrono::duration<double, std::milli>(Clock::now() - start).count());
+                        same = same && visited == results.size() && visitedIds == expectedIds;
+
+                        Clock::time_point firstAt;
+                        start = Clock::now();
+                        bool any = false;
+                        db->forEachSimilar(query, threshold, [&](const Image&) {
+                            firstAt = Clock::now();
+                            any = true;
+                            return false;
+                        });
+                        if (any) firstMs.push_back(std::chrono::duration<double, std::milli>(firstAt - start).count());
+
+                        size_t seen = 0;
+                        start = Clock::now();
+                        db->forEachSimilar(query, threshold, [&](const Image&) { return ++seen < kStreamFirstN; });
+                        firstNMs.push_back(std::chrono::duration<double, std::milli>(Clock::now() - start).count());
+                    }
+
+                    BenchmarkRecord record;
+                    record.driver = "benchmark --stream";
+                    record.structure = db->getName() + " forEachSimilar";
+                    record.scale = dataset.size();
+                    record.distribution = distribution;
+                    record.seed = config.seed;
+                    record.threshold = threshold;
+                    record.cellSize = variant.cellSize;
+                    record.leafCapacity = variant.leafCapacity;
+                    record.searchMs = visitMs;
+                    record.found = found;
+                    allResults.push_back(record);
+
+                    printf("  %-32.32s %-6.1f %-9.1f %-12.1f %-9.1f %-13.1f %-12.1f %-15.1f %-6s\n",
+                           db->getName().c_str(), threshold, (double)found / workload.size(),
+                           meanOf(vectorMs) * 1000.0, peakBytes / 1024.0, meanOf(visitMs) * 1000.0,
+                           meanOf(firstMs) * 1000.0, meanOf(firstNMs) * 1000.0, same ? "sim" : "NAO");
+                }
+            }
+        }
+    }
+
+    if (config.report.enabled()) {
+        std::cout << "\n";
+        writeReports(config.report, allResults);
+    }
+
+    std::cout << "\n==================================================================================\n";
+    std::cout << "Modo Streaming Concluido!\n";
+    std::cout << "==================================================================================\n";
+    return 0;
+}
+
+// ============================================================================
+// MODO PLANEJADOR (--planner) - ESTRUTURA ESCOLHIDA POR CONSULTA
+// ============================================================================
+/*
+As --structures viram caminhos de um QueryPlanner (headers/query_planner.h)
+construido com o dataset inteiro. --workload/4 consultas calibram o modelo
+(rodam em todos os caminhos); depois --workload consultas novas (pontos do
+dataset) rodam por threshold:
+- pelo planejador (uma estrutura escolhida pelo custo previsto)
+- em cada estrutura fixa, direto
+- Oraculo: a estrutura mais rapida de cada consulta (limite inferior)
+Por caminho: % das consultas escolhidas, custo previsto x real medio e erro
+medio do modelo. --plan-log F grava previsto x real de cada consulta roteada.
+*/
+
+int runPlanner(BenchmarkConfig& config) {
+    std::vector<StructureVariant> variants;
+    for (const auto& variant : expandVariants(config)) {
+        if (variant.key != "planner") variants.push_back(variant);
+    }
+    using Clock = std::chrono::high_resolution_clock;
+
+    std::cout << "==================================================================================\n";
+    std::cout << " PLANEJADOR DE CONSULTAS POR CUSTO - PAA Assignment 1\n";
+    std::cout << "==================================================================================\n\n";
+    printf("Caminhos: %zu | Carga: %d consultas (+%d de calibracao) | Seed: %u\n", variants.size(),
+           config.workloadQueries, std::max(8, config.workloadQueries / 4), config.seed);
+    if (variants.empty()) return 1;
+
+    std::ofstream planLog;
+    if (!config.planLogPath.empty()) {
+        planLog.open(config.planLogPath);
+        planLog << "scale,distribution,r,g,b,threshold,path,explored,predicted_us,actual_us,results\n";
+    }
+    std::vector<BenchmarkRecord> allResults;
+
+    for (long long scale : config.scales) {
+        for (const std::string& distribution : config.distributions) {
+            std::vector<Image> dataset = distribution == "real"
+                ? loadRealDataset(scale, config.imagesPath)
+                : generateSyntheticDataset(scale, distribution, config.seed);
+            if (dataset.empty()) {
+                printf("\nAVISO: dataset vazio (%s), escala %lld ignorada\n", distribution.c_str(), scale);
+                continue;
+            }
+
+            std::unique_ptr<QueryPlanner> planner = makePlanner(variants);
+            auto startBuild = Clock::now();
+            for (const auto& img : dataset) planner->insert(img);
+            planner->finishBuild();
+            double buildMs = std::chrono::duration<double, std::milli>(Clock::now() - startBuild).count();
+
+            std::mt19937 gen(config.seed + 1);
+            std::uniform_int_distribution<size_t> pick(0, dataset.size() - 1);
+            std::vector<Image> training, workload;
+            for (int q = 0; q < std::max(8, config.workloadQueries / 4); q++) training.push_back(dataset[pick(gen)]);
+            for (int q = 0; q < config.workloadQueries; q++) workload.push_back(dataset[pick(gen)]);
+
+            auto startCalibration = Clock::now();
+            planner->calibrate(training, config.thresholds);
+            double calibrationMs = std::chrono::duration<double, std::milli>(Clock::now() - startCalibration).count();
+            planner->resetStats();
+
+            printf("\n[PLANEJADOR] Escala: %zu imagens | Distribuicao: %s | construcao %.1fms | calibracao %.1fms\n",
+                   dataset.size(), distribution.c_str(), buildMs, calibrationMs);
+
+            size_t paths = planner->pathCount();
+            for (double threshold : config.thresholds) {
+                std::vector<double> plannedUs, oracleUs;
+                std::vector<std::vector<double>> fixedUs(paths), predictedUs(paths);
+                std::vector<size_t> chosen(paths, 0);
+                bool same = true;
+                long long found = 0;
+                size_t logStart = planner->planLog().size();
+
+                for (size_t q = 0; q < workload.size(); q++) {
+                    const Image& query = workload[q];
+                    // Planejador antes das fixas nas consultas pares e depois nas impares:
+                    // a primeira a rodar paga a cache fria da regiao
+                    size_t results = 0;
+                    auto runPlanned = [&]() {
+                        auto start = Clock::now();
+                        results = planner->findSimilar(query, threshold).size();
+                        plannedUs.push_back(std::chrono::duration<double, std::micro>(Clock::now() - start).count());
+                    };
+                    if (q % 2 == 0) runPlanned();
+
+                    double best = 0.0;
+                    std::vector<size_t> direct(paths);
+                    for (size_t p = 0; p < paths; p++) {
+                        predictedUs[p].push_back(planner->predictUs(p, query, threshold));
+                        auto start = Clock::now();
+                        direct[p] = planner->path(p).findSimilar(query, threshold).size();
+                        fixedUs[p].push_back(std::chrono::duration<double, std::micro>(Clock::now() - start).count());
+                        best = p == 0 ? fixedUs[p].back() : std::min(best, fixedUs[p].back());
+                    }
+                    oracleUs.push_back(best);
+
+                    if (q % 2 == 1) runPlanned();
+                    for (size_t count : direct) same = same && count == results;
+                    found += results;
+                }
+
+                std::vector<PlanLogEntry> entries = planner->planLog();
+                for (size_t e = logStart; e < entries.size(); e++) {
+                    const PlanLogEntry& entry = entries[e];
+                    chosen[entry.path]++;
+                    if (planLog.is_open()) {
+                        planLog << dataset.size() << "," << distribution << "," << entry.r << "," << entry.g << ","
+                                << entry.b << "," << entry.threshold << ","
+                                << planner->path(entry.path).getName() << "," << (entry.explored ? 1 : 0) << ","
+                                << entry.predictedUs << "," << entry.actualUs << "," << entry.results << "\n";
+                    }
+                }
+
+                printf("  thr=%.1f | %.1f resultados/consulta | resultados iguais: %s\n", threshold,
+                       (double)found / workload.size(), same ? "sim" : "NAO");
+                printf("    %-36s %-10s %-9s %-12s %-10s\n", "Estrategia", "Media(us)", "Escolhas", "Previsto(us)",
+                       "Erro(%)");
+                for (size_t p = 0; p < paths; p++) {
+                    // Erro relativo medio da previsao sobre o tempo da estrutura fixa
+                    double error = 0.0;
+                    for (size_t q = 0; q < workload.size(); q++) {
+                        error += std::fabs(predictedUs[p][q] - fixedUs[p][q]) / std::max(fixedUs[p][q], 1e-3);
+                    }
+                    printf("    %-36.36s %-10.1f %-8.1f%% %-12.1f %-10.1f\n", planner->path(p).getName().c_str(),
+                           meanOf(fixedUs[p]), 100.0 * chosen[p] / workload.size(), meanOf(predictedUs[p]),
+                           100.0 * error / workload.size());
+                }
+                printf("    %-36s %-10.1f\n", "Planejador", meanOf(plannedUs));
+                printf("    %-36s %-10.1f\n", "Oraculo (melhor por consulta)", meanOf(oracleUs));
+
+                BenchmarkRecord record;
+                record.driver = "benchmark --planner";
+                record.structure = planner->getName();
+                record.scale = dataset.size();
+                record.distribution = distribution;
+                record.seed = config.seed;
+                record.threshold = threshold;
+                record.insertMs = buildMs;
+                for (double us : plannedUs) record.searchMs.push_back(us / 1000.0);
+                record.found = found;
+                allResults.push_back(record);
+            }
+            planner->printAnalysis();
+        }
+    }
+
+    if (config.report.enabled()) {
+        std::cout << "\n";
+        writeReports(config.report, allResults);
+    }
+    if (planLog.is_open()) printf("\nLog do planejador: %s\n", config.planLogPath.c_str());
+
+    std::cout << "\n==================================================================================\n";
+    std::cout << "Modo Planejador Concluido!\n";
+    std::cout << "==================================================================================\n";
+    return 0;
+}
+
+// ============================================================================
+// MODO AUTOTESTE (--selftest) - VERIFICACOES DE CORRETUDE
+// ============================================================================
+/*
+O repositorio nao tem framework de testes: cada verificacao aqui reproduz um
+defeito ja corrigido e imprime OK/FALHOU. Codigo de saida 1 se alguma falhar.
+
+- pool aninhado: tarefas de um parallelFor chamando parallelFor no MESMO
+  pool (o servidor faz isso com kNN em linear-par/octree-par/quadtree-par).
+  Roda com prazo: um deadlock vira FALHOU em vez de travar o processo
+- --frame pca: cores e thresholds inteiros poem pontos EXATAMENTE no raio;
+  a rotacao em double nao pode mudar o resultado. Cada estrutura, em rgb e
+  em pca, comparada com a LinearSearch (ids da busca por raio, contagem do
+  forEachSimilar, distancias do kNN)
+*/
+
+// Executa check numa thread separada; false se nao terminar dentro do prazo
+bool runWithWatchdog(const std::function<bool()>& check, std::chrono::seconds limit, bool& timedOut) {
+    auto task = std::make_shared<std::packaged_task<bool()>>(check);
+    std::future<bool> result = task->get_future();
+    std::thread([task]() { (*task)(); }).detach();
+    timedOut = result.wait_for(limit) != std::future_status::ready;
+    return !timedOut && result.get();
+}
+
+bool selfTestNestedParallelFor() {
+    auto pool = std::make_shared<ThreadPool>(4);
+    for (int iteration = 0; iteration < 200; iteration++) {
+        std::atomic<size_t> leaves{0};
+        pool->parallelFor(8, [&](size_t) { pool->parallelFor(8, [&](size_t) { leaves++; }); });
+        if (leaves.load() != 64) return false;
+    }
+    // Caso real: lote de kNN em estruturas -par sobre o pool do lote
+    auto dataset = generateSyntheticDataset(20000, "clusters", 42);
+    LinearSearch reference;
+    ParallelLinearSearch linearPar(pool);
+    OctreeParalelo octreePar(OctreeSearch::DEFAULT_LEAF_CAPACITY, pool);
+    for (const auto& img : dataset) {
+        reference.insert(img);
+        linearPar.insert(img);
+        octreePar.insert(img);
+    }
+    std::atomic<size_t> mismatches{0};
+    pool->parallelFor(64, [&](size_t i) {
+        const Image& query = dataset[i * 311 % dataset.size()];
+        auto expected = reference.findKNearest(query, 10);
+        for (const ImageDatabase* db : {(const ImageDatabase*)&linearPar, (const ImageDatabase*)&octreePar}) {
+            auto found = db->findKNearest(query, 10);
+            if (found.size() != expected.size() || query.distanceTo(found.back()) != query.distanceTo(expected.back())) {
+                mismatches++;
+            }
+        }
+    });
+    return mismatches.load() == 0;
+}
+
+bool selfTestPcaFrame() {
+    auto dataset = generateSyntheticDataset(20000, "diagonal", 7);
+    for (auto& img : dataset) {
+        img.r = std::round(img.r);
+        img.g = std::round(img.g);
+        img.b = std::round(img.b);
+    }
+    std::vector<Image> queries;
+    for (size_t i = 0; i < 40; i++) queries.push_back(dataset[i * 487 % dataset.size()]);
+    std::mt19937 rng(11);
+    std::uniform_int_distribution<int> channel(0, 255);
+    for (int i = 0; i < 20; i++) queries.emplace_back(-1, "q", channel(rng), channel(rng), channel(rng));
+    const std::vector<double> thresholds = {5, 10, 20, 40};
+
+    auto idsOf = [](const std::vector<Image>& images) {
+        std::vector<int> ids;
+        for (const auto& img : images) ids.push_back(img.id);
+        std::sort(ids.begin(), ids.end());
+        return ids;
+    };
+    auto distancesOf = [](const std::vector<Image>& images, const Image& query) {
+        std::vector<double> distances;
+        for (const auto& img : images) distances.push_back(query.distanceTo(img));
+        return distances;
+    };
+
+    LinearSearch reference;
+    for (const auto& img : dataset) reference.insert(img);
+
+    const std::vector<std::string> keys = {"linear", "linear-sorted", "hash", "hashdyn", "hash-quantile", "hybrid",
+                                           "hash-sharded", "octree", "quadtree", "octree-iter", "quadtree-iter"};
+    size_t mismatches = 0;
+    for (const auto& key : keys) {
+        for (const char* frame : {"", "pca"}) {
+            StructureVariant variant{key, defaultCellSize(key), defaultLeafCapacity(key)};
+            variant.frame = frame;
+            auto db = makeStructure(variant);
+            for (const auto& img : dataset) db->insert(img);
+            size_t before = mismatches;
+            for (const auto& query : queries) {
+                for (double threshold : thresholds) {
+                    auto expected = idsOf(reference.findSimilar(query, threshold));
+                    if (idsOf(db->findSimilar(query, threshold)) != expected) mismatches++;
+                    size_t visited = 0;
+                    db->forEachSimilar(query, threshold, [&visited](const Image&) { return ++visited, true; });
+                    if (visited != expected.size()) mismatches++;
+                }
+                if (distancesOf(db->findKNearest(query, 10), query) !=
+                    distancesOf(reference.findKNearest(query, 10), query)) {
+                    mismatches++;
+                }
+            }
+            if (mismatches != before) {
+                printf("    %s: %zu divergencias com a LinearSearch\n", db->getName().c_str(), mismatches - before);
+            }
+        }
+    }
+    return mismatches == 0;
+}
+
+int runSelfTest(BenchmarkConfig& config) {
+    (void)config;
+    std::cout << "==================================================================================\n";
+    std::cout << " AUTOTESTE - VERIFICACOES DE CORRETUDE\n";
+    std::cout << "==================================================================================\n\n";
+
+    struct Check {
+        const char* name;
+        std::function<bool()> run;
+    };
+    std::vector<Check> checks = {
+        {"parallelFor aninhado no mesmo pool (4 workers)", selfTestNestedParallelFor},
+        {"--frame rgb e pca iguais a LinearSearch (valores inteiros)", selfTestPcaFrame},
+    };
+
+    int failures = 0;
+    for (const auto& check : checks) {
+        bool timedOut = false;
+        bool ok = runWithWatchdog(check.run, std::chrono::seconds(60), timedOut);
+        printf("  %-60s %s\n", check.name, ok ? "OK" : (timedOut ? "FALHOU (travou)" : "FALHOU"));
+        if (!ok) failures++;
+    }
+    printf("\n%d de %zu verificacoes falharam\n", failures, checks.size());
+    fflush(stdout);
+    // Uma verificacao travada deixa uma thread presa: sair sem esperar por ela
+    if (failures > 0) std::_Exit(1);
+    return 0;
+}
+
+// ============================================================================
+// MAIN - BENCHMARK UNIFICADO
+// ============================================================================
+int main(int argc, char** argv) {
+    BenchmarkConfig config;
+    if (!parseArguments(argc, argv, config)) {
+        printUsage(argv[0]);
+        return 1;
+    }
+    if (config.tune) return runTuner(config);
+    if (config.concurrent) return runConcurrent(config);
+    if (config.ingest) return runIngest(config);
+    if (config.cache) return runCache(config);
+    if (config.async) return runAsync(config);
+    if (config.stream) return runStream(config);
+    if (config.planner) return runPlanner(config);
+    if (config.selftest) return runSelfTest(config);
+
+    const Image queryPoint(999999, "query.jpg", config.queryR, config.queryG, config.queryB);
+    std::vector<StructureVariant> variants = expandVariants(config);
+
+    std::cout << "==================================================================================\n";
+    std::cout << " BENCHMARK UNIFICADO - PAA Assignment 1\n";
+    std::cout << "==================================================================================\n\n";
+    printf("Query: RGB(%.0f, %.0f, %.0f) | Seed: %u | Configuracoes de estrutura: %zu\n",
+           queryPoint.r, queryPoint.g, queryPoint.b, config.seed, variants.size());
+
+    // Coletar todos os resultados primeiro
+    std::vector<BenchmarkRecord> allResults;
+
+    for (long long scale : config.scales) {
+        for (const std::string& distribution : config.distributions) {
+            printf("\n[TESTANDO] Escala: %lld imagens | Distribuicao: %s\n", scale, distribution.c_str());
+
+            for (const StructureVariant& variant : variants) {
+                // Dataset fresco para cada estrutura (libera memoria entre testes)
+                auto freshDataset = distribution == "real"
+                    ? loadRealDataset(scale, config.imagesPath)
+                    : generateSyntheticDataset(scale, distribution, config.seed);
+                if (freshDataset.empty()) {
+                    printf("  AVISO: dataset vazio, escala ignorada\n");
+                    break;
+                }
+
+                auto records = benchmarkStructure(makeStructure(variant), freshDataset, queryPoint, config,
+                                                  usesPool(variant.key));
+                for (auto& record : records) {
+                    record.distribution = distribution;
+                    record.cellSize = variant.cellSize;
+                    record.leafCapacity = variant.leafCapacity;
+                    printRecord(record);
+                    allResults.push_back(record);
+                }
+
+                // Dataset sai de escopo aqui e libera memoria automaticamente
+            }
+        }
+    }
+
+    // Agora mostrar tabela organizada
+    std::cout << "\n==================================================================================\n";
+    std::cout << "RESULTADOS FINAIS - TABELA ORGANIZADA\n";
+    std::cout << "==================================================================================\n\n";
+
+    printf("%-10s %-10s %-6s %-32s %-12s %-12s %-8s %-10s %-10s\n", "Dataset", "Dist", "Thr", "Estrutura",
+           "Insert(ms)", "Search(ms)", "Found", "Bytes/img", "PicoRSS(MB)");
+    std::cout << "--------------------------------------------------------------------------------------------------------------------\n";
+
+    long long lastScale = -1;
+    for (const auto& result : allResults) {
+        if (lastScale != -1 && result.scale != lastScale) {
+            std::cout << "--------------------------------------------------------------------------------------------------------------------\n";
+        }
+        char scaleText[24] = "";
+        if (result.scale != lastScale) snprintf(scaleText, sizeof(scaleText), "%lld", result.scale);
+        lastScale = result.scale;
+
+        printf("%-10s %-10s %-6.1f %-32.32s %-12.3f %-12.3f %-8lld %-10.1f %-10.2f\n",
+               scaleText, result.distribution.c_str(), result.threshold, result.structure.c_str(),
+               result.insertMs, result.searchMs[0], result.found,
+               result.bytesPerImage(), result.rssPeakBytes / 1048576.0);
+    }
+    std::cout << "--------------------------------------------------------------------------------------------------------------------\n";
+
+    // Analise de vencedores por (escala, distribuicao, threshold)
+    std::cout << "\nANALISE DE VENCEDORES:\n";
+    std::cout << "==================================================================================\n";
+
+    std::vector<std::tuple<long long, std::string, double>> groups;
+    for (const auto& result : allResults) {
+        auto group = std::make_tuple(result.scale, result.distribution, result.threshold);
+        if (std::find(groups.begin(), groups.end(), group) == groups.end()) groups.push_back(group);
+    }
+
+    for (const auto& group : groups) {
+        const BenchmarkRecord* bestInsert = nullptr;
+        const BenchmarkRecord* bestSearch = nullptr;
+        for (const auto& result : allResults) {
+            if (std::make_tuple(result.scale, result.distribution, result.threshold) != group) continue;
+            if (!bestInsert || result.insertMs < bestInsert->insertMs) bestInsert = &result;
+            if (!bestSearch || result.searchMs[0] < bestSearch->searchMs[0]) bestSearch = &result;
+        }
+        printf("%-10lld %-10s thr=%-5.1f | Insert: %-32.32s (%.3fms) | Search: %-32.32s (%.3fms)\n",
+               std::get<0>(group), std::get<1>(group).c_str(), std::get<2>(group),
+               bestInsert->structure.c_str(), bestInsert->insertMs,
+               bestSearch->structure.c_str(), bestSearch->searchMs[0]);
+    }
+
+    if (config.report.enabled()) {
+        std::cout << "\n";
+        writeReports(config.report, allResults);
+    }
+
+    std::cout << "\n==================================================================================\n";
+    std::cout << "Benchmark Concluido!\n";
+    std::cout << "==================================================================================\n";
+
+    return 0;
+}
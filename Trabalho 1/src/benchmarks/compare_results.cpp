@@ -0,0 +1,75 @@
+/*
+=============================================================================
+COMPARACAO DE RESULTADOS - DETECCAO DE REGRESSOES
+=============================================================================
+
+Le os arquivos gerados pelos drivers com --json/--csv e compara uma baseline
+com um candidato, por (estrutura, escala, distribuicao, threshold):
+- insert_ms e search_ms: teste t de Welch unilateral (candidato mais lento?)
+- bytes/img: deterministico, basta ultrapassar o efeito minimo
+
+Cada lado aceita varios arquivos separados por virgula (execucoes repetidas
+sao agrupadas). Para ter amostras de busca, rode os drivers com --reps <n>.
+
+Uso:
+  ./compare_results base.json cand.json [--alpha 0.05] [--min-effect 5]
+  ./compare_results run1.csv,run2.csv run3.csv,run4.csv
+
+Codigo de saida: 0 sem regressoes, 1 com regressoes, 2 erro de leitura ou
+de linha de comando (opcao desconhecida ou sem valor).
+=============================================================================
+*/
+
+#include <cstdio>
+#include <cstdlib>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "../headers/benchmark_report.h"
+
+// Carrega uma lista "a.json,b.csv" concatenando os registros
+bool loadFileList(const std::string& list, std::vector<BenchmarkRecord>& records) {
+    std::stringstream stream(list);
+    std::string path;
+    while (std::getline(stream, path, ',')) {
+        if (path.empty()) continue;
+        if (!loadReport(path, records)) {
+            fprintf(stderr, "ERRO: nao foi possivel ler %s\n", path.c_str());
+            return false;
+        }
+    }
+    return true;
+}
+
+int main(int argc, char** argv) {
+    if (argc < 3) {
+        fprintf(stderr, "Uso: %s <baseline[,..]> <candidato[,..]> [--alpha A] [--min-effect PCT]\n", argv[0]);
+        return 2;
+    }
+
+    CompareOptions options;
+    for (int i = 3; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg != "--alpha" && arg != "--min-effect") {
+            fprintf(stderr, "ERRO: opcao desconhecida '%s'\n", arg.c_str());
+            return 2;
+        }
+        if (i + 1 >= argc) {
+            fprintf(stderr, "ERRO: %s requer um valor\n", arg.c_str());
+            return 2;
+        }
+        double value = std::atof(argv[++i]);
+        if (arg == "--alpha") options.alpha = value;
+        else options.minEffect = value;
+    }
+
+    std::vector<BenchmarkRecord> baseline, candidate;
+    if (!loadFileList(argv[1], baseline) || !loadFileList(argv[2], candidate)) return 2;
+
+    printf("Baseline: %s (%zu registros)\n", argv[1], baseline.size());
+    printf("Candidato: %s (%zu registros)\n\n", argv[2], candidate.size());
+
+    int regressions = compareReports(baseline, candidate, options);
+    return regressions > 0 ? 1 : 0;
+}
@@ -0,0 +1,162 @@
+#ifndef ASYNC_QUERY_H
+#define ASYNC_QUERY_H
+
+#include <algorithm>
+#include <chrono>
+#include <functional>
+#include <future>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "image.h"
+#include "thread_pool.h"
+
+// ============================================================================
+// CONSULTAS ASSINCRONAS (FUTURES, CANCELAMENTO E PRAZO)
+// ============================================================================
+/*
+FUNCIONALIDADE PAA: embutir o indice num event loop
+
+PROBLEMA:
+- findSimilar bloqueia: uma Octree com 206K imagens e threshold grande leva
+  dezenas de ms, e o loop de eventos fica parado esse tempo todo
+
+INTERFACE:
+- submit / submitKNearest enfileiram a consulta no pool interno e retornam
+  na hora um QueryHandle (std::shared_future + controle)
+- O loop de eventos pode testar ready() a cada volta, esperar com waitFor,
+  ou passar um callback chamado na thread do pool ao terminar (ex.: escrever
+  num eventfd/pipe para acordar o loop)
+- cancel() pede a parada; a busca para no proximo ponto de parada (celula,
+  folha ou bloco de pontos) e o futuro completa com status CANCELLED
+- deadline: passado o prazo, a busca para e devolve o que ja encontrou com
+  status DEADLINE_EXPIRED (resultado parcial, sempre subconjunto do exato;
+  em kNN, os k mais proximos entre os pontos ja vistos)
+
+Coroutines (C++20) nao entram: o projeto compila em C++17; um awaitable
+seria um embrulho fino sobre o mesmo QueryHandle.
+
+CUSTO:
+- A interrupcao e cooperativa (QueryControl em image.h): sem consulta
+  assincrona ativa as buscas pagam so um teste de ponteiro por celula/folha
+- O prazo e verificado a cada QueryControl::CLOCK_CHECK_INTERVAL pontos de
+  parada: o atraso apos o prazo e de algumas folhas/celulas
+- Indices template (static_index.h) nao tem pontos de parada: rodam ate o fim
+
+A estrutura precisa estar congelada (ou embrulhada por concurrent_index.h)
+enquanto houver consultas em voo, e viver mais que o executor.
+*/
+
+enum class QueryStatus {
+    COMPLETE,          // Resultado exato
+    DEADLINE_EXPIRED,  // Parcial: parou no prazo
+    CANCELLED          // Parcial (ou vazio, se cancelada antes de comecar)
+};
+
+inline const char* queryStatusName(QueryStatus status) {
+    switch (status) {
+        case QueryStatus::COMPLETE: return "completa";
+        case QueryStatus::DEADLINE_EXPIRED: return "prazo";
+        case QueryStatus::CANCELLED: return "cancelada";
+    }
+    return "?";
+}
+
+struct AsyncQueryResult {
+    std::vector<Image> images;
+    QueryStatus status = QueryStatus::COMPLETE;
+    double queuedMs = 0.0;    // Espera na fila do pool
+    double runMs = 0.0;       // Execucao da busca
+
+    bool partial() const { return status != QueryStatus::COMPLETE; }
+};
+
+class QueryHandle {
+private:
+    std::shared_ptr<QueryControl> control;
+    std::shared_future<AsyncQueryResult> future;
+
+public:
+    QueryHandle(std::shared_ptr<QueryControl> _control, std::shared_future<AsyncQueryResult> _future)
+        : control(std::move(_control)), future(std::move(_future)) {}
+
+    void cancel() const { control->cancel(); }
+    bool ready() const { return future.wait_for(std::chrono::seconds(0)) == std::future_status::ready; }
+
+    template <typename Rep, typename Period>
+    bool waitFor(const std::chrono::duration<Rep, Period>& timeout) const {
+        return future.wait_for(timeout) == std::future_status::ready;
+    }
+
+    // Bloqueia ate o resultado (completo ou parcial)
+    const AsyncQueryResult& get() const { return future.get(); }
+};
+
+class AsyncQueryExecutor {
+public:
+    using Callback = std::function<void(const AsyncQueryResult&)>;
+    using Clock = QueryControl::Clock;
+
+private:
+    const ImageDatabase& db;
+    ThreadPool pool;  // Proprio: o pool compartilhado pode ter 0 workers (1 nucleo)
+
+    using Search = std::function<std::vector<Image>()>;
+
+    QueryHandle enqueue(Search search, std::chrono::microseconds deadline, Callback onDone) {
+        Clock::time_point submitted = Clock::now();
+        auto control = deadline.count() > 0 ? std::make_shared<QueryControl>(submitted + deadline)
+                                            : std::make_shared<QueryControl>();
+        auto promise = std::make_shared<std::promise<AsyncQueryResult>>();
+        std::shared_future<AsyncQueryResult> future = promise->get_future().share();
+
+        pool.submit([control, promise, search = std::move(search), onDone = std::move(onDone), submitted]() {
+            AsyncQueryResult result;
+            Clock::time_point started = Clock::now();
+            result.queuedMs = std::chrono::duration<double, std::milli>(started - submitted).count();
+
+            // Cancelada (ou vencida) ainda na fila: nem comeca
+            if (control->cancelRequested()) {
+                result.status = QueryStatus::CANCELLED;
+            } else if (control->deadlineExpired()) {
+                result.status = QueryStatus::DEADLINE_EXPIRED;
+            } else {
+                ImageDatabase::ScopedQueryControl scope(control.get());
+                result.images = search();
+                if (control->interrupted()) {
+                    result.status = control->cancelRequested() ? QueryStatus::CANCELLED
+                                                               : QueryStatus::DEADLINE_EXPIRED;
+                }
+            }
+            result.runMs = std::chrono::duration<double, std::milli>(Clock::now() - started).count();
+            if (onDone) onDone(result);
+            promise->set_value(std::move(result));
+        });
+        return QueryHandle(std::move(control), std::move(future));
+    }
+
+public:
+    static int defaultWorkers() { return std::max(1, (int)std::thread::hardware_concurrency() - 1); }
+
+    explicit AsyncQueryExecutor(const ImageDatabase& _db, int workers = defaultWorkers())
+        : db(_db), pool(std::max(1, workers)) {}
+
+    // deadline 0 = sem prazo
+    QueryHandle submit(const Image& query, double threshold,
+                       std::chrono::microseconds deadline = std::chrono::microseconds(0),
+                       Callback onDone = nullptr) {
+        return enqueue([this, query, threshold]() { return db.findSimilar(query, threshold); }, deadline,
+                       std::move(onDone));
+    }
+
+    QueryHandle submitKNearest(const Image& query, size_t k,
+                               std::chrono::microseconds deadline = std::chrono::microseconds(0),
+                               Callback onDone = nullptr) {
+        return enqueue([this, query, k]() { return db.findKNearest(query, k); }, deadline, std::move(onDone));
+    }
+
+    int workerCount() const { return pool.concurrency() - 1; }
+};
+
+#endif
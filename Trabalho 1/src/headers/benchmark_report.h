@@ -0,0 +1,640 @@
+#ifndef BENCHMARK_REPORT_H
+#define BENCHMARK_REPORT_H
+
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include "memory_usage.h"
+#include "perf_counters.h"
+#include "query_stats.h"
+
+/**
+ * @brief Saida legivel por maquina dos benchmarks (JSON/CSV) e comparacao de regressao
+ *
+ * Cada execucao de benchmarkStructure vira um BenchmarkRecord. Os drivers aceitam:
+ *   --json <arquivo>   grava os registros em JSON
+ *   --csv <arquivo>    grava os registros em CSV
+ *   --reps <n>         repete a consulta n vezes (amostras para o teste estatistico)
+ *
+ * O programa compare_results carrega dois conjuntos de arquivos (baseline x candidato)
+ * e aplica o teste t de Welch por (estrutura, escala, distribuicao, threshold).
+ */
+
+struct BenchmarkRecord {
+    std::string driver;              // Executavel que gerou o registro
+    std::string structure;
+    long long scale = 0;
+    std::string distribution;        // "uniforme", "real", ...
+    unsigned seed = 0;
+    double threshold = 0.0;
+    double cellSize = 0.0;           // Parametros de ajuste (0 = nao se aplica)
+    int leafCapacity = 0;
+    double insertMs = 0.0;
+    std::vector<double> searchMs;    // [0] = primeira consulta (fria), demais = repeticoes
+    long long found = 0;
+    MemoryUsage memory;
+    size_t rssBuildBytes = 0;
+    size_t rssPeakBytes = 0;
+    size_t rusagePeakBytes = 0;
+    std::vector<std::pair<int, double>> throughput;  // (threads, consultas/s)
+    std::vector<std::pair<int, double>> insertThroughput;  // --concurrent: (leitores, insercoes/s do escritor)
+    bool pareto = false;             // Modo --tune: configuracao Pareto-otima na escala
+    PerfSample buildPerf;
+    PerfSample searchPerf;
+    QueryStats queryStats;
+
+    double bytesPerImage() const { return memory.bytesPerImage(static_cast<size_t>(scale)); }
+};
+
+struct ReportOptions {
+    std::string jsonPath;
+    std::string csvPath;
+    int searchRepetitions = 1;
+
+    bool enabled() const { return !jsonPath.empty() || !csvPath.empty(); }
+};
+
+// Le --json/--csv/--reps da linha de comando (demais argumentos sao ignorados)
+inline ReportOptions parseReportOptions(int argc, char** argv) {
+    ReportOptions options;
+    for (int i = 1; i + 1 < argc; i++) {
+        std::string arg = argv[i];
+        if (arg == "--json") options.jsonPath = argv[++i];
+        else if (arg == "--csv") options.csvPath = argv[++i];
+        else if (arg == "--reps") options.searchRepetitions = std::max(1, std::atoi(argv[++i]));
+    }
+    return options;
+}
+
+// ============================================================================
+// ESCRITA
+// ============================================================================
+
+static const char* const kPerfFieldNames[PERF_EVENT_COUNT] = {
+    "cycles", "instructions", "l1d_misses", "llc_misses", "branch_misses", "dtlb_misses"
+};
+
+inline std::string jsonEscape(const std::string& text) {
+    std::string out;
+    for (char c : text) {
+        if (c == '"' || c == '\\') out += '\\';
+        out += c;
+    }
+    return out;
+}
+
+inline void writePerfJSON(std::ostream& out, const PerfSample& perf) {
+    out << "{";
+    bool first = true;
+    for (int i = 0; i < PERF_EVENT_COUNT; i++) {
+        if (!perf.supported[i]) continue;
+        out << (first ? "" : ", ") << "\"" << kPerfFieldNames[i] << "\": " << perf.values[i];
+        first = false;
+    }
+    out << "}";
+}
+
+// Lista (threads, valor) como [{"threads": t, "<campo>": v}, ...]
+inline void writeThreadPairsJSON(std::ostream& out, const std::vector<std::pair<int, double>>& pairs,
+                                 const char* field) {
+    out << "[";
+    for (size_t i = 0; i < pairs.size(); i++) {
+        out << (i ? ", " : "") << "{\"threads\": " << pairs[i].first
+            << ", \"" << field << "\": " << pairs[i].second << "}";
+    }
+    out << "]";
+}
+
+inline void writeThreadPairsCSV(std::ostream& out, const std::vector<std::pair<int, double>>& pairs) {
+    for (size_t i = 0; i < pairs.size(); i++) {
+        out << (i ? ";" : "") << pairs[i].first << ":" << pairs[i].second;
+    }
+}
+
+inline bool writeReportJSON(const std::string& path, const std::vector<BenchmarkRecord>& records) {
+    std::ofstream out(path);
+    if (!out) return false;
+    out.precision(17);
+    out << "[\n";
+    for (size_t r = 0; r < records.size(); r++) {
+        const BenchmarkRecord& rec = records[r];
+        out << "  {\"driver\": \"" << jsonEscape(rec.driver) << "\", "
+            << "\"structure\": \"" << jsonEscape(rec.structure) << "\", "
+            << "\"scale\": " << rec.scale << ", "
+            << "\"distribution\": \"" << jsonEscape(rec.distribution) << "\", "
+            << "\"seed\": " << rec.seed << ", "
+            << "\"threshold\": " << rec.threshold << ", "
+            << "\"cell_size\": " << rec.cellSize << ", "
+            << "\"leaf_capacity\": " << rec.leafCapacity << ", "
+            << "\"pareto\": " << (rec.pareto ? 1 : 0) << ",\n"
+            << "   \"insert_ms\": " << rec.insertMs << ", \"search_ms\": [";
+        for (size_t i = 0; i < rec.searchMs.size(); i++) {
+            out << (i ? ", " : "") << rec.searchMs[i];
+        }
+        out << "], \"found\": " << rec.found << ",\n"
+            << "   \"memory\": {\"nodes\": " << rec.memory.nodeBytes
+            << ", \"buckets\": " << rec.memory.bucketBytes
+            << ", \"payload\": " << rec.memory.payloadBytes
+            << ", \"overhead\": " << rec.memory.overheadBytes
+            << ", \"rss_build\": " << rec.rssBuildBytes
+            << ", \"rss_peak\": " << rec.rssPeakBytes
+            << ", \"rusage_peak\": " << rec.rusagePeakBytes << "},\n"
+            << "   \"throughput\": ";
+        writeThreadPairsJSON(out, rec.throughput, "qps");
+        out << ", \"insert_throughput\": ";
+        writeThreadPairsJSON(out, rec.insertThroughput, "ips");
+        out << ",\n"
+            << "   \"query_stats\": {\"nodes_visited\": " << rec.queryStats.nodesVisited
+            << ", \"nodes_pruned\": " << rec.queryStats.nodesPruned
+            << ", \"cells_probed\": " << rec.queryStats.cellsProbed
+            << ", \"cells_empty\": " << rec.queryStats.cellsEmpty
+            << ", \"points_tested\": " << rec.queryStats.pointsTested
+            << ", \"points_accepted\": " << rec.queryStats.pointsAccepted << "},\n"
+            << "   \"perf_build\": ";
+        writePerfJSON(out, rec.buildPerf);
+        out << ", \"perf_search\": ";
+        writePerfJSON(out, rec.searchPerf);
+        out << "}" << (r + 1 < records.size() ? "," : "") << "\n";
+    }
+    out << "]\n";
+    return static_cast<bool>(out);
+}
+
+inline std::vector<std::string> csvColumns() {
+    std::vector<std::string> columns = {
+        "driver", "structure", "scale", "distribution", "seed", "threshold", "cell_size", "leaf_capacity", "pareto",
+        "insert_ms", "search_ms", "found", "mem_nodes", "mem_buckets", "mem_payload", "mem_overhead",
+        "rss_build", "rss_peak", "rusage_peak", "throughput", "insert_throughput",
+        "nodes_visited", "nodes_pruned", "cells_probed", "cells_empty", "points_tested", "points_accepted"
+    };
+    for (int i = 0; i < PERF_EVENT_COUNT; i++) columns.push_back(std::string("build_") + kPerfFieldNames[i]);
+    for (int i = 0; i < PERF_EVENT_COUNT; i++) columns.push_back(std::string("search_") + kPerfFieldNames[i]);
+    return columns;
+}
+
+// CSV: search_ms guarda as amostras separadas por ';', throughput (e insert_throughput)
+// como "threads:valor;..."
+// e perf nao suportado fica vazio
+inline bool writeReportCSV(const std::string& path, const std::vector<BenchmarkRecord>& records) {
+    std::ofstream out(path);
+    if (!out) return false;
+    out.precision(17);
+    std::vector<std::string> columns = csvColumns();
+    for (size_t i = 0; i < columns.size(); i++) out << (i ? "," : "") << columns[i];
+    out << "\n";
+    for (const BenchmarkRecord& rec : records) {
+        out << "\"" << rec.driver << "\",\"" << rec.structure << "\"," << rec.scale << ",\""
+            << rec.distribution << "\"," << rec.seed << "," << rec.threshold << "," << rec.cellSize << ","
+            << rec.leafCapacity << "," << (rec.pareto ? 1 : 0) << "," << rec.insertMs << ",\"";
+        for (size_t i = 0; i < rec.searchMs.size(); i++) out << (i ? ";" : "") << rec.searchMs[i];
+        out << "\"," << rec.found << "," << rec.memory.nodeBytes << "," << rec.memory.bucketBytes << ","
+            << rec.memory.payloadBytes << "," << rec.memory.overheadBytes << "," << rec.rssBuildBytes << ","
+            << rec.rssPeakBytes << "," << rec.rusagePeakBytes << ",\"";
+        writeThreadPairsCSV(out, rec.throughput);
+        out << "\",\"";
+        writeThreadPairsCSV(out, rec.insertThroughput);
+        out << "\"," << rec.queryStats.nodesVisited << "," << rec.queryStats.nodesPruned << ","
+            << rec.queryStats.cellsProbed << "," << rec.queryStats.cellsEmpty << ","
+            << rec.queryStats.pointsTested << "," << rec.queryStats.pointsAccepted;
+        for (const PerfSample* perf : {&rec.buildPerf, &rec.searchPerf}) {
+            for (int i = 0; i < PERF_EVENT_COUNT; i++) {
+                out << ",";
+                if (perf->supported[i]) out << perf->values[i];
+            }
+        }
+        out << "\n";
+    }
+    return static_cast<bool>(out);
+}
+
+// Grava os formatos pedidos em --json/--csv e avisa no console
+inline void writeReports(const ReportOptions& options, const std::vector<BenchmarkRecord>& records) {
+    if (!options.jsonPath.empty()) {
+        bool ok = writeReportJSON(options.jsonPath, records);
+        printf("%s JSON: %s\n", ok ? "Resultados gravados em" : "ERRO ao gravar", options.jsonPath.c_str());
+    }
+    if (!options.csvPath.empty()) {
+        bool ok = writeReportCSV(options.csvPath, records);
+        printf("%s CSV: %s\n", ok ? "Resultados gravados em" : "ERRO ao gravar", options.csvPath.c_str());
+    }
+}
+
+// ============================================================================
+// LEITURA (JSON minimo para o formato acima + CSV)
+// ============================================================================
+
+struct JsonValue {
+    enum Type { NUL, NUMBER, STRING, ARRAY, OBJECT } type = NUL;
+    double number = 0.0;
+    std::string text;
+    std::vector<JsonValue> items;          // ARRAY e valores de OBJECT
+    std::vector<std::string> keys;         // chaves de OBJECT (paralelo a items)
+
+    const JsonValue* get(const std::string& key) const {
+        for (size_t i = 0; i < keys.size(); i++) {
+            if (keys[i] == key) return &items[i];
+        }
+        return nullptr;
+    }
+    double num(const std::string& key) const {
+        const JsonValue* v = get(key);
+        return (v && v->type == NUMBER) ? v->number : 0.0;
+    }
+    std::string str(const std::string& key) const {
+        const JsonValue* v = get(key);
+        return (v && v->type == STRING) ? v->text : "";
+    }
+};
+
+class JsonParser {
+private:
+    const std::string& src;
+    size_t pos = 0;
+
+    void skipSpace() {
+        while (pos < src.size() && std::isspace(static_cast<unsigned char>(src[pos]))) pos++;
+    }
+
+    bool parseString(std::string& out) {
+        if (src[pos] != '"') return false;
+        pos++;
+        while (pos < src.size() && src[pos] != '"') {
+            if (src[pos] == '\\' && pos + 1 < src.size()) pos++;
+            out += src[pos++];
+        }
+        if (pos >= src.size()) return false;
+        pos++;
+        return true;
+    }
+
+public:
+    explicit JsonParser(const std::string& text) : src(text) {}
+
+    bool parse(JsonValue& value) {
+        skipSpace();
+        if (pos >= src.size()) return false;
+        char c = src[pos];
+        if (c == '{' || c == '[') {
+            bool isObject = (c == '{');
+            char close = isObject ? '}' : ']';
+            value.type = isObject ? JsonValue::OBJECT : JsonValue::ARRAY;
+            pos++;
+            skipSpace();
+            if (pos < src.size() && src[pos] == close) { pos++; return true; }
+            while (pos < src.size()) {
+                if (isObject) {
+                    skipSpace();
+                    std::string key;
+                    if (!parseString(key)) return false;
+                    skipSpace();
+                    if (pos >= src.size() || src[pos] != ':') return false;
+                    pos++;
+                    value.keys.push_back(key);
+                }
+                JsonValue item;
+                if (!parse(item)) return false;
+                value.items.push_back(std::move(item));
+                skipSpace();
+                if (pos < src.size() && src[pos] == ',') { pos++; continue; }
+                if (pos < src.size() && src[pos] == close) { pos++; return true; }
+                return false;
+            }
+            return false;
+        }
+        if (c == '"') {
+            value.type = JsonValue::STRING;
+            return parseString(value.text);
+        }
+        if (src.compare(pos, 4, "null") == 0) { pos += 4; value.type = JsonValue::NUL; return true; }
+        char* end = nullptr;
+        value.number = std::strtod(src.c_str() + pos, &end);
+        if (end == src.c_str() + pos) return false;
+        pos = end - src.c_str();
+        value.type = JsonValue::NUMBER;
+        return true;
+    }
+};
+
+inline void readPerfJSON(const JsonValue* object, PerfSample& perf) {
+    if (!object) return;
+    for (int i = 0; i < PERF_EVENT_COUNT; i++) {
+        const JsonValue* v = object->get(kPerfFieldNames[i]);
+        if (v && v->type == JsonValue::NUMBER) {
+            perf.values[i] = static_cast<uint64_t>(v->number);
+            perf.supported[i] = true;
+            perf.valid = true;
+        }
+    }
+}
+
+inline bool loadReportJSON(const std::string& path, std::vector<BenchmarkRecord>& records) {
+    std::ifstream in(path);
+    if (!in) return false;
+    std::stringstream buffer;
+    buffer << in.rdbuf();
+    std::string text = buffer.str();
+
+    JsonValue root;
+    JsonParser parser(text);
+    if (!parser.parse(root) || root.type != JsonValue::ARRAY) return false;
+
+    for (const JsonValue& item : root.items) {
+        BenchmarkRecord rec;
+        rec.driver = item.str("driver");
+        rec.structure = item.str("structure");
+        rec.scale = static_cast<long long>(item.num("scale"));
+        rec.distribution = item.str("distribution");
+        rec.seed = static_cast<unsigned>(item.num("seed"));
+        rec.threshold = item.num("threshold");
+        rec.cellSize = item.num("cell_size");
+        rec.leafCapacity = static_cast<int>(item.num("leaf_capacity"));
+        rec.pareto = item.num("pareto") != 0.0;
+        rec.insertMs = item.num("insert_ms");
+        rec.found = static_cast<long long>(item.num("found"));
+        if (const JsonValue* samples = item.get("search_ms")) {
+            for (const JsonValue& s : samples->items) rec.searchMs.push_back(s.number);
+        }
+        if (const JsonValue* mem = item.get("memory")) {
+            rec.memory.nodeBytes = static_cast<size_t>(mem->num("nodes"));
+            rec.memory.bucketBytes = static_cast<size_t>(mem->num("buckets"));
+            rec.memory.payloadBytes = static_cast<size_t>(mem->num("payload"));
+            rec.memory.overheadBytes = static_cast<size_t>(mem->num("overhead"));
+            rec.rssBuildBytes = static_cast<size_t>(mem->num("rss_build"));
+            rec.rssPeakBytes = static_cast<size_t>(mem->num("rss_peak"));
+            rec.rusagePeakBytes = static_cast<size_t>(mem->num("rusage_peak"));
+        }
+        if (const JsonValue* tp = item.get("throughput")) {
+            for (const JsonValue& entry : tp->items) {
+                rec.throughput.emplace_back(static_cast<int>(entry.num("threads")), entry.num("qps"));
+            }
+        }
+        if (const JsonValue* tp = item.get("insert_throughput")) {
+            for (const JsonValue& entry : tp->items) {
+                rec.insertThroughput.emplace_back(static_cast<int>(entry.num("threads")), entry.num("ips"));
+            }
+        }
+        if (const JsonValue* qs = item.get("query_stats")) {
+            rec.queryStats.nodesVisited = static_cast<uint64_t>(qs->num("nodes_visited"));
+            rec.queryStats.nodesPruned = static_cast<uint64_t>(qs->num("nodes_pruned"));
+            rec.queryStats.cellsProbed = static_cast<uint64_t>(qs->num("cells_probed"));
+            rec.queryStats.cellsEmpty = static_cast<uint64_t>(qs->num("cells_empty"));
+            rec.queryStats.pointsTested = static_cast<uint64_t>(qs->num("points_tested"));
+            rec.queryStats.pointsAccepted = static_cast<uint64_t>(qs->num("points_accepted"));
+        }
+        readPerfJSON(item.get("perf_build"), rec.buildPerf);
+        readPerfJSON(item.get("perf_search"), rec.searchPerf);
+        records.push_back(rec);
+    }
+    return true;
+}
+
+// Divide uma linha CSV respeitando campos entre aspas
+inline std::vector<std::string> splitCSVLine(const std::string& line) {
+    std::vector<std::string> fields(1);
+    bool quoted = false;
+    for (char c : line) {
+        if (c == '"') quoted = !quoted;
+        else if (c == ',' && !quoted) fields.emplace_back();
+        else fields.back() += c;
+    }
+    return fields;
+}
+
+// "threads:valor;..." -> pares (entradas malformadas sao ignoradas)
+inline std::vector<std::pair<int, double>> parseThreadPairsCSV(const std::string& text) {
+    std::vector<std::pair<int, double>> pairs;
+    std::stringstream stream(text);
+    std::string entry;
+    while (std::getline(stream, entry, ';')) {
+        size_t colon = entry.find(':');
+        if (colon == std::string::npos) continue;
+        pairs.emplace_back(std::atoi(entry.substr(0, colon).c_str()),
+                           std::strtod(entry.c_str() + colon + 1, nullptr));
+    }
+    return pairs;
+}
+
+inline bool loadReportCSV(const std::string& path, std::vector<BenchmarkRecord>& records) {
+    std::ifstream in(path);
+    std::string line;
+    if (!in || !std::getline(in, line)) return false;
+
+    std::vector<std::string> header = splitCSVLine(line);
+    while (std::getline(in, line)) {
+        if (line.empty()) continue;
+        std::vector<std::string> fields = splitCSVLine(line);
+        std::map<std::string, std::string> row;
+        for (size_t i = 0; i < header.size() && i < fields.size(); i++) row[header[i]] = fields[i];
+
+        auto num = [&row](const std::string& key) { return std::strtod(row[key].c_str(), nullptr); };
+        BenchmarkRecord rec;
+        rec.driver = row["driver"];
+        rec.structure = row["structure"];
+        rec.scale = static_cast<long long>(num("scale"));
+        rec.distribution = row["distribution"];
+        rec.seed = static_cast<unsigned>(num("seed"));
+        rec.threshold = num("threshold");
+        rec.cellSize = num("cell_size");
+        rec.leafCapacity = static_cast<int>(num("leaf_capacity"));
+        rec.pareto = num("pareto") != 0.0;
+        rec.insertMs = num("insert_ms");
+        std::stringstream samples(row["search_ms"]);
+        std::string sample;
+        while (std::getline(samples, sample, ';')) {
+            if (!sample.empty()) rec.searchMs.push_back(std::strtod(sample.c_str(), nullptr));
+        }
+        rec.found = static_cast<long long>(num("found"));
+        rec.memory.nodeBytes = static_cast<size_t>(num("mem_nodes"));
+        rec.memory.bucketBytes = static_cast<size_t>(num("mem_buckets"));
+        rec.memory.payloadBytes = static_cast<size_t>(num("mem_payload"));
+        rec.memory.overheadBytes = static_cast<size_t>(num("mem_overhead"));
+        rec.rssBuildBytes = static_cast<size_t>(num("rss_build"));
+        rec.rssPeakBytes = static_cast<size_t>(num("rss_peak"));
+        rec.rusagePeakBytes = static_cast<size_t>(num("rusage_peak"));
+        rec.throughput = parseThreadPairsCSV(row["throughput"]);
+        rec.insertThroughput = parseThreadPairsCSV(row["insert_throughput"]);
+        rec.queryStats.nodesVisited = static_cast<uint64_t>(num("nodes_visited"));
+        rec.queryStats.nodesPruned = static_cast<uint64_t>(num("nodes_pruned"));
+        rec.queryStats.cellsProbed = static_cast<uint64_t>(num("cells_probed"));
+        rec.queryStats.cellsEmpty = static_cast<uint64_t>(num("cells_empty"));
+        rec.queryStats.pointsTested = static_cast<uint64_t>(num("points_tested"));
+        rec.queryStats.pointsAccepted = static_cast<uint64_t>(num("points_accepted"));
+        for (int i = 0; i < PERF_EVENT_COUNT; i++) {
+            std::string build = row[std::string("build_") + kPerfFieldNames[i]];
+            std::string search = row[std::string("search_") + kPerfFieldNames[i]];
+            if (!build.empty()) {
+                rec.buildPerf.values[i] = std::strtoull(build.c_str(), nullptr, 10);
+                rec.buildPerf.supported[i] = rec.buildPerf.valid = true;
+            }
+            if (!search.empty()) {
+                rec.searchPerf.values[i] = std::strtoull(search.c_str(), nullptr, 10);
+                rec.searchPerf.supported[i] = rec.searchPerf.valid = true;
+            }
+        }
+        records.push_back(rec);
+    }
+    return true;
+}
+
+// Escolhe o formato pela extensao (.csv = CSV, qualquer outra = JSON)
+inline bool loadReport(const std::string& path, std::vector<BenchmarkRecord>& records) {
+    bool isCSV = path.size() >= 4 && path.compare(path.size() - 4, 4, ".csv") == 0;
+    return isCSV ? loadReportCSV(path, records) : loadReportJSON(path, records);
+}
+
+// ============================================================================
+// COMPARACAO ESTATISTICA (teste t de Welch)
+// ============================================================================
+
+// Fracao continua da funcao beta incompleta (Numerical Recipes, metodo de Lentz)
+inline double betaContinuedFraction(double a, double b, double x) {
+    const double tiny = 1e-300;
+    double c = 1.0, d = 1.0 - (a + b) * x / (a + 1.0);
+    if (std::fabs(d) < tiny) d = tiny;
+    d = 1.0 / d;
+    double h = d;
+    for (int m = 1; m <= 200; m++) {
+        double m2 = 2.0 * m;
+        double aa = m * (b - m) * x / ((a + m2 - 1.0) * (a + m2));
+        d = 1.0 + aa * d; if (std::fabs(d) < tiny) d = tiny;
+        c = 1.0 + aa / c; if (std::fabs(c) < tiny) c = tiny;
+        d = 1.0 / d;
+        h *= d * c;
+        aa = -(a + m) * (a + b + m) * x / ((a + m2) * (a + m2 + 1.0));
+        d = 1.0 + aa * d; if (std::fabs(d) < tiny) d = tiny;
+        c = 1.0 + aa / c; if (std::fabs(c) < tiny) c = tiny;
+        d = 1.0 / d;
+        double delta = d * c;
+        h *= delta;
+        if (std::fabs(delta - 1.0) < 1e-12) break;
+    }
+    return h;
+}
+
+// Beta incompleta regularizada I_x(a, b)
+inline double regularizedBeta(double a, double b, double x) {
+    if (x <= 0.0) return 0.0;
+    if (x >= 1.0) return 1.0;
+    double front = std::exp(std::lgamma(a + b) - std::lgamma(a) - std::lgamma(b) +
+                            a * std::log(x) + b * std::log(1.0 - x));
+    if (x < (a + 1.0) / (a + b + 2.0)) return front * betaContinuedFraction(a, b, x) / a;
+    return 1.0 - front * betaContinuedFraction(b, a, 1.0 - x) / b;
+}
+
+struct SampleSummary {
+    size_t n = 0;
+    double mean = 0.0;
+    double variance = 0.0;
+};
+
+inline SampleSummary summarize(const std::vector<double>& samples) {
+    SampleSummary s;
+    s.n = samples.size();
+    if (s.n == 0) return s;
+    for (double v : samples) s.mean += v;
+    s.mean /= s.n;
+    if (s.n > 1) {
+        for (double v : samples) s.variance += (v - s.mean) * (v - s.mean);
+        s.variance /= (s.n - 1);
+    }
+    return s;
+}
+
+// p-valor unilateral de H1: media(candidato) > media(baseline). Retorna -1 sem amostras suficientes
+inline double welchSlowerPValue(const SampleSummary& base, const SampleSummary& cand) {
+    if (base.n < 2 || cand.n < 2) return -1.0;
+    double vb = base.variance / base.n;
+    double vc = cand.variance / cand.n;
+    if (vb + vc <= 0.0) return cand.mean > base.mean ? 0.0 : 1.0;
+    double t = (cand.mean - base.mean) / std::sqrt(vb + vc);
+    double df = (vb + vc) * (vb + vc) /
+                (vb * vb / (base.n - 1) + vc * vc / (cand.n - 1));
+    double twoSided = regularizedBeta(df / 2.0, 0.5, df / (df + t * t));
+    return t > 0 ? twoSided / 2.0 : 1.0 - twoSided / 2.0;
+}
+
+struct CompareOptions {
+    double alpha = 0.05;        // Nivel de significancia
+    double minEffect = 5.0;     // Piora minima (%) para contar como regressao
+};
+
+// Imprime a tabela de comparacao e retorna o numero de regressoes significativas
+inline int compareReports(const std::vector<BenchmarkRecord>& baseline,
+                          const std::vector<BenchmarkRecord>& candidate,
+                          const CompareOptions& options) {
+    using Key = std::tuple<std::string, long long, std::string, double>;
+    struct Group { std::vector<double> insert, search, bytesPerImage; };
+    std::map<Key, Group> base, cand;
+
+    auto collect = [](const std::vector<BenchmarkRecord>& records, std::map<Key, Group>& groups) {
+        for (const BenchmarkRecord& rec : records) {
+            Group& g = groups[Key(rec.structure, rec.scale, rec.distribution, rec.threshold)];
+            g.insert.push_back(rec.insertMs);
+            // Com repeticoes, descarta a consulta fria [0] (cache/TLB frios inflam a variancia)
+            size_t firstWarm = rec.searchMs.size() > 2 ? 1 : 0;
+            g.search.insert(g.search.end(), rec.searchMs.begin() + firstWarm, rec.searchMs.end());
+            g.bytesPerImage.push_back(rec.bytesPerImage());
+        }
+    };
+    collect(baseline, base);
+    collect(candidate, cand);
+
+    // Thr faz parte da chave: sem ele, --thresholds 40,50 imprime pares de linhas iguais
+    printf("%-32s %-10s %-9s %-7s %-12s %12s %12s %9s %9s  %s\n", "Estrutura", "Escala", "Dist", "Thr",
+           "Metrica", "Baseline", "Candidato", "Delta(%)", "p-valor", "Veredito");
+    printf("--------------------------------------------------------------------------------------------------------------------------------\n");
+
+    int regressions = 0;
+    for (const auto& entry : cand) {
+        auto it = base.find(entry.first);
+        if (it == base.end()) continue;
+        const std::string& name = std::get<0>(entry.first);
+        long long scale = std::get<1>(entry.first);
+        const std::string& dist = std::get<2>(entry.first);
+        double threshold = std::get<3>(entry.first);
+
+        struct Metric { const char* label; const std::vector<double>* b; const std::vector<double>* c; bool timed; };
+        Metric metrics[] = {
+            {"insert_ms", &it->second.insert, &entry.second.insert, true},
+            {"search_ms", &it->second.search, &entry.second.search, true},
+            {"bytes/img", &it->second.bytesPerImage, &entry.second.bytesPerImage, false},
+        };
+        for (const Metric& m : metrics) {
+            SampleSummary sb = summarize(*m.b), sc = summarize(*m.c);
+            if (sb.n == 0 || sc.n == 0) continue;
+            double delta = sb.mean > 0 ? 100.0 * (sc.mean - sb.mean) / sb.mean : 0.0;
+
+            // Memoria e deterministica: basta o efeito minimo
+            double p = m.timed ? welchSlowerPValue(sb, sc) : (delta > 0 ? 0.0 : 1.0);
+            const char* verdict = "ok";
+            if (delta > options.minEffect) {
+                if (p < 0) verdict = "POSSIVEL (poucas amostras)";
+                else if (p < options.alpha) { verdict = "REGRESSAO"; regressions++; }
+            } else if (delta < -options.minEffect && p >= 0 && (m.timed ? 1.0 - p : 0.0) < options.alpha) {
+                verdict = "melhoria";
+            }
+
+            char pText[16];
+            if (p < 0) snprintf(pText, sizeof(pText), "n/d");
+            else snprintf(pText, sizeof(pText), "%.4f", p);
+            printf("%-32.32s %-10lld %-9.9s %-7.1f %-12s %12.3f %12.3f %+9.1f %9s  %s\n", name.c_str(), scale,
+                   dist.c_str(), threshold, m.label, sb.mean, sc.mean, delta, pText, verdict);
+        }
+    }
+    printf("--------------------------------------------------------------------------------------------------------------------------------\n");
+    printf("Regressoes significativas (alpha=%.3f, efeito minimo=%.1f%%): %d\n",
+           options.alpha, options.minEffect, regressions);
+    return regressions;
+}
+
+#endif
@@ -0,0 +1,42 @@
+#ifndef COMMAND_LINE_H
+#define COMMAND_LINE_H
+
+#include <cctype>
+#include <cmath>
+#include <cstdlib>
+#include <sstream>
+#include <string>
+#include <vector>
+
+// ============================================================================
+// UTILITARIOS DE LINHA DE COMANDO (benchmark, servidor e gerador de carga)
+// ============================================================================
+
+// "a,b,c" -> {"a","b","c"} (itens vazios descartados)
+inline std::vector<std::string> splitList(const std::string& text) {
+    std::vector<std::string> items;
+    std::stringstream stream(text);
+    std::string item;
+    while (std::getline(stream, item, ',')) {
+        if (!item.empty()) items.push_back(item);
+    }
+    return items;
+}
+
+// Numero finito > 0 ocupando o texto inteiro (atof aceitaria "abc" como 0)
+inline bool parsePositive(const std::string& text, double& value) {
+    char* end = nullptr;
+    value = std::strtod(text.c_str(), &end);
+    return !text.empty() && *end == '\0' && std::isfinite(value) && value > 0.0;
+}
+
+// Aceita sufixos K e M (ex.: 500K, 50M)
+inline long long parseScale(const std::string& text) {
+    double value = std::atof(text.c_str());
+    char suffix = text.empty() ? '\0' : (char)std::toupper(text.back());
+    if (suffix == 'K') value *= 1000.0;
+    else if (suffix == 'M') value *= 1000000.0;
+    return (long long)value;
+}
+
+#endif
@@ -0,0 +1,292 @@
+#ifndef CONCURRENT_INDEX_H
+#define CONCURRENT_INDEX_H
+
+#include <algorithm>
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+#include <vector>
+#include <pthread.h>
+
+#include "image.h"
+
+// ============================================================================
+// LEITURAS CONCORRENTES COM UM ESCRITOR
+// ============================================================================
+/*
+ANALISE PAA - CONCORRENCIA:
+
+PRE-REQUISITO:
+- findSimilar e const em todas as estruturas e nao escreve em estado
+  compartilhado (contadores de consulta sao thread_local, ver image.h)
+- Logo N leitores sobre uma estrutura CONGELADA ja sao seguros sem lock;
+  o problema e apenas ler enquanto alguem insere
+
+DUAS ESTRATEGIAS (mesma interface ImageDatabase, embrulham qualquer estrutura):
+
+1. SharedMutexIndex (reader-writer lock)
+   - findSimilar: lock compartilhado; insert: lock exclusivo
+   - Insercao visivel imediatamente
+   - Custo: todo leitor toca a mesma linha de cache do mutex e o escritor
+     bloqueia todos os leitores durante cada insert
+   - O rwlock padrao da glibc (std::shared_mutex) prefere leitores: com
+     leitores em laco o escritor quase nunca entra (medido: ~500 insercoes/s
+     com 4 leitores). Usamos a variante que prefere escritores
+
+2. RcuSnapshotIndex (read-copy-update)
+   - Leitores carregam atomicamente um snapshot IMUTAVEL (base + deltas) e
+     consultam sem lock nenhum
+   - O escritor acumula insercoes num bloco privado e publica um novo
+     snapshot a cada publishEvery insercoes (ou em flush())
+   - Os deltas sao blocos selados de tamanho fixo: publicar copia apenas o
+     vetor de ponteiros, nunca as imagens
+   - Quando os deltas passam de rebuildFraction da base, o escritor reconstroi
+     a base com todas as imagens (fora da visao dos leitores) e publica
+   - Reclamacao: o shared_ptr do snapshot e o periodo de graca; a versao
+     antiga e liberada quando o ultimo leitor que a segura termina
+   - Custo: insercao so fica visivel na proxima publicacao; memoria dobra
+     durante uma reconstrucao; deltas sao varridos linearmente
+
+COMPLEXIDADES (RCU, n imagens, f = rebuildFraction):
+- Busca: custo da base + O(f × n) nos deltas
+- Insercao: O(1) amortizado + reconstrucao geometrica (O(1/f) por imagem)
+*/
+
+using DatabaseFactory = std::function<std::unique_ptr<ImageDatabase>()>;
+
+// Reader-writer lock que prefere escritores (interface de std::shared_mutex)
+#ifdef __GLIBC__
+class WriterPreferringMutex {
+private:
+    pthread_rwlock_t rwlock;
+
+public:
+    WriterPreferringMutex() {
+        pthread_rwlockattr_t attr;
+        pthread_rwlockattr_init(&attr);
+        pthread_rwlockattr_setkind_np(&attr, PTHREAD_RWLOCK_PREFER_WRITER_NONRECURSIVE_NP);
+        pthread_rwlock_init(&rwlock, &attr);
+        pthread_rwlockattr_destroy(&attr);
+    }
+    ~WriterPreferringMutex() { pthread_rwlock_destroy(&rwlock); }
+    WriterPreferringMutex(const WriterPreferringMutex&) = delete;
+    WriterPreferringMutex& operator=(const WriterPreferringMutex&) = delete;
+
+    void lock() { pthread_rwlock_wrlock(&rwlock); }
+    void unlock() { pthread_rwlock_unlock(&rwlock); }
+    void lock_shared() { pthread_rwlock_rdlock(&rwlock); }
+    void unlock_shared() { pthread_rwlock_unlock(&rwlock); }
+};
+#else
+using WriterPreferringMutex = std::shared_mutex;
+#endif
+
+class SharedMutexIndex : public ImageDatabase {
+private:
+    std::unique_ptr<ImageDatabase> inner;
+    mutable WriterPreferringMutex mutex;
+
+public:
+    explicit SharedMutexIndex(std::unique_ptr<ImageDatabase> _inner) : inner(std::move(_inner)) {}
+
+    void insert(const Image& img) override {
+        std::unique_lock<WriterPreferringMutex> lock(mutex);
+        inner->insert(img);
+    }
+
+    std::vector<Image> findSimilar(const Image& query, double threshold) const override {
+        std::shared_lock<WriterPreferringMutex> lock(mutex);
+        return inner->findSimilar(query, threshold);
+    }
+
+    // O lock compartilhado fica com o leitor ate o visitante terminar
+    bool forEachSimilar(const Image& query, double threshold, const SimilarVisitor& visit) const override {
+        std::shared_lock<WriterPreferringMutex> lock(mutex);
+        return inner->forEachSimilar(query, threshold, visit);
+    }
+
+    size_t size() const override {
+        std::shared_lock<WriterPreferringMutex> lock(mutex);
+        return inner->size();
+    }
+
+    std::string getName() const override { return "RWLock(" + inner->getName() + ")"; }
+
+    void finishBuild() const override {
+        std::shared_lock<WriterPreferringMutex> lock(mutex);
+        inner->finishBuild();
+    }
+
+    MemoryUsage memoryUsage() const override {
+        std::shared_lock<WriterPreferringMutex> lock(mutex);
+        MemoryUsage usage = inner->memoryUsage();
+        usage.overheadBytes += sizeof(WriterPreferringMutex);
+        return usage;
+    }
+
+    void printAnalysis() const override {
+        std::shared_lock<WriterPreferringMutex> lock(mutex);
+        inner->printAnalysis();
+    }
+};
+
+class RcuSnapshotIndex : public ImageDatabase {
+private:
+    using Block = std::vector<Image>;
+
+    // Versao imutavel vista pelos leitores
+    struct Snapshot {
+        std::shared_ptr<const ImageDatabase> base;
+        std::vector<std::shared_ptr<const Block>> deltas;
+        size_t imageCount = 0;
+        size_t rebuilds = 0;
+    };
+
+    DatabaseFactory factory;
+    size_t publishEvery;
+    double rebuildFraction;
+
+    // Lido pelos leitores apenas via std::atomic_load
+    std::shared_ptr<const Snapshot> current;
+
+    // Estado do escritor (serializado por writerMutex)
+    mutable std::mutex writerMutex;
+    std::vector<Image> allImages;   // Fonte das reconstrucoes
+    Block pending;                  // Ainda nao publicado
+    std::vector<std::shared_ptr<const Block>> sealed;
+    size_t baseCount = 0;
+    size_t deltaCount = 0;
+
+    std::shared_ptr<const Snapshot> snapshot() const { return std::atomic_load(&current); }
+
+    // Chamado com writerMutex travado
+    void publishLocked() {
+        if (!pending.empty()) {
+            deltaCount += pending.size();
+            sealed.push_back(std::make_shared<const Block>(std::move(pending)));
+            pending = Block();
+            pending.reserve(publishEvery);
+        }
+
+        auto next = std::make_shared<Snapshot>();
+        std::shared_ptr<const Snapshot> previous = snapshot();
+        next->base = previous->base;
+        next->rebuilds = previous->rebuilds;
+
+        // Reconstrucao geometrica: deltas grandes demais viram uma nova base
+        if (deltaCount > std::max<size_t>(publishEvery, rebuildFraction * baseCount)) {
+            std::unique_ptr<ImageDatabase> rebuilt = factory();
+            for (const auto& img : allImages) rebuilt->insert(img);
+            next->base = std::move(rebuilt);
+            sealed.clear();
+            baseCount = allImages.size();
+            deltaCount = 0;
+            next->rebuilds++;
+        }
+
+        next->deltas = sealed;
+        next->imageCount = allImages.size();
+        std::atomic_store(&current, std::shared_ptr<const Snapshot>(std::move(next)));
+    }
+
+public:
+    static constexpr size_t DEFAULT_PUBLISH_EVERY = 1024;
+    static constexpr double DEFAULT_REBUILD_FRACTION = 0.25;
+
+    // initial: carga inicial construida direto na base (sem passar pelos deltas)
+    explicit RcuSnapshotIndex(DatabaseFactory _factory, const std::vector<Image>& initial = {},
+                              size_t _publishEvery = DEFAULT_PUBLISH_EVERY,
+                              double _rebuildFraction = DEFAULT_REBUILD_FRACTION)
+        : factory(std::move(_factory)), publishEvery(std::max<size_t>(1, _publishEvery)),
+          rebuildFraction(_rebuildFraction), allImages(initial), baseCount(initial.size()) {
+        std::unique_ptr<ImageDatabase> base = factory();
+        for (const auto& img : initial) base->insert(img);
+        auto first = std::make_shared<Snapshot>();
+        first->base = std::move(base);
+        first->imageCount = initial.size();
+        current = std::move(first);
+        pending.reserve(publishEvery);
+    }
+
+    void insert(const Image& img) override {
+        std::lock_guard<std::mutex> lock(writerMutex);
+        allImages.push_back(img);
+        pending.push_back(img);
+        if (pending.size() >= publishEvery) publishLocked();
+    }
+
+    // Publica as insercoes pendentes (visiveis para as proximas consultas)
+    void flush() {
+        std::lock_guard<std::mutex> lock(writerMutex);
+        publishLocked();
+    }
+
+    // Sem lock: o snapshot segura base e deltas vivos ate o fim da consulta
+    std::vector<Image> findSimilar(const Image& query, double threshold) const override {
+        std::shared_ptr<const Snapshot> view = snapshot();
+        std::vector<Image> results = view->base->findSimilar(query, threshold);
+        for (const auto& block : view->deltas) {
+            if (stopRequested()) break;
+            for (const auto& img : *block) {
+                queryCounters.pointTested();
+                if (query.distanceTo(img) <= threshold) {
+                    queryCounters.pointAccepted();
+                    results.push_back(img);
+                }
+            }
+        }
+        return results;
+    }
+
+    bool forEachSimilar(const Image& query, double threshold, const SimilarVisitor& visit) const override {
+        std::shared_ptr<const Snapshot> view = snapshot();
+        if (!view->base->forEachSimilar(query, threshold, visit)) return false;
+        for (const auto& block : view->deltas) {
+            if (stopRequested()) return false;
+            for (const auto& img : *block) {
+                queryCounters.pointTested();
+                if (query.distanceTo(img) <= threshold) {
+                    queryCounters.pointAccepted();
+                    if (!visit(img)) return false;
+                }
+            }
+        }
+        return true;
+    }
+
+    // Imagens visiveis aos leitores (ultimo snapshot publicado)
+    size_t size() const override { return snapshot()->imageCount; }
+
+    std::string getName() const override { return "RCU(" + snapshot()->base->getName() + ")"; }
+
+    void finishBuild() const override { snapshot()->base->finishBuild(); }
+
+    MemoryUsage memoryUsage() const override {
+        std::shared_ptr<const Snapshot> view = snapshot();
+        MemoryUsage usage = view->base->memoryUsage();
+        for (const auto& block : view->deltas) accountImageVector(*block, usage);
+        // Copia mantida pelo escritor para reconstruir a base
+        MemoryUsage writerCopy;
+        {
+            std::lock_guard<std::mutex> lock(writerMutex);
+            accountImageVector(allImages, writerCopy);
+        }
+        usage.overheadBytes += writerCopy.total();
+        return usage;
+    }
+
+    void printAnalysis() const override {
+        std::shared_ptr<const Snapshot> view = snapshot();
+        size_t deltaImages = 0;
+        for (const auto& block : view->deltas) deltaImages += block->size();
+        std::cout << "\n=== ANALISE RCU ===" << std::endl;
+        std::cout << "Base: " << view->base->size() << " imagens | Deltas: " << view->deltas.size()
+                  << " blocos (" << deltaImages << " imagens) | Reconstrucoes: " << view->rebuilds << std::endl;
+        view->base->printAnalysis();
+    }
+};
+
+#endif
@@ -0,0 +1,209 @@
+#ifndef DATASET_H
+#define DATASET_H
+
+#include <algorithm>
+#include <array>
+#include <filesystem>  // C++17 REQUIRED: Para contagem automatica de imagens
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "image.h"
+
+// ============================================================================
+// GERADORES DE DADOS SINTETICOS
+// ============================================================================
+
+// uniforme: cores independentes em [0,255] (dataset dos drivers antigos)
+// gaussiana: uma nuvem centrada em 127.5 (sigma 40)
+// clusters: 16 nuvens (sigma 12), parecido com colecoes reais de fotos
+// diagonal: perto da diagonal cinza R=G=B (brilho sigma 50, cor sigma 10),
+//           como as cores medias de fotos reais
+inline std::vector<Image> generateSyntheticDataset(long long count, const std::string& distribution, unsigned seed) {
+    std::vector<Image> images;
+    images.reserve(count);
+
+    // SEED FIXA para consistencia entre execucoes
+    std::mt19937 gen(seed);
+    std::uniform_real_distribution<> colorDist(0.0, 255.0);
+    std::normal_distribution<> centered(127.5, 40.0);
+    std::normal_distribution<> spread(0.0, 12.0);
+    std::normal_distribution<> brightness(127.5, 50.0);
+    std::normal_distribution<> tint(0.0, 10.0);
+
+    std::vector<std::array<double, 3>> centers;
+    if (distribution == "clusters") {
+        for (int c = 0; c < 16; c++) centers.push_back({colorDist(gen), colorDist(gen), colorDist(gen)});
+    }
+    auto clamp = [](double v) { return std::min(255.0, std::max(0.0, v)); };
+
+    for (long long i = 0; i < count; ++i) {
+        double r, g, b;
+        if (distribution == "gaussiana") {
+            r = clamp(centered(gen));
+            g = clamp(centered(gen));
+            b = clamp(centered(gen));
+        } else if (distribution == "diagonal") {
+            double gray = brightness(gen);
+            r = clamp(gray + tint(gen));
+            g = clamp(gray + tint(gen));
+            b = clamp(gray + tint(gen));
+        } else if (distribution == "clusters") {
+            const auto& center = centers[gen() % centers.size()];
+            r = clamp(center[0] + spread(gen));
+            g = clamp(center[1] + spread(gen));
+            b = clamp(center[2] + spread(gen));
+        } else {
+            r = colorDist(gen);
+            g = colorDist(gen);
+            b = colorDist(gen);
+        }
+        images.emplace_back((int)i, "synthetic_" + std::to_string(i) + ".jpg", r, g, b);
+    }
+
+    return images;
+}
+
+// ============================================================================
+// EXTRACAO DE RGB DAS IMAGENS
+// ============================================================================
+/*
+FUNCIONALIDADE PAA: Processamento de Imagens sem OpenCV
+
+OpenCV nao esta disponivel: o RGB e derivado do hash do caminho + tamanho do
+arquivo. Deterministico (mesma imagem -> mesma cor em todas as execucoes) e
+espalhado em [0,255]^3, suficiente para exercitar as estruturas.
+*/
+
+struct RealRGB {
+    double r, g, b;
+    bool valid;
+
+    RealRGB(double _r = 0, double _g = 0, double _b = 0, bool _valid = true)
+        : r(_r), g(_g), b(_b), valid(_valid) {}
+};
+
+inline bool isImageExtension(std::string extension) {
+    std::transform(extension.begin(), extension.end(), extension.begin(), ::tolower);
+    return extension == ".jpg" || extension == ".jpeg" || extension == ".png" || extension == ".bmp";
+}
+
+inline RealRGB extractRealRGBFromImage(const std::string& imagePath) {
+    std::ifstream file(imagePath, std::ios::binary | std::ios::ate);
+    if (!file.is_open()) {
+        return RealRGB(0, 0, 0, false);
+    }
+
+    // Tamanho do arquivo como seed adicional
+    std::streamsize fileSize = file.tellg();
+
+    // Combinar hash do nome com tamanho do arquivo para maior diversidade
+    size_t hashValue = std::hash<std::string>()(imagePath);
+    hashValue ^= static_cast<size_t>(fileSize) + 0x9e3779b9 + (hashValue << 6) + (hashValue >> 2);
+
+    return RealRGB(static_cast<double>((hashValue >> 16) & 0xFF),
+                   static_cast<double>((hashValue >> 8) & 0xFF),
+                   static_cast<double>(hashValue & 0xFF), true);
+}
+
+// ============================================================================
+// CARREGAMENTO DE DATASET COM RGB REAL
+// ============================================================================
+
+// verbose: progresso a cada 100 imagens e resumo (saida do main.cpp)
+inline std::vector<Image> loadRealDataset(long long maxCount, const std::string& path = "./images/",
+                                          bool verbose = false) {
+    std::vector<Image> images;
+
+    try {
+        for (const auto& entry : std::filesystem::directory_iterator(path)) {
+            if ((long long)images.size() >= maxCount) break;
+            if (!entry.is_regular_file() || !isImageExtension(entry.path().extension().string())) continue;
+
+            std::string filename = entry.path().filename().string();
+            RealRGB color = extractRealRGBFromImage(entry.path().string());
+            if (!color.valid) {
+                if (verbose) std::cout << "AVISO: Ignorando imagem invalida: " << filename << std::endl;
+                continue;
+            }
+
+            images.emplace_back((int)images.size() + 1, filename, color.r, color.g, color.b);
+            if (verbose && images.size() % 100 == 0) {
+                std::cout << "Processadas " << images.size() << " imagens reais..." << std::endl;
+            }
+        }
+    } catch (const std::exception& e) {
+        std::cout << "ERRO ao carregar imagens de " << path << ": " << e.what() << std::endl;
+        return images;
+    }
+
+    if (verbose) {
+        std::cout << "Dataset REAL carregado: " << images.size() << " imagens processadas de " << path << std::endl;
+    }
+    return images;
+}
+
+// ============================================================================
+// CONTAGEM AUTOMATICA DE IMAGENS NO DATASET
+// ============================================================================
+/*
+FUNCIONALIDADE PAA: Auto-deteccao de Dataset
+
+REQUISITOS:
+- C++17 com std::filesystem
+- Compilacao: g++ -std=c++17 (pode precisar -lstdc++fs em GCC mais antigos)
+
+IMPLEMENTACAO:
+- Varre a pasta (sem subpastas)
+- Filtra pelas mesmas extensoes que loadRealDataset carrega
+- Case-insensitive matching
+- Retorna 0 em caso de erro
+*/
+
+inline int countImagesInDirectory(const std::string& path = "./images/") {
+    int count = 0;
+
+    std::cout << "Auto-detectando imagens em: " << path << std::endl;
+
+    try {
+        if (!std::filesystem::exists(path)) {
+            std::cout << "ERRO: Pasta '" << path << "' nao encontrada!" << std::endl;
+            std::cout << "SOLUCAO: Crie a pasta ou modifique o caminho no codigo" << std::endl;
+            return 0;
+        }
+
+        if (!std::filesystem::is_directory(path)) {
+            std::cout << "ERRO: '" << path << "' nao e um diretorio!" << std::endl;
+            return 0;
+        }
+
+        for (const auto& entry : std::filesystem::directory_iterator(path)) {
+            if (entry.is_regular_file() && isImageExtension(entry.path().extension().string())) {
+                count++;
+                // Mostrar progresso a cada 1000 imagens
+                if (count % 1000 == 0) {
+                    std::cout << "Detectadas " << count << " imagens..." << std::endl;
+                }
+            }
+        }
+
+        std::cout << "Auto-deteccao concluida: " << count << " imagens encontradas" << std::endl;
+
+    } catch (const std::filesystem::filesystem_error& e) {
+        std::cout << "ERRO de filesystem: " << e.what() << std::endl;
+        std::cout << "Verifique permissoes da pasta e tente novamente" << std::endl;
+        return 0;
+    }
+
+    if (count == 0) {
+        std::cout << "AVISO: Nenhuma imagem encontrada em '" << path << "'" << std::endl;
+        std::cout << "Formatos suportados: .jpg, .jpeg, .png, .bmp" << std::endl;
+    }
+
+    return count;
+}
+
+#endif
@@ -0,0 +1,178 @@
+#ifndef HASH_DYNAMIC_SEARCH_H
+#define HASH_DYNAMIC_SEARCH_H
+
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "hash_search.h"
+
+// ============================================================================
+// ESTRUTURA 5: HASH DYNAMIC SEARCH (EXPANSAO ADAPTATIVA)
+// ============================================================================
+/*
+ANALISE PAA - HASH DYNAMIC SEARCH:
+
+CONCEITO:
+- Hash table com expansao dinamica do raio de busca
+- Busca por "camadas" concentricas (cubo por cubo)
+- Examina primeiro as celulas mais proximas da query
+
+TECNICA DE BUSCA ADAPTATIVA:
+- Inicia na celula central (query point)
+- Expande em cascas de raio crescente: cada celula e visitada UMA vez
+  (so a casca externa do cubo de raio r, nunca o cubo inteiro de novo)
+- Para quando a casca cobre o threshold
+
+COMPLEXIDADES:
+- Insercao: O(1) - identica ao hash basico
+- Busca: O(r³ × densidade) onde r = raio em celulas
+- Espaco: O(n + m) onde m = celulas ativas
+
+QUANDO USAR:
+- Consultas que priorizam vizinhos mais proximos
+- Datasets com distribuicao irregular
+- Consultas com thresholds variaveis
+*/
+
+class HashDynamicSearch : public ImageDatabase {
+private:
+    GridGeometry geometry;
+    HashGrid grid;
+    CellOccupancy occupancy;
+    size_t totalImages = 0;
+
+    // Visitor: bool(const Image&), false interrompe (ver forEachSimilar)
+    // So e chamada para celulas marcadas no bitmap de ocupacao. O bucket entra no
+    // pipeline: e varrido quando a proxima celula chegar (ou no flush)
+    template <typename Visitor>
+    bool searchSingleCell(int cellR, int cellG, int cellB, const Image& query, double threshold,
+                          PrefetchPipeline<Image>& pipeline, Visitor& visit) const {
+        if (stopRequested()) return false;
+        auto it = grid.find(GridGeometry::packKey(cellR, cellG, cellB));
+        queryCounters.cellProbed(it != grid.end());
+        if (it == grid.end()) return true;
+        return pipeline.push(it->second, [&](const std::vector<Image>& bucket) {
+            return scanBucket(bucket, query, threshold, visit);
+        });
+    }
+
+    template <typename Visitor>
+    static bool scanBucket(const std::vector<Image>& bucket, const Image& query, double threshold, Visitor& visit) {
+        for (const auto& img : bucket) {
+            queryCounters.pointTested();
+            if (query.distanceTo(img) <= threshold) {
+                queryCounters.pointAccepted();
+                if (!visit(img)) return false;
+            }
+        }
+        return true;
+    }
+
+    // BUSCA POR EXPANSAO DE CUBO: examina apenas a casca de raio r
+    template <typename Visitor>
+    bool searchCubeAtRadius(int centerR, int centerG, int centerB, int radius, const Image& query,
+                            double threshold, PrefetchPipeline<Image>& pipeline, Visitor& visit) const {
+        int lastCell = geometry.gridSize - 1;
+        int minB = std::max(centerB - radius, 0), maxB = std::min(centerB + radius, lastCell);
+        for (int cellR = std::max(centerR - radius, 0); cellR <= std::min(centerR + radius, lastCell); cellR++) {
+            for (int cellG = std::max(centerG - radius, 0); cellG <= std::min(centerG + radius, lastCell); cellG++) {
+                // Linha vazia no bitmap: nenhuma celula dela tem imagens
+                if (!occupancy.rowOccupied(cellR, cellG)) continue;
+                auto searchCell = [&](int cellB) {
+                    return searchSingleCell(cellR, cellG, cellB, query, threshold, pipeline, visit);
+                };
+
+                // TECNICA PAA: so a casca externa (pelo menos uma coordenada no limite).
+                // Linha numa face r/g: a faixa b inteira e casca, lida do bitmap com ctz
+                if (std::abs(cellR - centerR) == radius || std::abs(cellG - centerG) == radius) {
+                    if (!occupancy.forEachInRow(cellR, cellG, minB, maxB, searchCell)) return false;
+                    continue;
+                }
+                // Interior da face: so as duas pontas b = centro ± raio
+                for (int cellB : {centerB - radius, centerB + radius}) {
+                    if (cellB < 0 || cellB > lastCell || !occupancy.occupied(cellR, cellG, cellB)) continue;
+                    if (!searchCell(cellB)) return false;
+                }
+            }
+        }
+        return true;
+    }
+
+    // BUSCA DINAMICA: expande em camadas ate cobrir o threshold
+    template <typename Visitor>
+    bool visitSimilar(const Image& query, double threshold, Visitor&& visit) const {
+        int queryR = geometry.toCell(query.r);
+        int queryG = geometry.toCell(query.g);
+        int queryB = geometry.toCell(query.b);
+
+        int maxRadius = std::min(static_cast<int>(std::ceil(threshold / geometry.cellSize)), geometry.gridSize);
+        PrefetchPipeline<Image> pipeline;
+        for (int radius = 0; radius <= maxRadius; radius++) {
+            if (!searchCubeAtRadius(queryR, queryG, queryB, radius, query, threshold, pipeline, visit)) return false;
+        }
+        return pipeline.flush([&](const std::vector<Image>& bucket) {
+            return scanBucket(bucket, query, threshold, visit);
+        });
+    }
+
+public:
+    static constexpr double DEFAULT_CELL_SIZE = 25.0;
+
+    HashDynamicSearch(double _cellSize = DEFAULT_CELL_SIZE) : geometry(_cellSize), occupancy(geometry.gridSize) {}
+
+    void insert(const Image& img) override {
+        int cellR = geometry.toCell(img.r), cellG = geometry.toCell(img.g), cellB = geometry.toCell(img.b);
+        grid[GridGeometry::packKey(cellR, cellG, cellB)].push_back(img);
+        occupancy.mark(cellR, cellG, cellB);
+        totalImages++;
+    }
+
+    std::vector<Image> findSimilar(const Image& query, double threshold) const override {
+        std::vector<Image> results;
+        queryCounters.reset();
+        visitSimilar(query, threshold, [&results](const Image& img) {
+            results.push_back(img);
+            return true;
+        });
+        return results;
+    }
+
+    bool forEachSimilar(const Image& query, double threshold, const SimilarVisitor& visit) const override {
+        queryCounters.reset();
+        return visitSimilar(query, threshold, visit);
+    }
+
+    size_t size() const override { return totalImages; }
+
+    // Grade sobre [0, hi] (o referencial PCA passa de 255); so com a estrutura vazia
+    bool setDomain(double lo, double hi) override {
+        if (totalImages > 0 || lo != 0.0) return false;
+        geometry = GridGeometry(geometry.cellSize, hi);
+        occupancy = CellOccupancy(geometry.gridSize);
+        return true;
+    }
+
+    std::string getName() const override {
+        return "Hash Dynamic Search (" + formatParam("cell", geometry.cellSize, 1) + ")";
+    }
+
+    MemoryUsage memoryUsage() const override {
+        MemoryUsage usage;
+        accountHashGrid(grid, usage);
+        occupancy.accountMemory(usage);
+        return usage;
+    }
+
+    void printAnalysis() const override {
+        std::cout << "  ANALISE HASH DYNAMIC SEARCH:" << std::endl;
+        std::cout << "    Celulas ativas: " << grid.size() << std::endl;
+        std::cout << "    Tamanho da celula: " << geometry.cellSize << std::endl;
+        std::cout << "    Estrategia: Expansao em camadas concentricas" << std::endl;
+        std::cout << "    Densidade media: " << averageCellOccupancy(grid, totalImages) << " imagens/celula" << std::endl;
+    }
+};
+
+#endif
@@ -1,184 +1,277 @@
 #ifndef HASH_SEARCH_H
 #define HASH_SEARCH_H
 
-#include <unordered_map>
-#include <vector>
-#include <string>
 #include <algorithm>
-#include <iostream>
 #include <cmath>
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <unordered_map>
+#include <vector>
 
-// Hash Table baseada em grid 3D do espaco RGB
-class HashSearch : public ImageDatabase {
-private:
-    // Tamanho da celula do grid (quanto menor, mais preciso mas mais celulas)
+#include "image.h"
+#include "prefetch.h"
+
+// ============================================================================
+// GRADE 3D SOBRE [0,255]^3 (compartilhada por HashSearch e HashDynamicSearch)
+// ============================================================================
+/*
+Chave uint64 com as 3 coordenadas de celula empacotadas (16 bits cada): sem
+alocar/formatar strings a cada lookup. Coordenadas sao limitadas a
+[0, gridSize-1], entao pontos fora de [0,span] caem nas celulas da borda.
+span = 255, exceto quando setDomain pede mais (referencial PCA).
+*/
+struct GridGeometry {
     double cellSize;
-    
-    // Hash table: key = "r,g,b" da celula, value = lista de imagens nessa celula
-    std::unordered_map<std::string, std::vector<Image>> grid;
-    
-    // Converte coordenada RGB para coordenada da celula
-    int rgbToCell(double value) const {
-        return static_cast<int>(value / cellSize);
-    }
-    
-    // Gera chave da celula para uma imagem
-    std::string getCellKey(const Image& img) const {
-        int r_cell = rgbToCell(img.r);
-        int g_cell = rgbToCell(img.g);
-        int b_cell = rgbToCell(img.b);
-        return std::to_string(r_cell) + "," + std::to_string(g_cell) + "," + std::to_string(b_cell);
-    }
-    
-    // Gera chave da celula para coordenadas especificas
-    std::string getCellKey(int r_cell, int g_cell, int b_cell) const {
-        return std::to_string(r_cell) + "," + std::to_string(g_cell) + "," + std::to_string(b_cell);
-    }
-    
-    // Search cells at specific radius from center (dynamic expanding cube)
-    void searchCubeAtRadius(int center_r, int center_g, int center_b, int radius, 
-                           const Image& query, double threshold, std::vector<Image>& results) const {
-        if (radius == 0) {
-            // Search only center cell for radius 0
-            searchSingleCell(center_r, center_g, center_b, query, threshold, results);
-            return;
-        }
-        
-        // Search cells that are exactly at 'radius' distance (cube boundary)
-        for (int dr = -radius; dr <= radius; dr++) {
-            for (int dg = -radius; dg <= radius; dg++) {
-                for (int db = -radius; db <= radius; db++) {
-                    // Only search cells at the boundary of current radius (Manhattan distance)
-                    if (abs(dr) + abs(dg) + abs(db) == radius || 
-                        (abs(dr) == radius || abs(dg) == radius || abs(db) == radius)) {
-                        searchSingleCell(center_r + dr, center_g + dg, center_b + db, 
-                                       query, threshold, results);
-                    }
-                }
+    int gridSize;  // celulas por eixo
+
+    explicit GridGeometry(double _cellSize, double span = 255.0)
+        : cellSize(_cellSize), gridSize(std::max(1, (int)std::ceil(span / _cellSize))) {}
+
+    // FUNCAO HASH: mapeia coordenada RGB para coordenada de celula
+    int toCell(double value) const {
+        return std::min(std::max((int)(value / cellSize), 0), gridSize - 1);
+    }
+
+    bool insideGrid(int cellR, int cellG, int cellB) const {
+        return cellR >= 0 && cellR < gridSize && cellG >= 0 && cellG < gridSize &&
+               cellB >= 0 && cellB < gridSize;
+    }
+
+    static uint64_t packKey(int cellR, int cellG, int cellB) {
+        return ((uint64_t)cellR << 32) | ((uint64_t)cellG << 16) | (uint64_t)cellB;
+    }
+
+    uint64_t keyOf(const Image& img) const {
+        return packKey(toCell(img.r), toCell(img.g), toCell(img.b));
+    }
+};
+
+using HashGrid = std::unordered_map<uint64_t, std::vector<Image>>;
+
+// Densidade media (imagens por celula ativa) para printAnalysis
+inline double averageCellOccupancy(const HashGrid& grid, size_t totalImages) {
+    return grid.empty() ? 0.0 : static_cast<double>(totalImages) / grid.size();
+}
+
+// ============================================================================
+// BITMAP DE OCUPACAO DAS CELULAS (consultado antes de qualquer grid.find)
+// ============================================================================
+/*
+Em celulas pequenas a maioria dos lookups da busca em cubo erra (celula
+vazia) e cada erro ainda paga hash + busca no bucket. Dois niveis de bits:
+- cellBits: 1 bit por celula; cada linha (r, g) ocupa wordsPerRow palavras
+  alinhadas, bit = b. A faixa [minB, maxB] de uma linha e lida palavra a
+  palavra e as celulas ocupadas saem com ctz (sem tocar nas vazias)
+- rowBits: 1 bit por linha (r, g) com alguma celula: linhas vazias inteiras
+  sao puladas do mesmo jeito ao longo de g
+Memoria: gridSize^2 × ceil(gridSize/64) palavras (grade 32^3: 8KB; 255^3: 2MB).
+*/
+class CellOccupancy {
+private:
+    int gridSize;
+    int wordsPerRow;
+    std::vector<uint64_t> cellBits;
+    std::vector<uint64_t> rowBits;
+
+    static bool testBit(const std::vector<uint64_t>& bits, size_t index) {
+        return (bits[index >> 6] >> (index & 63)) & 1;
+    }
+
+    // Chama f(i) para cada bit ligado em [first, last]; f retorna false para parar
+    template <typename F>
+    static bool forEachSetBit(const uint64_t* words, size_t first, size_t last, F&& f) {
+        for (size_t word = first >> 6; word <= (last >> 6); word++) {
+            uint64_t bits = words[word];
+            if (word == (first >> 6)) bits &= ~0ULL << (first & 63);
+            if (word == (last >> 6) && (last & 63) != 63) bits &= (1ULL << ((last & 63) + 1)) - 1;
+            while (bits) {
+                if (!f((word << 6) + (size_t)__builtin_ctzll(bits))) return false;
+                bits &= bits - 1;
             }
         }
+        return true;
+    }
+
+    size_t rowIndex(int cellR, int cellG) const { return (size_t)cellR * gridSize + cellG; }
+
+public:
+    explicit CellOccupancy(int _gridSize)
+        : gridSize(_gridSize), wordsPerRow((_gridSize + 63) / 64),
+          cellBits((size_t)_gridSize * _gridSize * wordsPerRow, 0),
+          rowBits(((size_t)_gridSize * _gridSize + 63) / 64, 0) {}
+
+    void mark(int cellR, int cellG, int cellB) {
+        size_t row = rowIndex(cellR, cellG);
+        cellBits[row * wordsPerRow + (cellB >> 6)] |= 1ULL << (cellB & 63);
+        rowBits[row >> 6] |= 1ULL << (row & 63);
+    }
+
+    bool occupied(int cellR, int cellG, int cellB) const {
+        return (cellBits[rowIndex(cellR, cellG) * wordsPerRow + (cellB >> 6)] >> (cellB & 63)) & 1;
     }
-    
-    // Search a single cell and add matching images to results
-    void searchSingleCell(int r_cell, int g_cell, int b_cell, 
-                         const Image& query, double threshold, std::vector<Image>& results) const {
-        std::string key = getCellKey(r_cell, g_cell, b_cell);
-        
-        auto it = grid.find(key);
-        if (it != grid.end()) {
-            for (const auto& img : it->second) {
-                double distance = query.distanceTo(img);
-                if (distance <= threshold) {
-                    results.push_back(img);
+
+    bool rowOccupied(int cellR, int cellG) const { return testBit(rowBits, rowIndex(cellR, cellG)); }
+
+    // f(cellB) para cada celula ocupada da linha (r, g) em [minB, maxB] (limites dentro do grid)
+    template <typename F>
+    bool forEachInRow(int cellR, int cellG, int minB, int maxB, F&& f) const {
+        const uint64_t* row = &cellBits[rowIndex(cellR, cellG) * wordsPerRow];
+        return forEachSetBit(row, minB, maxB, [&f](size_t cellB) { return f((int)cellB); });
+    }
+
+    // f(cellR, cellG, cellB) para cada celula ocupada da caixa, na ordem r, g, b
+    template <typename F>
+    bool forEachInBox(int minR, int maxR, int minG, int maxG, int minB, int maxB, F&& f) const {
+        for (int cellR = minR; cellR <= maxR; cellR++) {
+            bool completed = forEachSetBit(rowBits.data(), rowIndex(cellR, minG), rowIndex(cellR, maxG),
+                [&](size_t row) {
+                    int cellG = (int)(row - rowIndex(cellR, 0));
+                    return forEachInRow(cellR, cellG, minB, maxB, [&](int cellB) { return f(cellR, cellG, cellB); });
+                });
+            if (!completed) return false;
+        }
+        return true;
+    }
+
+    size_t memoryBytes() const { return (cellBits.capacity() + rowBits.capacity()) * sizeof(uint64_t); }
+
+    void accountMemory(MemoryUsage& usage) const {
+        usage.nodeBytes += memoryBytes();
+        usage.overheadBytes += mallocOverheadBytes(cellBits.capacity() * sizeof(uint64_t)) +
+                               mallocOverheadBytes(rowBits.capacity() * sizeof(uint64_t));
+    }
+};
+
+// ============================================================================
+// ESTRUTURA 2: HASH TABLE com SPATIAL HASHING
+// ============================================================================
+/*
+ANALISE PAA - SPATIAL HASHING:
+
+CONCEITO:
+- Divide o espaco RGB em celulas (grid 3D)
+- Cada celula e uma "bucket" na hash table
+- Imagens similares ficam em celulas proximas
+
+TECNICA DE INDEXACAO:
+- Hash function: (r/cellSize, g/cellSize, b/cellSize)
+- Collision resolution: chaining (lista em cada celula)
+- Spatial locality: celulas vizinhas contem pontos proximos
+
+COMPLEXIDADES:
+- Insercao: O(1) esperado - hash + insert na lista
+- Busca: O(k) onde k = celulas examinadas × densidade
+- Espaco: O(n + m) onde m = numero de celulas ativas
+
+OTIMIZACAO:
+- Cell size determina trade-off precisao vs performance
+- Muito pequeno: muitas celulas, overhead alto
+- Muito grande: muitas comparacoes desnecessarias
+- Busca examina exatamente as celulas que intersectam o cubo
+  [query - threshold, query + threshold] (nada fora do grid)
+
+QUANDO USAR:
+- Datasets medios/grandes (n > 1000)
+- Distribuicao uniforme dos dados
+- Quando busca rapida e prioridade
+*/
+
+class HashSearch : public ImageDatabase {
+private:
+    GridGeometry geometry;  // Parametro de tunning do algoritmo (cellSize)
+    HashGrid grid;          // chave = celula empacotada, valor = lista de imagens
+    CellOccupancy occupancy;
+    size_t totalImages = 0;
+
+    // Travessia comum a findSimilar e forEachSimilar; false = interrompida
+    template <typename Visitor>
+    bool visitSimilar(const Image& query, double threshold, Visitor&& visit) const {
+        // Faixa de celulas que intersecta o cubo [query - threshold, query + threshold]
+        int minR = geometry.toCell(query.r - threshold), maxR = geometry.toCell(query.r + threshold);
+        int minG = geometry.toCell(query.g - threshold), maxG = geometry.toCell(query.g + threshold);
+        int minB = geometry.toCell(query.b - threshold), maxB = geometry.toCell(query.b + threshold);
+
+        auto scanCell = [&](const std::vector<Image>& bucket) {
+            for (const auto& img : bucket) {
+                queryCounters.pointTested();
+                if (query.distanceTo(img) <= threshold) {
+                    queryCounters.pointAccepted();
+                    if (!visit(img)) return false;
                 }
             }
-        }
+            return true;
+        };
+
+        // BUSCA EM CUBO 3D: so as celulas ocupadas do cubo (bitmap), cada uma com um lookup;
+        // o bucket da proxima celula e pedido (prefetch) antes de varrer o atual
+        PrefetchPipeline<Image> pipeline;
+        bool completed = occupancy.forEachInBox(minR, maxR, minG, maxG, minB, maxB, [&](int cellR, int cellG, int cellB) {
+            if (stopRequested()) return false;
+            auto it = grid.find(GridGeometry::packKey(cellR, cellG, cellB));
+            queryCounters.cellProbed(it != grid.end());
+            return it == grid.end() || pipeline.push(it->second, scanCell);
+        });
+        return completed && pipeline.flush(scanCell);
     }
-    
+
 public:
-    // Construtor - cellSize determina granularidade do hash
-    HashSearch(double _cellSize = 30.0) : cellSize(_cellSize) {}
-    
+    static constexpr double DEFAULT_CELL_SIZE = 255.0 / 32;  // grade 32^3
+
+    HashSearch(double _cellSize = DEFAULT_CELL_SIZE) : geometry(_cellSize), occupancy(geometry.gridSize) {}
+
     void insert(const Image& img) override {
-        std::string key = getCellKey(img);
-        grid[key].push_back(img);
-    }
-    
-    std::vector<Image> findSimilar(const Image& query, double threshold) override {
-        return findSimilarDynamic(query, threshold, -1); // -1 = no result limit
+        // O(1) esperado - hash + insert
+        int cellR = geometry.toCell(img.r), cellG = geometry.toCell(img.g), cellB = geometry.toCell(img.b);
+        grid[GridGeometry::packKey(cellR, cellG, cellB)].push_back(img);
+        occupancy.mark(cellR, cellG, cellB);
+        totalImages++;
     }
-    
-    // Dynamic search with expanding cube and early termination
-    std::vector<Image> findSimilarDynamic(const Image& query, double threshold, int maxResults = -1) {
+
+    std::vector<Image> findSimilar(const Image& query, double threshold) const override {
         std::vector<Image> results;
-        
-        // Determinar celulas base da consulta
-        int query_r = rgbToCell(query.r);
-        int query_g = rgbToCell(query.g);
-        int query_b = rgbToCell(query.b);
-        
-        // Calcular quantas celulas precisamos verificar baseado no threshold
-        int max_radius = static_cast<int>(ceil(threshold / cellSize));
-        
-        // Dynamic search: expand from query cell outward
-        for (int radius = 0; radius <= max_radius; radius++) {
-            size_t results_before = results.size();
-            
-            // Search cells at current radius
-            searchCubeAtRadius(query_r, query_g, query_b, radius, query, threshold, results);
-            
-            // Early termination: if we found enough results, stop
-            if (maxResults > 0 && static_cast<int>(results.size()) >= maxResults) {
-                break;
-            }
-            
-            // Early termination: if no new results found at this radius and we already have some
-            if (radius > 0 && results.size() == results_before && !results.empty()) {
-                // Optional: could break here for aggressive early termination
-                // break;
-            }
-        }
-        
-        // Ordena por distancia
-        std::sort(results.begin(), results.end(), 
-                 [&query](const Image& a, const Image& b) {
-                     return query.distanceTo(a) < query.distanceTo(b);
-                 });
-        
-        // Limit results if requested
-        if (maxResults > 0 && static_cast<int>(results.size()) > maxResults) {
-            results.erase(results.begin() + maxResults, results.end());
-        }
-        
+        queryCounters.reset();
+        visitSimilar(query, threshold, [&results](const Image& img) {
+            results.push_back(img);
+            return true;
+        });
         return results;
     }
-    
-    std::string getName() const override {
-        return "Hash Search (Dynamic, cell=" + std::to_string(cellSize) + ")";
-    }
-    
-    // Public interface for dynamic search with configurable parameters
-    std::vector<Image> findSimilarWithLimit(const Image& query, double threshold, int maxResults) {
-        return findSimilarDynamic(query, threshold, maxResults);
-    }
-    
-    void clear() {
-        grid.clear();
-    }
-    
-    // Metodos para analise
-    size_t getNumCells() const {
-        return grid.size();
-    }
-    
-    double getAverageCellSize() const {
-        if (grid.empty()) return 0;
-        
-        size_t totalImages = 0;
-        for (const auto& pair : grid) {
-            totalImages += pair.second.size();
-        }
-        return static_cast<double>(totalImages) / grid.size();
-    }
-    
-    void printStats() const {
-        std::cout << "Hash Table Stats:" << std::endl;
-        std::cout << "  Celulas ativas: " << getNumCells() << std::endl;
-        std::cout << "  Tamanho medio da celula: " << getAverageCellSize() << " imagens" << std::endl;
-        std::cout << "  Cell size: " << cellSize << std::endl;
-        
-        // Distribuicao de tamanhos
-        std::vector<int> cellSizes;
-        for (const auto& pair : grid) {
-            cellSizes.push_back(pair.second.size());
-        }
-        if (!cellSizes.empty()) {
-            std::sort(cellSizes.begin(), cellSizes.end());
-            std::cout << "  Menor celula: " << cellSizes.front() << " imagens" << std::endl;
-            std::cout << "  Maior celula: " << cellSizes.back() << " imagens" << std::endl;
-            std::cout << "  Mediana: " << cellSizes[cellSizes.size()/2] << " imagens" << std::endl;
-        }
+
+    bool forEachSimilar(const Image& query, double threshold, const SimilarVisitor& visit) const override {
+        queryCounters.reset();
+        return visitSimilar(query, threshold, visit);
+    }
+
+    size_t size() const override { return totalImages; }
+
+    // Grade sobre [0, hi] (o referencial PCA passa de 255); so com a estrutura vazia
+    bool setDomain(double lo, double hi) override {
+        if (totalImages > 0 || lo != 0.0) return false;
+        geometry = GridGeometry(geometry.cellSize, hi);
+        occupancy = CellOccupancy(geometry.gridSize);
+        return true;
+    }
+    std::string getName() const override { return "Hash Search (" + formatParam("cell", geometry.cellSize, 1) + ")"; }
+
+    // O(n + m): imagens + m celulas ativas + tabela de buckets (+ bitmap de ocupacao)
+    MemoryUsage memoryUsage() const override {
+        MemoryUsage usage;
+        accountHashGrid(grid, usage);
+        occupancy.accountMemory(usage);
+        return usage;
+    }
+
+    // METRICA DE ANALISE: distribuicao de dados
+    size_t getNumCells() const { return grid.size(); }
+
+    void printAnalysis() const override {
+        std::cout << "  ANALISE SPATIAL HASHING:" << std::endl;
+        std::cout << "    Celulas ativas: " << getNumCells() << std::endl;
+        std::cout << "    Densidade media: " << averageCellOccupancy(grid, totalImages) << " imagens/celula" << std::endl;
+        std::cout << "    Tamanho da celula: " << geometry.cellSize << std::endl;
+        std::cout << "    Bitmap de ocupacao: " << occupancy.memoryBytes() / 1024.0 << " KB" << std::endl;
     }
 };
 
-#endif
\ No newline at end of file
+#endif
@@ -0,0 +1,260 @@
+#ifndef HYBRID_GRID_SEARCH_H
+#define HYBRID_GRID_SEARCH_H
+
+#include <algorithm>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "image.h"
+#include "hash_search.h"
+#include "octree_search.h"
+#include "prefetch.h"
+
+// ============================================================================
+// ESTRUTURA HIBRIDA: GRADE GROSSA + OCTREE LOCAL NAS CELULAS DENSAS
+// ============================================================================
+/*
+ANALISE PAA - DADOS ENVIESADOS:
+
+PROBLEMA:
+- Em dados reais (e em clusters) a grade fixa fica com poucas celulas
+  enormes e muitas minusculas: a consulta que cai numa celula densa testa
+  o bucket inteiro, mesmo com threshold pequeno
+- A octree pura poda bem nas regioes densas, mas paga a descida desde a
+  raiz (e as caixas dos niveis de cima) em todo lugar
+
+IDEIA:
+- Grade grossa densa (vector indexado, sem hash): cellSize padrao 32 (8^3)
+- Celula com ate refineThreshold imagens continua um array plano
+- Ao passar do limite a celula ganha uma octree LOCAL cuja raiz e a propria
+  celula (folhas de leafCapacity, mesmo OctreeNode da octree_search.h);
+  os pontos do array migram para ela e o array e liberado
+- Busca: celulas do cubo do threshold; celula cuja caixa esta fora do raio
+  e pulada; plana = varredura direta; refinada = DFS com poda dentro dela
+
+Resultado: regioes densas com poda de arvore (arvore rasa, comeca no nivel
+da celula), regioes esparsas com o custo de uma grade.
+*/
+
+class HybridGridSearch : public ImageDatabase {
+private:
+    static constexpr int kMaxDepth = 12;  // Dentro da celula (pontos repetidos)
+
+    struct CoarseCell {
+        std::vector<Image> flat;            // Celula plana
+        std::unique_ptr<OctreeNode> tree;   // Celula refinada (flat vazio)
+        size_t count = 0;
+    };
+
+    GridGeometry geometry;
+    int leafCapacity;
+    size_t refineThreshold;
+    std::vector<CoarseCell> cells;  // gridSize^3, indice (r, g, b)
+    size_t totalImages = 0;
+    size_t refinedCells = 0;
+    int maxDepth = 0;
+
+    size_t cellIndex(int cellR, int cellG, int cellB) const {
+        return ((size_t)cellR * geometry.gridSize + cellG) * geometry.gridSize + cellB;
+    }
+
+    // Caixa da celula; a ultima de cada eixo vai ate 255 (pontos da borda)
+    std::unique_ptr<OctreeNode> makeCellRoot(int cellR, int cellG, int cellB) const {
+        auto bound = [&](int cell, bool upper) {
+            if (upper) return cell == geometry.gridSize - 1 ? 255.0 : (cell + 1) * geometry.cellSize;
+            return cell * geometry.cellSize;
+        };
+        return std::make_unique<OctreeNode>(bound(cellR, false), bound(cellR, true), bound(cellG, false),
+                                            bound(cellG, true), bound(cellB, false), bound(cellB, true));
+    }
+
+    // Desce ate a folha ampliando as caixas ajustadas; se ela estourar, divide (so um filho pode continuar cheio)
+    void insertIntoTree(OctreeNode* node, const Image& img) {
+        int depth = 0;
+        node->include(img);
+        while (!node->isLeaf) {
+            node = node->children[node->getChildIndex(img)].get();
+            node->include(img);
+            depth++;
+        }
+        node->images.push_back(img);
+        while ((int)node->images.size() > leafCapacity && depth < kMaxDepth) {
+            node->createChildren();
+            for (const auto& existing : node->images) {
+                OctreeNode* child = node->children[node->getChildIndex(existing)].get();
+                child->images.push_back(existing);
+                child->include(existing);
+            }
+            node->images.clear();
+            node->images.shrink_to_fit();
+            OctreeNode* fullest = nullptr;
+            for (const auto& child : node->children) {
+                if (!fullest || child->images.size() > fullest->images.size()) fullest = child.get();
+            }
+            node = fullest;
+            depth++;
+        }
+        maxDepth = std::max(maxDepth, depth);
+    }
+
+    void refine(CoarseCell& cell, int cellR, int cellG, int cellB) {
+        cell.tree = makeCellRoot(cellR, cellG, cellB);
+        for (const auto& img : cell.flat) insertIntoTree(cell.tree.get(), img);
+        std::vector<Image>().swap(cell.flat);
+        refinedCells++;
+    }
+
+    template <typename Scan>
+    bool searchTree(const OctreeNode* root, const Image& query, double threshold, PrefetchPipeline<Image>& pipeline,
+                    Scan& scan) const {
+        const OctreeNode* stack[8 * kMaxDepth + 8];
+        int top = 0;
+        stack[top++] = root;
+        while (top > 0) {
+            const OctreeNode* node = stack[--top];
+            queryCounters.nodeVisited();
+            if (node->outsideRange(query, threshold)) {
+                queryCounters.nodePruned();
+                continue;
+            }
+            if (node->isLeaf) {
+                if (!node->images.empty() && !pipeline.push(node->images, scan)) return false;
+                continue;
+            }
+            if (stopRequested()) return false;
+            for (const auto& child : node->children) {
+                prefetchRead(child.get());
+                stack[top++] = child.get();
+            }
+        }
+        return true;
+    }
+
+    template <typename Visitor>
+    bool visitSimilar(const Image& query, double threshold, Visitor&& visit) const {
+        int minR = geometry.toCell(query.r - threshold), maxR = geometry.toCell(query.r + threshold);
+        int minG = geometry.toCell(query.g - threshold), maxG = geometry.toCell(query.g + threshold);
+        int minB = geometry.toCell(query.b - threshold), maxB = geometry.toCell(query.b + threshold);
+
+        auto scan = [&](const std::vector<Image>& images) {
+            for (const auto& img : images) {
+                queryCounters.pointTested();
+                if (query.distanceTo(img) <= threshold) {
+                    queryCounters.pointAccepted();
+                    if (!visit(img)) return false;
+                }
+            }
+            return true;
+        };
+
+        PrefetchPipeline<Image> pipeline;
+        for (int cellR = minR; cellR <= maxR; cellR++) {
+            for (int cellG = minG; cellG <= maxG; cellG++) {
+                for (int cellB = minB; cellB <= maxB; cellB++) {
+                    if (stopRequested()) return false;
+                    const CoarseCell& cell = cells[cellIndex(cellR, cellG, cellB)];
+                    queryCounters.cellProbed(cell.count > 0);
+                    if (cell.count == 0) continue;
+                    if (cell.tree) {
+                        if (!searchTree(cell.tree.get(), query, threshold, pipeline, scan)) return false;
+                    } else if (!pipeline.push(cell.flat, scan)) {
+                        return false;
+                    }
+                }
+            }
+        }
+        return pipeline.flush(scan);
+    }
+
+    void countTree(const OctreeNode* node, size_t& leaves, size_t& internal) const {
+        if (node->isLeaf) {
+            leaves++;
+            return;
+        }
+        internal++;
+        for (const auto& child : node->children) countTree(child.get(), leaves, internal);
+    }
+
+public:
+    static constexpr double DEFAULT_CELL_SIZE = 32.0;            // grade grossa 8^3
+    static constexpr int DEFAULT_LEAF_CAPACITY = 20;
+    static constexpr size_t DEFAULT_REFINE_THRESHOLD = 512;      // imagens antes de virar octree
+
+    HybridGridSearch(double cellSize = DEFAULT_CELL_SIZE, int _leafCapacity = DEFAULT_LEAF_CAPACITY,
+                     size_t _refineThreshold = DEFAULT_REFINE_THRESHOLD)
+        : geometry(cellSize), leafCapacity(std::max(1, _leafCapacity)),
+          refineThreshold(std::max<size_t>(_refineThreshold, _leafCapacity)),
+          cells((size_t)geometry.gridSize * geometry.gridSize * geometry.gridSize) {}
+
+    void insert(const Image& img) override {
+        int cellR = geometry.toCell(img.r), cellG = geometry.toCell(img.g), cellB = geometry.toCell(img.b);
+        CoarseCell& cell = cells[cellIndex(cellR, cellG, cellB)];
+        cell.count++;
+        totalImages++;
+        if (cell.tree) {
+            insertIntoTree(cell.tree.get(), img);
+            return;
+        }
+        cell.flat.push_back(img);
+        if (cell.flat.size() > refineThreshold) refine(cell, cellR, cellG, cellB);
+    }
+
+    std::vector<Image> findSimilar(const Image& query, double threshold) const override {
+        std::vector<Image> results;
+        queryCounters.reset();
+        visitSimilar(query, threshold, [&results](const Image& img) {
+            results.push_back(img);
+            return true;
+        });
+        return results;
+    }
+
+    bool forEachSimilar(const Image& query, double threshold, const SimilarVisitor& visit) const override {
+        queryCounters.reset();
+        return visitSimilar(query, threshold, visit);
+    }
+
+    size_t size() const override { return totalImages; }
+
+    std::string getName() const override {
+        return "Hybrid Grid (" + formatParam("cell", geometry.cellSize, 1) + ", " +
+               formatParam("leaf", leafCapacity, 0) + ", " + formatParam("refine", (double)refineThreshold, 0) + ")";
+    }
+
+    MemoryUsage memoryUsage() const override {
+        MemoryUsage usage;
+        usage.bucketBytes += cells.capacity() * sizeof(CoarseCell);
+        usage.overheadBytes += mallocOverheadBytes(cells.capacity() * sizeof(CoarseCell));
+        for (const auto& cell : cells) {
+            accountImageVector(cell.flat, usage);
+            accountTree(cell.tree.get(), usage);
+        }
+        return usage;
+    }
+
+    void printAnalysis() const override {
+        size_t occupied = 0, flatImages = 0, largestFlat = 0, leaves = 0, internal = 0;
+        for (const auto& cell : cells) {
+            if (cell.count == 0) continue;
+            occupied++;
+            if (cell.tree) {
+                countTree(cell.tree.get(), leaves, internal);
+            } else {
+                flatImages += cell.flat.size();
+                largestFlat = std::max(largestFlat, cell.flat.size());
+            }
+        }
+        std::cout << "  ANALISE GRADE HIBRIDA:" << std::endl;
+        std::cout << "    Celulas ocupadas: " << occupied << " de " << cells.size() << " (tamanho "
+                  << geometry.cellSize << ")" << std::endl;
+        std::cout << "    Celulas planas: " << occupied - refinedCells << " com " << flatImages
+                  << " imagens (maior: " << largestFlat << ")" << std::endl;
+        std::cout << "    Celulas com octree: " << refinedCells << " com " << totalImages - flatImages
+                  << " imagens | folhas: " << leaves << " | internos: " << internal
+                  << " | profundidade maxima: " << maxDepth << std::endl;
+    }
+};
+
+#endif
@@ -0,0 +1,224 @@
+#ifndef IMAGE_H
+#define IMAGE_H
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <functional>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "memory_usage.h"
+#include "query_stats.h"
+
+// ============================================================================
+// REPRESENTACAO DE DADOS - ESPACO RGB COMO PROBLEMA MULTIDIMENSIONAL
+// ============================================================================
+
+struct Image {
+    int id;
+    std::string filename;
+    double r, g, b;  // Coordenadas no espaco RGB (0-255)
+
+    Image(int _id, const std::string& _filename, double _r, double _g, double _b)
+        : id(_id), filename(_filename), r(_r), g(_g), b(_b) {}
+
+    // METRICA DE SIMILARIDADE: Distancia Euclidiana no Espaco 3D
+    /*
+    ANALISE PAA:
+    - Funcao de distancia define a metrica de similaridade
+    - Espaco RGB = R³ (3 dimensoes)
+    - Distancia euclidiana e metrica padrao para espacos continuos
+    - Complexidade: O(1) para calcular distancia entre 2 pontos
+    */
+    double distanceTo(const Image& other) const {
+        double dr = r - other.r;
+        double dg = g - other.g;
+        double db = b - other.b;
+        return std::sqrt(dr*dr + dg*dg + db*db);
+    }
+
+    void print() const {
+        std::cout << "Image " << id << " (" << filename << "): "
+                  << "RGB(" << r << ", " << g << ", " << b << ")" << std::endl;
+    }
+};
+
+// ============================================================================
+// INTERFACE ABSTRATA - PADRAO DE DESIGN PARA COMPARACAO JUSTA
+// ============================================================================
+/*
+Todas as estruturas (main.cpp e benchmarks/) usam as implementacoes destes
+headers: uma otimizacao feita aqui aparece em todos os drivers.
+
+findSimilar devolve os resultados em ordem nao especificada (cada estrutura
+percorre o espaco de um jeito); quem precisa de nearest-first chama
+sortByDistance, pagando O(k log k) apenas quando necessario.
+*/
+
+// ============================================================================
+// INTERRUPCAO COOPERATIVA (CANCELAMENTO E PRAZO) - ver async_query.h
+// ============================================================================
+/*
+As buscas testam o controle ativo da thread uma vez por celula, folha ou
+bloco de pontos; ao ver o pedido de parada elas param a travessia e
+devolvem o que ja acharam (resultado PARCIAL, sempre subconjunto do exato).
+Sem controle ativo o teste e uma comparacao de ponteiro.
+*/
+class QueryControl {
+public:
+    using Clock = std::chrono::steady_clock;
+
+private:
+    std::atomic<bool> cancelled{false};
+    std::atomic<bool> stopped{false};  // Alguma busca parou por este controle
+    Clock::time_point deadline = Clock::time_point::max();
+    // Testes ate a proxima leitura do relogio; do controle (nao da thread): cada consulta
+    // comeca lendo o relogio, e um prazo ja vencido para na primeira verificacao
+    std::atomic<int> clockCountdown{1};
+
+public:
+    static constexpr int CLOCK_CHECK_INTERVAL = 8;  // Relogio lido a cada N testes (somando as threads)
+
+    QueryControl() = default;
+    explicit QueryControl(Clock::time_point _deadline) : deadline(_deadline) {}
+
+    // Pode ser chamado de qualquer thread
+    void cancel() { cancelled.store(true, std::memory_order_relaxed); }
+    bool cancelRequested() const { return cancelled.load(std::memory_order_relaxed); }
+    bool deadlineExpired() const { return Clock::now() >= deadline; }
+
+    // Chamado pelas threads que executam a busca (varias, numa busca paralela)
+    bool shouldStop() {
+        if (stopped.load(std::memory_order_relaxed)) return true;
+        bool stop = cancelled.load(std::memory_order_relaxed);
+        // Corrida entre threads no reinicio so causa uma leitura de relogio a mais
+        if (!stop && clockCountdown.fetch_sub(1, std::memory_order_relaxed) <= 1) {
+            clockCountdown.store(CLOCK_CHECK_INTERVAL, std::memory_order_relaxed);
+            stop = Clock::now() >= deadline;
+        }
+        if (stop) stopped.store(true, std::memory_order_relaxed);
+        return stop;
+    }
+    bool interrupted() const { return stopped.load(std::memory_order_relaxed); }
+};
+
+// Visitante de forEachSimilar: recebe cada imagem aceita; retornar false
+// interrompe a busca (sem montar o vector de resultados)
+using SimilarVisitor = std::function<bool(const Image&)>;
+
+class ImageDatabase {
+public:
+    virtual ~ImageDatabase() = default;
+
+    // Operacoes fundamentais para analise de complexidade
+    virtual void insert(const Image& img) = 0;
+    virtual std::vector<Image> findSimilar(const Image& query, double threshold) const = 0;
+    virtual size_t size() const = 0;
+    virtual std::string getName() const = 0;
+
+    // Analise de espaco: nos, buckets, payload e overhead do allocator
+    virtual MemoryUsage memoryUsage() const = 0;
+
+    // Analise estrutural (celulas, profundidade, nos...); vazia por padrao
+    virtual void printAnalysis() const {}
+
+    // Dominio das coordenadas ([lo, hi] em cada eixo), antes da primeira insercao. Padrao
+    // [0,255] fixo (false); arvores ajustam a raiz e hash/hashdyn a grade (PcaFrameIndex)
+    virtual bool setDomain(double lo, double hi) {
+        (void)lo;
+        (void)hi;
+        return false;
+    }
+
+    // Conclui a construcao adiada (ordem Morton, quantis, ajuste PCA) que a primeira consulta
+    // faria sozinha. O benchmark chama dentro do cronometro de insercao: sem isso o custo nao
+    // entra em Insert(ms) nem em Search(ms) (memoryUsage dispara a construcao entre os dois)
+    virtual void finishBuild() const {}
+
+    // Streaming: visit(img) para cada resultado, na ordem da travessia; retorna false se
+    // a busca parou antes do fim (visitante ou QueryControl). Padrao: via findSimilar
+    virtual bool forEachSimilar(const Image& query, double threshold, const SimilarVisitor& visit) const;
+
+    // k vizinhos mais proximos, nearest-first (padrao: raios crescentes, ver abaixo)
+    virtual std::vector<Image> findKNearest(const Image& query, size_t k) const;
+
+    // Trabalho realizado pela ultima busca DESTA thread (tudo zero sem -DPAA_QUERY_STATS)
+    const QueryStats& lastQueryStats() const { return queryCounters.stats(); }
+
+    // Instala um QueryControl nesta thread durante o escopo (buscas aninhadas e
+    // tarefas do pool que repassam o controle param juntas)
+    class ScopedQueryControl {
+    private:
+        QueryControl* previous;
+
+    public:
+        explicit ScopedQueryControl(QueryControl* control) : previous(activeControl) { activeControl = control; }
+        ~ScopedQueryControl() { activeControl = previous; }
+        ScopedQueryControl(const ScopedQueryControl&) = delete;
+        ScopedQueryControl& operator=(const ScopedQueryControl&) = delete;
+    };
+
+    static QueryControl* currentQueryControl() { return activeControl; }
+
+protected:
+    // thread_local: findSimilar e const e reentrante, varias threads podem consultar
+    // a mesma estrutura ao mesmo tempo sem disputar (nem corromper) os contadores
+    static inline thread_local QueryCounters queryCounters;
+    static inline thread_local QueryControl* activeControl = nullptr;
+
+    // Ponto de parada das buscas (por celula/folha/bloco de STOP_CHECK_POINTS pontos)
+    static constexpr size_t STOP_CHECK_POINTS = 1024;
+    static bool stopRequested() { return activeControl && activeControl->shouldStop(); }
+    static bool queryInterrupted() { return activeControl && activeControl->interrupted(); }
+};
+
+// Ordena resultados do mais similar para o menos similar
+inline void sortByDistance(std::vector<Image>& results, const Image& query) {
+    std::sort(results.begin(), results.end(),
+              [&query](const Image& a, const Image& b) {
+                  return query.distanceTo(a) < query.distanceTo(b);
+              });
+}
+
+// Distancia maxima entre duas cores em [0,255]^3
+constexpr double kMaxRGBDistance = 441.6729559300637;  // 255 * sqrt(3)
+
+inline bool ImageDatabase::forEachSimilar(const Image& query, double threshold,
+                                          const SimilarVisitor& visit) const {
+    for (const auto& img : findSimilar(query, threshold)) {
+        if (!visit(img)) return false;
+    }
+    return !queryInterrupted();
+}
+
+// kNN padrao sobre qualquer estrutura (so ha busca por raio): dobra o raio
+// ate achar k resultados e ordena. Exato: os k mais proximos estao todos
+// dentro do primeiro raio que contem k pontos. Volume x8 a cada passo, entao
+// as buscas anteriores custam ~1/7 da ultima
+constexpr double kKnnInitialRadius = 8.0;
+
+inline std::vector<Image> ImageDatabase::findKNearest(const Image& query, size_t k) const {
+    std::vector<Image> results;
+    if (k == 0) return results;
+    for (double radius = kKnnInitialRadius;; radius *= 2) {
+        results = findSimilar(query, std::min(radius, kMaxRGBDistance));
+        // Interrompida: os k mais proximos entre os encontrados (parcial)
+        if (results.size() >= k || radius >= kMaxRGBDistance || queryInterrupted()) break;
+    }
+    sortByDistance(results, query);
+    if (results.size() > k) results.erase(results.begin() + k, results.end());
+    return results;
+}
+
+// Formata parametros de ajuste no nome da estrutura ("cell=25.0", "leaf=20")
+inline std::string formatParam(const char* name, double value, int decimals) {
+    char buffer[48];
+    snprintf(buffer, sizeof(buffer), "%s=%.*f", name, decimals, value);
+    return buffer;
+}
+
+#endif
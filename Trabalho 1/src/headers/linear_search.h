@@ -1,44 +1,87 @@
 #ifndef LINEAR_SEARCH_H
 #define LINEAR_SEARCH_H
 
-#include "main.cpp"
+#include <string>
+#include <vector>
+
+#include "image.h"
+
+// ============================================================================
+// ESTRUTURA 1: BUSCA LINEAR (BASELINE)
+// ============================================================================
+/*
+ANALISE PAA - BUSCA LINEAR:
+
+CARACTERISTICAS:
+- Estrutura mais simples possivel
+- Nao ha pre-processamento dos dados
+- Serve como baseline para comparacao
+
+COMPLEXIDADES:
+- Insercao: O(1) - apenas adiciona ao final
+- Busca: O(n) - deve verificar todos os elementos
+- Espaco: O(n) - armazena apenas os dados
+
+TRADE-OFFS:
+- Vantagem: Implementacao trivial, sem overhead
+- Desvantagem: Busca lenta para grandes datasets
+
+QUANDO USAR:
+- Datasets pequenos (n < 1000)
+- Quando implementacao simples e prioridade
+- Como baseline para avaliar outras estruturas
+*/
 
 class LinearSearch : public ImageDatabase {
 private:
-    std::vector<Image> images;
-    
+    std::vector<Image> images;  // Array dinamico simples
+
+    // Travessia comum a findSimilar e forEachSimilar; false = interrompida
+    template <typename Visitor>
+    bool visitSimilar(const Image& query, double threshold, Visitor&& visit) const {
+        // O(n) - FORCA BRUTA: examina todos os elementos
+        for (size_t i = 0; i < images.size(); i++) {
+            if (i % STOP_CHECK_POINTS == 0 && stopRequested()) return false;
+            const Image& img = images[i];
+            queryCounters.pointTested();
+            if (query.distanceTo(img) <= threshold) {
+                queryCounters.pointAccepted();
+                if (!visit(img)) return false;
+            }
+        }
+        return true;
+    }
+
 public:
     void insert(const Image& img) override {
+        // O(1) - insercao no final do array
         images.push_back(img);
     }
-    
-    std::vector<Image> findSimilar(const Image& query, double threshold) override {
+
+    std::vector<Image> findSimilar(const Image& query, double threshold) const override {
         std::vector<Image> results;
-        
-        // Busca linear - O(n)
-        for (const auto& img : images) {
-            double distance = query.distanceTo(img);
-            if (distance <= threshold) {
-                results.push_back(img);
-            }
-        }
-        
-        // Ordena por distancia (mais similares primeiro)
-        std::sort(results.begin(), results.end(), 
-                 [&query](const Image& a, const Image& b) {
-                     return query.distanceTo(a) < query.distanceTo(b);
-                 });
-        
+        queryCounters.reset();
+        visitSimilar(query, threshold, [&results](const Image& img) {
+            results.push_back(img);
+            return true;
+        });
         return results;
     }
-    
-    std::string getName() const override {
-        return "Linear Search";
+
+    bool forEachSimilar(const Image& query, double threshold, const SimilarVisitor& visit) const override {
+        queryCounters.reset();
+        return visitSimilar(query, threshold, visit);
     }
-    
-    size_t size() const {
-        return images.size();
+
+    size_t size() const override { return images.size(); }
+    std::string getName() const override { return "Linear Search"; }
+
+    // O(n) de espaco: apenas o array de imagens
+    MemoryUsage memoryUsage() const override {
+        MemoryUsage usage;
+        accountImageVector(images, usage);
+        return usage;
     }
 };
 
-#endif
\ No newline at end of file
+#endif
@@ -0,0 +1,181 @@
+#ifndef MEMORY_USAGE_H
+#define MEMORY_USAGE_H
+
+#include <cstddef>
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <type_traits>
+#include <vector>
+#include <sys/resource.h>
+
+/**
+ * @brief Decomposicao do consumo de memoria de uma estrutura de indexacao
+ *
+ * Os valores sao estimados percorrendo a estrutura (nao dependem do allocator):
+ * - nodeBytes: nos da arvore ou entradas da hash table (inclui as chaves)
+ * - bucketBytes: tabela de buckets do unordered_map
+ * - payloadBytes: imagens armazenadas (sizeof(Image) + filename no heap)
+ * - overheadBytes: cabecalhos do malloc + capacidade ociosa dos vectors
+ */
+struct MemoryUsage {
+    size_t nodeBytes = 0;
+    size_t bucketBytes = 0;
+    size_t payloadBytes = 0;
+    size_t overheadBytes = 0;
+
+    size_t total() const {
+        return nodeBytes + bucketBytes + payloadBytes + overheadBytes;
+    }
+
+    double bytesPerImage(size_t imageCount) const {
+        return imageCount > 0 ? static_cast<double>(total()) / imageCount : 0.0;
+    }
+
+    MemoryUsage& operator+=(const MemoryUsage& other) {
+        nodeBytes += other.nodeBytes;
+        bucketBytes += other.bucketBytes;
+        payloadBytes += other.payloadBytes;
+        overheadBytes += other.overheadBytes;
+        return *this;
+    }
+
+    void print(size_t imageCount) const {
+        printf("    Memoria: nos=%.2fMB buckets=%.2fMB payload=%.2fMB overhead=%.2fMB total=%.2fMB (%.1f bytes/imagem)\n",
+               nodeBytes / 1048576.0, bucketBytes / 1048576.0, payloadBytes / 1048576.0,
+               overheadBytes / 1048576.0, total() / 1048576.0, bytesPerImage(imageCount));
+    }
+};
+
+// ============================================================================
+// ESTIMATIVA DE OVERHEAD DO ALLOCATOR
+// ============================================================================
+
+// glibc malloc: 8 bytes de cabecalho por bloco, arredondado para 16 (minimo 32)
+inline size_t mallocOverheadBytes(size_t requested) {
+    if (requested == 0) return 0;
+    size_t chunk = (requested + 8 + 15) & ~static_cast<size_t>(15);
+    if (chunk < 32) chunk = 32;
+    return chunk - requested;
+}
+
+// Bytes no heap de uma std::string (0 quando cabe no buffer SSO interno)
+inline size_t stringHeapBytes(const std::string& s) {
+    const char* data = s.data();
+    const char* self = reinterpret_cast<const char*>(&s);
+    if (data >= self && data < self + sizeof(std::string)) return 0;
+    return s.capacity() + 1;
+}
+
+// Contabiliza um vector<Image>: elementos como payload, sobra e malloc como overhead
+template <typename Img>
+void accountImageVector(const std::vector<Img>& images, MemoryUsage& usage) {
+    usage.payloadBytes += images.size() * sizeof(Img);
+    for (const auto& img : images) {
+        size_t heap = stringHeapBytes(img.filename);
+        usage.payloadBytes += heap;
+        usage.overheadBytes += mallocOverheadBytes(heap);
+    }
+    if (images.capacity() > 0) {
+        usage.overheadBytes += (images.capacity() - images.size()) * sizeof(Img);
+        usage.overheadBytes += mallocOverheadBytes(images.capacity() * sizeof(Img));
+    }
+}
+
+// Contabiliza um no de arvore alocado individualmente (unique_ptr)
+template <typename Node>
+void accountTreeNode(const Node& node, MemoryUsage& usage) {
+    usage.nodeBytes += sizeof(Node);
+    usage.overheadBytes += mallocOverheadBytes(sizeof(Node));
+    accountImageVector(node.images, usage);
+}
+
+// Percorre uma arvore (Octree/Quadtree) contabilizando todos os nos
+template <typename Node>
+void accountTree(const Node* node, MemoryUsage& usage) {
+    if (!node) return;
+    accountTreeNode(*node, usage);
+    for (const auto& child : node->children) {
+        accountTree(child.get(), usage);
+    }
+}
+
+// Contabiliza um unordered_map<Key, vector<Image>> (modelo de nos do libstdc++)
+template <typename Map>
+void accountHashGrid(const Map& grid, MemoryUsage& usage) {
+    using Key = typename Map::key_type;
+    // libstdc++ guarda o hash no no quando a chave nao e integral
+    constexpr size_t cachedHash = std::is_integral<Key>::value ? 0 : sizeof(size_t);
+    constexpr size_t entryBytes = sizeof(void*) + sizeof(typename Map::value_type) + cachedHash;
+
+    size_t bucketArray = grid.bucket_count() * sizeof(void*);
+    usage.bucketBytes += bucketArray;
+    usage.overheadBytes += mallocOverheadBytes(bucketArray);
+
+    for (const auto& cell : grid) {
+        usage.nodeBytes += entryBytes;
+        usage.overheadBytes += mallocOverheadBytes(entryBytes);
+        if constexpr (std::is_same<Key, std::string>::value) {
+            size_t keyHeap = stringHeapBytes(cell.first);
+            usage.nodeBytes += keyHeap;
+            usage.overheadBytes += mallocOverheadBytes(keyHeap);
+        }
+        accountImageVector(cell.second, usage);
+    }
+}
+
+// ============================================================================
+// AMOSTRAGEM DE RSS DO PROCESSO
+// ============================================================================
+
+// Le um campo em kB de /proc/self/status (VmRSS, VmHWM); 0 se indisponivel
+inline size_t readProcStatusBytes(const std::string& field) {
+    std::ifstream status("/proc/self/status");
+    std::string line;
+    while (std::getline(status, line)) {
+        if (line.compare(0, field.size(), field) == 0 && line.size() > field.size() &&
+            line[field.size()] == ':') {
+            return std::stoull(line.substr(field.size() + 1)) * 1024;
+        }
+    }
+    return 0;
+}
+
+inline size_t currentRSSBytes() { return readProcStatusBytes("VmRSS"); }
+inline size_t peakRSSBytes() { return readProcStatusBytes("VmHWM"); }
+
+// getrusage: pico do processo inteiro (ru_maxrss em kB no Linux, nao pode ser zerado)
+inline size_t rusageMaxRSSBytes() {
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) != 0) return 0;
+    return static_cast<size_t>(usage.ru_maxrss) * 1024;
+}
+
+// Zera o VmHWM (Linux >= 4.0) para medir o pico de cada estrutura isoladamente
+inline bool resetPeakRSS() {
+    std::ofstream clearRefs("/proc/self/clear_refs");
+    if (!clearRefs) return false;
+    clearRefs << "5";
+    return static_cast<bool>(clearRefs);
+}
+
+struct RSSSample {
+    size_t current = 0;
+    size_t peak = 0;
+    size_t rusagePeak = 0;
+};
+
+inline RSSSample sampleRSS() {
+    RSSSample sample;
+    sample.current = currentRSSBytes();
+    sample.peak = peakRSSBytes();
+    sample.rusagePeak = rusageMaxRSSBytes();
+    return sample;
+}
+
+// Diferenca nao-negativa entre duas amostras (RSS pode diminuir apos free)
+inline size_t bytesAbove(size_t value, size_t base) {
+    return value > base ? value - base : 0;
+}
+
+#endif
@@ -0,0 +1,129 @@
+#ifndef PARALLEL_LINEAR_SEARCH_H
+#define PARALLEL_LINEAR_SEARCH_H
+
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "image.h"
+#include "thread_pool.h"
+
+// ============================================================================
+// ESTRUTURA 1b: BUSCA LINEAR PARALELA (DATA-PARALLEL)
+// ============================================================================
+/*
+ANALISE PAA - BUSCA LINEAR PARALELA:
+
+CONCEITO:
+- Mesmo array e mesma forca bruta da LinearSearch
+- O array e dividido em blocos contiguos; cada bloco e varrido por uma
+  thread do pool persistente (thread_pool.h) com seu proprio vetor de
+  resultados (sem lock nem false sharing no push_back)
+- No fim os vetores sao concatenados na ordem dos blocos: o resultado sai
+  na MESMA ordem da LinearSearch
+
+ESCOLHA DO NUMERO DE BLOCOS:
+- Abaixo de 2 × MIN_CHUNK_POINTS a busca roda direto na chamadora (despachar
+  tarefas custaria mais do que varrer)
+- Acima: n / MIN_CHUNK_POINTS blocos, limitado a CHUNKS_PER_THREAD blocos por
+  thread do pool (blocos a mais equilibram threads lentas ou ocupadas)
+
+COMPLEXIDADES:
+- Insercao: O(1)
+- Busca: O(n / p + blocos) com p threads; continua limitada pela banda de
+  memoria (cada ponto e lido uma vez)
+- Espaco: O(n)
+*/
+
+class ParallelLinearSearch : public ImageDatabase {
+private:
+    std::vector<Image> images;
+    std::shared_ptr<ThreadPool> pool;
+
+    void scanRange(size_t first, size_t last, const Image& query, double threshold,
+                   std::vector<Image>& results, QueryCounters& counters) const {
+        for (size_t i = first; i < last; i++) {
+            if ((i - first) % STOP_CHECK_POINTS == 0 && stopRequested()) break;
+            counters.pointTested();
+            if (query.distanceTo(images[i]) <= threshold) {
+                counters.pointAccepted();
+                results.push_back(images[i]);
+            }
+        }
+    }
+
+public:
+    static constexpr size_t MIN_CHUNK_POINTS = 16384;  // ~1MB de Image por bloco
+    static constexpr int CHUNKS_PER_THREAD = 4;
+
+    explicit ParallelLinearSearch(std::shared_ptr<ThreadPool> _pool = ThreadPool::shared())
+        : pool(std::move(_pool)) {}
+
+    void insert(const Image& img) override { images.push_back(img); }
+
+    size_t chunkCount() const {
+        if (images.size() < 2 * MIN_CHUNK_POINTS) return 1;
+        return std::min(images.size() / MIN_CHUNK_POINTS, (size_t)pool->concurrency() * CHUNKS_PER_THREAD);
+    }
+
+    std::vector<Image> findSimilar(const Image& query, double threshold) const override {
+        queryCounters.reset();
+        size_t chunks = chunkCount();
+
+        if (chunks == 1) {
+            std::vector<Image> results;
+            scanRange(0, images.size(), query, threshold, results, queryCounters);
+            return results;
+        }
+
+        // Resultados e contadores por bloco: cada tarefa escreve apenas no seu
+        std::vector<std::vector<Image>> partial(chunks);
+        std::vector<QueryCounters> partialCounters(chunks);
+        QueryControl* control = currentQueryControl();
+        pool->parallelFor(chunks, [&](size_t c) {
+            ScopedQueryControl scope(control);
+            size_t first = images.size() * c / chunks;
+            size_t last = images.size() * (c + 1) / chunks;
+            scanRange(first, last, query, threshold, partial[c], partialCounters[c]);
+        });
+
+        size_t total = 0;
+        for (const auto& part : partial) total += part.size();
+        std::vector<Image> results;
+        results.reserve(total);
+        for (size_t c = 0; c < chunks; c++) {
+            results.insert(results.end(), std::make_move_iterator(partial[c].begin()),
+                           std::make_move_iterator(partial[c].end()));
+            queryCounters.merge(partialCounters[c].stats());
+        }
+        return results;
+    }
+
+    // Visitante sequencial (ordem do array), na thread chamadora
+    bool forEachSimilar(const Image& query, double threshold, const SimilarVisitor& visit) const override {
+        queryCounters.reset();
+        for (size_t i = 0; i < images.size(); i++) {
+            if (i % STOP_CHECK_POINTS == 0 && stopRequested()) return false;
+            queryCounters.pointTested();
+            if (query.distanceTo(images[i]) <= threshold) {
+                queryCounters.pointAccepted();
+                if (!visit(images[i])) return false;
+            }
+        }
+        return true;
+    }
+
+    size_t size() const override { return images.size(); }
+    std::string getName() const override {
+        return "Linear Paralelo (" + formatParam("threads", pool->concurrency(), 0) + ")";
+    }
+
+    MemoryUsage memoryUsage() const override {
+        MemoryUsage usage;
+        accountImageVector(images, usage);
+        return usage;
+    }
+};
+
+#endif
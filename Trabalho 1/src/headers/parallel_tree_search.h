@@ -0,0 +1,171 @@
+#ifndef PARALLEL_TREE_SEARCH_H
+#define PARALLEL_TREE_SEARCH_H
+
+#include <memory>
+#include <stack>
+#include <string>
+#include <vector>
+
+#include "octree_search.h"
+#include "quadtree.h"
+#include "spatial_tree.h"
+#include "thread_pool.h"
+
+// ============================================================================
+// BUSCA EM ARVORE COM PARALELISMO DENTRO DA CONSULTA
+// ============================================================================
+/*
+ANALISE PAA - TRAVESSIA PARALELA:
+
+PROBLEMA:
+- Uma consulta com threshold grande sobre dezenas de milhoes de pontos
+  visita milhares de folhas em serie, num unico nucleo, mesmo com o resto
+  da maquina ociosa
+
+TECNICA:
+1. Fronteira: a thread chamadora expande a arvore por niveis (BFS, com a
+   mesma poda) ate ter SUBTREES_PER_THREAD subarvores sobreviventes por
+   thread do pool, ou ate so restarem folhas
+2. Cada subarvore da fronteira vira uma tarefa independente: DFS com pilha
+   explicita, resultados e contadores proprios (sem lock)
+3. As tarefas vao para o pool com roubo de tarefas (thread_pool.h): subarvores
+   densas e esparsas se equilibram sozinhas entre as threads
+4. Os resultados por tarefa sao concatenados na ordem da fronteira
+
+QUANDO COMPENSA:
+- Consultas pesadas (muitas folhas sobrevivem a poda) com nucleos livres
+- Com fronteira de 1 subarvore (ou pool de 1 thread) a busca e a iterativa
+  normal, sem custo extra de despacho
+- Sob carga de muitas consultas concorrentes, paralelizar cada uma so
+  acrescenta overhead: use a variante iterativa
+
+Insercao, memoria e analise sao as da arvore iterativa (spatial_tree.h).
+*/
+
+template <typename Node>
+class ParallelTreeSearch : public SpatialTreeSearch<Node, true> {
+private:
+    using Base = SpatialTreeSearch<Node, true>;
+    using ImageDatabase::queryCounters;
+
+    std::shared_ptr<ThreadPool> pool;
+
+    // DFS de uma subarvore cuja raiz ja passou pela poda
+    void searchSubtree(const Node* subtree, const Image& query, double threshold,
+                       std::vector<Image>& results, QueryCounters& counters) const {
+        auto collect = [&results](const Image& img) {
+            results.push_back(img);
+            return true;
+        };
+        std::stack<const Node*> stack;
+        stack.push(subtree);
+        bool rootChecked = true;
+
+        while (!stack.empty() && !this->stopRequested()) {
+            const Node* node = stack.top();
+            stack.pop();
+
+            if (!rootChecked) {
+                counters.nodeVisited();
+                if (node->outsideRange(query, threshold)) {
+                    counters.nodePruned();
+                    continue;
+                }
+            }
+            rootChecked = false;
+
+            if (node->isLeaf) {
+                this->scanLeaf(node, query, threshold, counters, collect);
+            } else {
+                for (const auto& child : node->children) {
+                    if (child) stack.push(child.get());
+                }
+            }
+        }
+    }
+
+    // Expansao por niveis: nos ja testados (nao podados), folhas e internos
+    std::vector<const Node*> buildFrontier(const Image& query, double threshold) const {
+        std::vector<const Node*> frontier;
+        queryCounters.nodeVisited();
+        if (this->root->outsideRange(query, threshold)) {
+            queryCounters.nodePruned();
+            return frontier;
+        }
+        frontier.push_back(this->root.get());
+
+        size_t target = (size_t)pool->concurrency() * SUBTREES_PER_THREAD;
+        bool expandable = true;
+        while (frontier.size() < target && expandable) {
+            expandable = false;
+            std::vector<const Node*> next;
+            for (const Node* node : frontier) {
+                if (node->isLeaf) {
+                    next.push_back(node);
+                    continue;
+                }
+                for (const auto& child : node->children) {
+                    if (!child) continue;
+                    queryCounters.nodeVisited();
+                    if (child->outsideRange(query, threshold)) {
+                        queryCounters.nodePruned();
+                        continue;
+                    }
+                    expandable = expandable || !child->isLeaf;
+                    next.push_back(child.get());
+                }
+            }
+            frontier.swap(next);
+        }
+        return frontier;
+    }
+
+public:
+    static constexpr int SUBTREES_PER_THREAD = 8;  // Folga para o roubo de tarefas equilibrar
+
+    explicit ParallelTreeSearch(int leafCapacity = Base::DEFAULT_LEAF_CAPACITY,
+                                std::shared_ptr<ThreadPool> _pool = ThreadPool::shared())
+        : Base(leafCapacity), pool(std::move(_pool)) {}
+
+    std::vector<Image> findSimilar(const Image& query, double threshold) const override {
+        if (pool->concurrency() == 1) return Base::findSimilar(query, threshold);
+
+        queryCounters.reset();
+        std::vector<const Node*> frontier = buildFrontier(query, threshold);
+
+        std::vector<Image> results;
+        if (frontier.size() <= 1) {
+            for (const Node* subtree : frontier) searchSubtree(subtree, query, threshold, results, queryCounters);
+            return results;
+        }
+
+        std::vector<std::vector<Image>> partial(frontier.size());
+        std::vector<QueryCounters> partialCounters(frontier.size());
+        // Cancelamento/prazo da chamadora valem tambem nas tarefas
+        QueryControl* control = this->currentQueryControl();
+        pool->parallelFor(frontier.size(), [&](size_t t) {
+            ImageDatabase::ScopedQueryControl scope(control);
+            searchSubtree(frontier[t], query, threshold, partial[t], partialCounters[t]);
+        });
+
+        size_t total = 0;
+        for (const auto& part : partial) total += part.size();
+        results.reserve(total);
+        for (size_t t = 0; t < frontier.size(); t++) {
+            results.insert(results.end(), std::make_move_iterator(partial[t].begin()),
+                           std::make_move_iterator(partial[t].end()));
+            queryCounters.merge(partialCounters[t].stats());
+        }
+        return results;
+    }
+
+    std::string getName() const override {
+        return std::string(Node::kName) + " Paralelo (" + formatParam("leaf", this->maxImagesPerNode, 0) + ", " +
+               formatParam("threads", pool->concurrency(), 0) + ")";
+    }
+};
+
+using OctreeParalelo = ParallelTreeSearch<OctreeNode>;
+using QuadtreeParalelo = ParallelTreeSearch<QuadtreeNode>;
+
+#endif
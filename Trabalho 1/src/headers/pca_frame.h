@@ -0,0 +1,352 @@
+#ifndef PCA_FRAME_H
+#define PCA_FRAME_H
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "image.h"
+
+// ============================================================================
+// REFERENCIAL DOS EIXOS PRINCIPAIS (PCA) NA FRENTE DE QUALQUER ESTRUTURA
+// ============================================================================
+/*
+ANALISE PAA - EIXOS ALINHADOS AOS DADOS:
+
+PROBLEMA:
+- Cores medias de fotos ficam perto da diagonal cinza R=G=B: a nuvem e um
+  "charuto" inclinado, e os octantes/quadrantes alinhados a R, G e B cortam
+  esse charuto na diagonal (caixas grandes, quase vazias, mal podadas)
+- A Quadtree estrutura por (R,G) por convencao, nao porque sejam os eixos
+  que mais separam os pontos
+
+TECNICA:
+- Rotacao rigida: x = A (p - media) + deslocamento, com as linhas de A os
+  autovetores da covariancia 3x3 em ordem decrescente de variancia
+  (Jacobi ciclico). A e ortonormal, entao |x - y| = |p - q|: a distancia
+  euclidiana (e o threshold) nao muda
+- Eixo 0 (r) = 1a componente, eixo 1 (g) = 2a, eixo 2 (b) = 3a: octree e
+  grades recebem eixos alinhados a nuvem, e a Quadtree passa a estruturar
+  pelas DUAS componentes de maior variancia sem mudar uma linha
+- Deslocamento leva o minimo de cada eixo a 0. A extensao na 1a componente
+  pode passar de 255 (ate 255*sqrt(3)): arvores recebem a raiz [0, S] e
+  hash/hashdyn uma grade com mais celulas por eixo (setDomain); as demais
+  ficam em [0,255] e mandam o excesso para a borda (correto, menos seletivo)
+- Estruturas -t NAO entram aqui (structure_factory recusa): raiz fixa em
+  [0,255], poda pelas caixas de particao e uint8 satura em 255
+
+CONSTRUCAO (etapa opcional, --frame pca):
+- Insercoes ficam num buffer ate a primeira consulta (ou finishBuild /
+  memoryUsage / printAnalysis), que ajusta a PCA em O(n), roda os pontos e constroi a
+  estrutura interna. Depois disso o referencial fica fixo: insercoes novas
+  entram rodadas direto (resultado exato, so a orientacao envelhece)
+- Consultas: rodadas na entrada; a rotacao em double erra ~1e-13, o que
+  basta para um ponto exatamente no threshold (cores inteiras, threshold
+  inteiro) cair do lado errado. A busca interna usa threshold + folga e cada
+  candidato e conferido com as coordenadas RGB ORIGINAIS (guardadas por id,
+  24 bytes + no de hash por imagem): mesmo conjunto que a LinearSearch
+- kNN: os k da interna dao o raio; uma busca por raio + folga recolhe os
+  empatados/quase empatados, reordenados pela distancia original
+*/
+
+struct PcaFrame {
+    std::array<double, 3> mean{0.0, 0.0, 0.0};
+    std::array<std::array<double, 3>, 3> axes{{{1, 0, 0}, {0, 1, 0}, {0, 0, 1}}};  // Linhas: componentes
+    std::array<double, 3> variance{0.0, 0.0, 0.0};
+    std::array<double, 3> offset{0.0, 0.0, 0.0};
+    double extent = 255.0;       // Lado do cubo [0, extent] que cobre os pontos rodados
+    size_t outsideRGBCube = 0;   // Pontos rodados com alguma coordenada > 255 (borda das grades)
+
+    // Autovalores/autovetores de matriz simetrica 3x3 (Jacobi ciclico): vetores nas colunas
+    static void symmetricEigen(std::array<std::array<double, 3>, 3> a, std::array<double, 3>& values,
+                               std::array<std::array<double, 3>, 3>& vectors) {
+        vectors = {{{1, 0, 0}, {0, 1, 0}, {0, 0, 1}}};
+        for (int sweep = 0; sweep < 32; sweep++) {
+            double off = a[0][1] * a[0][1] + a[0][2] * a[0][2] + a[1][2] * a[1][2];
+            double diag = a[0][0] * a[0][0] + a[1][1] * a[1][1] + a[2][2] * a[2][2];
+            if (off <= 1e-24 * diag || off == 0.0) break;
+            for (int p = 0; p < 2; p++) {
+                for (int q = p + 1; q < 3; q++) {
+                    if (a[p][q] == 0.0) continue;
+                    double theta = (a[q][q] - a[p][p]) / (2.0 * a[p][q]);
+                    double t = (theta >= 0 ? 1.0 : -1.0) / (std::fabs(theta) + std::sqrt(theta * theta + 1.0));
+                    double c = 1.0 / std::sqrt(t * t + 1.0), s = t * c;
+                    for (int k = 0; k < 3; k++) {  // A J
+                        double akp = a[k][p], akq = a[k][q];
+                        a[k][p] = c * akp - s * akq;
+                        a[k][q] = s * akp + c * akq;
+                    }
+                    for (int k = 0; k < 3; k++) {  // J^T A
+                        double apk = a[p][k], aqk = a[q][k];
+                        a[p][k] = c * apk - s * aqk;
+                        a[q][k] = s * apk + c * aqk;
+                    }
+                    for (int k = 0; k < 3; k++) {  // V J
+                        double vkp = vectors[k][p], vkq = vectors[k][q];
+                        vectors[k][p] = c * vkp - s * vkq;
+                        vectors[k][q] = s * vkp + c * vkq;
+                    }
+                }
+            }
+        }
+        values = {a[0][0], a[1][1], a[2][2]};
+    }
+
+    // Media e covariancia em duas passadas, componentes ordenadas, deslocamento e extensao
+    static PcaFrame fit(const std::vector<Image>& images) {
+        PcaFrame frame;
+        if (images.empty()) return frame;
+
+        for (const auto& img : images) {
+            frame.mean[0] += img.r;
+            frame.mean[1] += img.g;
+            frame.mean[2] += img.b;
+        }
+        for (double& m : frame.mean) m /= images.size();
+
+        std::array<std::array<double, 3>, 3> covariance{};
+        for (const auto& img : images) {
+            double d[3] = {img.r - frame.mean[0], img.g - frame.mean[1], img.b - frame.mean[2]};
+            for (int i = 0; i < 3; i++) {
+                for (int j = i; j < 3; j++) covariance[i][j] += d[i] * d[j];
+            }
+        }
+        for (int i = 0; i < 3; i++) {
+            for (int j = i; j < 3; j++) covariance[j][i] = covariance[i][j] /= images.size();
+        }
+
+        std::array<double, 3> values;
+        std::array<std::array<double, 3>, 3> vectors;
+        symmetricEigen(covariance, values, vectors);
+        std::array<int, 3> order{0, 1, 2};
+        std::sort(order.begin(), order.end(), [&](int x, int y) { return values[x] > values[y]; });
+        for (int k = 0; k < 2; k++) {
+            frame.variance[k] = values[order[k]];
+            for (int j = 0; j < 3; j++) frame.axes[k][j] = vectors[j][order[k]];
+            // Sinal fixo (componente aponta para o branco): o mesmo dataset da sempre o mesmo referencial
+            if (frame.axes[k][0] + frame.axes[k][1] + frame.axes[k][2] < 0) {
+                for (double& v : frame.axes[k]) v = -v;
+            }
+        }
+        // 3a componente = produto vetorial: base ortonormal de mao direita (rotacao propria)
+        const auto& u = frame.axes[0];
+        const auto& v = frame.axes[1];
+        frame.axes[2] = {u[1] * v[2] - u[2] * v[1], u[2] * v[0] - u[0] * v[2], u[0] * v[1] - u[1] * v[0]};
+        frame.variance[2] = values[order[2]];
+
+        std::array<double, 3> low{1e300, 1e300, 1e300}, high{-1e300, -1e300, -1e300};
+        for (const auto& img : images) {
+            double x[3];
+            frame.rotate(img, x);
+            for (int k = 0; k < 3; k++) {
+                low[k] = std::min(low[k], x[k]);
+                high[k] = std::max(high[k], x[k]);
+            }
+        }
+        double widest = 0.0;
+        for (int k = 0; k < 3; k++) {
+            frame.offset[k] = -low[k];
+            widest = std::max(widest, high[k] - low[k]);
+        }
+        frame.extent = std::max(255.0, widest);
+        for (const auto& img : images) {
+            double x[3];
+            frame.rotate(img, x);
+            for (int k = 0; k < 3; k++) {
+                if (x[k] + frame.offset[k] > 255.0) {
+                    frame.outsideRGBCube++;
+                    break;
+                }
+            }
+        }
+        return frame;
+    }
+
+    // Rotacao sem deslocamento
+    void rotate(const Image& img, double x[3]) const {
+        double d[3] = {img.r - mean[0], img.g - mean[1], img.b - mean[2]};
+        for (int k = 0; k < 3; k++) x[k] = axes[k][0] * d[0] + axes[k][1] * d[1] + axes[k][2] * d[2];
+    }
+
+    Image toFrame(const Image& img) const {
+        double x[3];
+        rotate(img, x);
+        return Image(img.id, img.filename, x[0] + offset[0], x[1] + offset[1], x[2] + offset[2]);
+    }
+
+    // Inversa no lugar: A ortonormal, entao A^-1 = A^T (sem copiar o filename)
+    void restore(Image& img) const {
+        double x[3] = {img.r - offset[0], img.g - offset[1], img.b - offset[2]};
+        img.r = mean[0] + axes[0][0] * x[0] + axes[1][0] * x[1] + axes[2][0] * x[2];
+        img.g = mean[1] + axes[0][1] * x[0] + axes[1][1] * x[1] + axes[2][1] * x[2];
+        img.b = mean[2] + axes[0][2] * x[0] + axes[1][2] * x[1] + axes[2][2] * x[2];
+    }
+
+    Image fromFrame(const Image& img) const {
+        Image original = img;
+        restore(original);
+        return original;
+    }
+
+    double varianceShare(int component) const {
+        double total = variance[0] + variance[1] + variance[2];
+        return total > 0 ? 100.0 * variance[component] / total : 0.0;
+    }
+};
+
+class PcaFrameIndex : public ImageDatabase {
+private:
+    std::unique_ptr<ImageDatabase> inner;
+    mutable std::vector<Image> pending;  // Coordenadas originais, ate o ajuste
+    mutable PcaFrame frame;
+    mutable bool fitted = false;
+    mutable bool domainApplied = false;  // Estrutura interna aceitou a raiz [0, extent]
+    mutable std::atomic<bool> fitPending{false};
+    mutable std::mutex fitMutex;
+    mutable double fitMs = 0.0;
+    size_t totalImages = 0;
+    // id -> RGB original (ids unicos, como em todo o projeto): filtro final e coordenadas devolvidas
+    std::unordered_map<int, std::array<double, 3>> originals;
+
+    // Erro da rotacao ida e volta e ~1e-13 por coordenada; folga com margem de sobra
+    static constexpr double kRotationSlack = 1e-9;
+
+    // Coordenadas originais no lugar das rodadas (transposta so se o id nao foi visto)
+    void restoreOriginal(Image& img) const {
+        auto it = originals.find(img.id);
+        if (it == originals.end()) {
+            frame.restore(img);
+            return;
+        }
+        img.r = it->second[0];
+        img.g = it->second[1];
+        img.b = it->second[2];
+    }
+
+    // Candidatos da busca com folga: originais de volta e so os que passam no threshold real
+    void keepWithin(std::vector<Image>& candidates, const Image& query, double threshold) const {
+        size_t kept = 0;
+        for (size_t i = 0; i < candidates.size(); i++) {
+            restoreOriginal(candidates[i]);
+            if (query.distanceTo(candidates[i]) > threshold) continue;
+            if (kept != i) candidates[kept] = std::move(candidates[i]);
+            kept++;
+        }
+        candidates.erase(candidates.begin() + kept, candidates.end());
+    }
+
+    // Ajuste da PCA e construcao da estrutura interna no referencial novo
+    void fit() const {
+        auto start = std::chrono::high_resolution_clock::now();
+        frame = PcaFrame::fit(pending);
+        domainApplied = inner->setDomain(0.0, frame.extent);
+        for (const auto& img : pending) inner->insert(frame.toFrame(img));
+        std::vector<Image>().swap(pending);
+        fitted = true;
+        fitMs = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+    }
+
+    void ensureFitted() const {
+        if (!fitPending.load(std::memory_order_acquire)) return;
+        std::lock_guard<std::mutex> lock(fitMutex);
+        if (!fitPending.load(std::memory_order_relaxed)) return;
+        fit();
+        fitPending.store(false, std::memory_order_release);
+    }
+
+public:
+    explicit PcaFrameIndex(std::unique_ptr<ImageDatabase> _inner) : inner(std::move(_inner)) {}
+
+    void insert(const Image& img) override {
+        totalImages++;
+        originals[img.id] = {img.r, img.g, img.b};
+        if (fitted) {
+            inner->insert(frame.toFrame(img));
+            return;
+        }
+        pending.push_back(img);
+        fitPending.store(true, std::memory_order_release);
+    }
+
+    // Contadores sao thread_local da ImageDatabase: lastQueryStats ja mostra o trabalho da interna
+    std::vector<Image> findSimilar(const Image& query, double threshold) const override {
+        ensureFitted();
+        std::vector<Image> results = inner->findSimilar(frame.toFrame(query), threshold + kRotationSlack);
+        keepWithin(results, query, threshold);
+        return results;
+    }
+
+    bool forEachSimilar(const Image& query, double threshold, const SimilarVisitor& visit) const override {
+        ensureFitted();
+        return inner->forEachSimilar(frame.toFrame(query), threshold + kRotationSlack, [&](const Image& img) {
+            Image original = img;
+            restoreOriginal(original);
+            return query.distanceTo(original) > threshold || visit(original);
+        });
+    }
+
+    // A rotacao preserva distancias a menos do arredondamento: o k-esimo da interna (raio R)
+    // limita o k-esimo real a R + folga, e todo ponto ate esse limite esta a R + 2 folgas no
+    // referencial. Uma busca por esse raio traz os empates; a ordem final usa as originais
+    std::vector<Image> findKNearest(const Image& query, size_t k) const override {
+        ensureFitted();
+        Image rotated = frame.toFrame(query);
+        std::vector<Image> results = inner->findKNearest(rotated, k);
+        if (results.size() == k && !queryInterrupted()) {
+            double radius = rotated.distanceTo(results.back()) + 2 * kRotationSlack;
+            results = inner->findSimilar(rotated, radius);
+        }
+        for (auto& img : results) restoreOriginal(img);
+        sortByDistance(results, query);
+        if (results.size() > k) results.erase(results.begin() + k, results.end());
+        return results;
+    }
+
+    size_t size() const override { return totalImages; }
+    std::string getName() const override { return "PCA " + inner->getName(); }
+
+    void finishBuild() const override {
+        ensureFitted();
+        inner->finishBuild();
+    }
+
+    MemoryUsage memoryUsage() const override {
+        ensureFitted();
+        MemoryUsage usage = inner->memoryUsage();
+        accountImageVector(pending, usage);
+        // Tabela id -> RGB original (no: proximo + par chave/valor; chave int sem hash guardado)
+        constexpr size_t entryBytes = sizeof(void*) + sizeof(std::pair<const int, std::array<double, 3>>);
+        size_t bucketArray = originals.bucket_count() * sizeof(void*);
+        usage.bucketBytes += bucketArray;
+        usage.overheadBytes += mallocOverheadBytes(bucketArray);
+        usage.overheadBytes += originals.size() * (entryBytes + mallocOverheadBytes(entryBytes));
+        return usage;
+    }
+
+    void printAnalysis() const override {
+        ensureFitted();
+        const char* names[3] = {"r", "g", "b"};
+        printf("  REFERENCIAL PCA:\n");
+        printf("    Media: (%.1f, %.1f, %.1f) | ajuste: %.2fms\n", frame.mean[0], frame.mean[1], frame.mean[2],
+               fitMs);
+        for (int k = 0; k < 3; k++) {
+            printf("    Eixo %s = componente %d: (%+.3f, %+.3f, %+.3f), variancia %.1f (%.1f%%)\n", names[k], k + 1,
+                   frame.axes[k][0], frame.axes[k][1], frame.axes[k][2], frame.variance[k],
+                   frame.varianceShare(k));
+        }
+        printf("    Dominio: [0, %.1f] %s | fora de [0,255]^3: %zu pontos\n", frame.extent,
+               domainApplied ? "(estrutura ajustada ao dominio)" : "(estrutura fixa em [0,255], excesso na borda)",
+               frame.outsideRGBCube);
+        inner->printAnalysis();
+    }
+};
+
+#endif
@@ -0,0 +1,168 @@
+#ifndef PERF_COUNTERS_H
+#define PERF_COUNTERS_H
+
+#include <cstdint>
+#include <cstdio>
+
+/**
+ * @brief Contadores de hardware (perf_event_open) para as fases de construcao e busca
+ *
+ * Instrumentacao OPCIONAL: so e ativada compilando com -DPAA_PERF_COUNTERS em Linux.
+ * Sem a flag, PerfCounters vira um stub vazio (custo zero nos benchmarks normais).
+ *
+ * Eventos: ciclos, instrucoes, misses de L1D, misses de LLC, branch misses e dTLB misses.
+ * Cada evento usa um descritor independente (nao um grupo), entao um evento nao suportado
+ * pela CPU/VM nao derruba os demais. Valores multiplexados sao escalados por
+ * time_enabled / time_running.
+ *
+ * Escopo: SO a thread que chama start/stop (pid=0, sem inherit; inherit nao alcancaria
+ * os workers do pool, criados antes). O trabalho feito nos workers do ThreadPool
+ * (linear-par, octree-par, quadtree-par) fica de fora: callerThreadOnly marca a
+ * amostra e print avisa que os numeros sao parciais.
+ */
+
+enum PerfEvent {
+    PERF_CYCLES = 0,
+    PERF_INSTRUCTIONS,
+    PERF_L1D_MISSES,
+    PERF_LLC_MISSES,
+    PERF_BRANCH_MISSES,
+    PERF_DTLB_MISSES,
+    PERF_EVENT_COUNT
+};
+
+struct PerfSample {
+    bool valid = false;
+    bool supported[PERF_EVENT_COUNT] = {};
+    uint64_t values[PERF_EVENT_COUNT] = {};
+    bool callerThreadOnly = false;  // Parte do trabalho rodou em outras threads (nao contada)
+
+    uint64_t operator[](PerfEvent event) const { return values[event]; }
+
+    // Imprime os contadores normalizados por operacao (por insercao ou por consulta)
+    void print(const char* phase, double operations) const {
+        if (!valid) return;
+        static const char* names[PERF_EVENT_COUNT] = {
+            "ciclos", "instr", "L1D-miss", "LLC-miss", "branch-miss", "dTLB-miss"
+        };
+        double ops = operations > 0 ? operations : 1.0;
+        printf("    Perf %-8s:", phase);
+        for (int i = 0; i < PERF_EVENT_COUNT; i++) {
+            if (supported[i]) {
+                printf(" %s=%.2f", names[i], values[i] / ops);
+            } else {
+                printf(" %s=n/d", names[i]);
+            }
+        }
+        if (supported[PERF_CYCLES] && supported[PERF_INSTRUCTIONS] && values[PERF_CYCLES] > 0) {
+            printf(" IPC=%.2f", static_cast<double>(values[PERF_INSTRUCTIONS]) / values[PERF_CYCLES]);
+        }
+        if (callerThreadOnly) printf(" [PARCIAL: so a thread chamadora, workers do pool fora]");
+        printf("\n");
+    }
+};
+
+#if defined(PAA_PERF_COUNTERS) && defined(__linux__)
+
+#include <cstring>
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+class PerfCounters {
+private:
+    int fds[PERF_EVENT_COUNT];
+
+    static int openEvent(uint32_t type, uint64_t config) {
+        struct perf_event_attr attr;
+        std::memset(&attr, 0, sizeof(attr));
+        attr.size = sizeof(attr);
+        attr.type = type;
+        attr.config = config;
+        attr.disabled = 1;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+        return static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+    }
+
+    static uint64_t cacheConfig(uint64_t cache, uint64_t op, uint64_t result) {
+        return cache | (op << 8) | (result << 16);
+    }
+
+public:
+    PerfCounters() {
+        fds[PERF_CYCLES] = openEvent(PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES);
+        fds[PERF_INSTRUCTIONS] = openEvent(PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS);
+        fds[PERF_L1D_MISSES] = openEvent(PERF_TYPE_HW_CACHE,
+            cacheConfig(PERF_COUNT_HW_CACHE_L1D, PERF_COUNT_HW_CACHE_OP_READ, PERF_COUNT_HW_CACHE_RESULT_MISS));
+        fds[PERF_LLC_MISSES] = openEvent(PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES);
+        fds[PERF_BRANCH_MISSES] = openEvent(PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES);
+        fds[PERF_DTLB_MISSES] = openEvent(PERF_TYPE_HW_CACHE,
+            cacheConfig(PERF_COUNT_HW_CACHE_DTLB, PERF_COUNT_HW_CACHE_OP_READ, PERF_COUNT_HW_CACHE_RESULT_MISS));
+
+        // Avisar uma unica vez (ex.: perf_event_paranoid alto, container ou VM sem PMU)
+        static bool warned = false;
+        if (!available() && !warned) {
+            warned = true;
+            fprintf(stderr, "AVISO: perf_event_open indisponivel - contadores de hardware desativados\n");
+        }
+    }
+
+    ~PerfCounters() {
+        for (int fd : fds) {
+            if (fd >= 0) close(fd);
+        }
+    }
+
+    PerfCounters(const PerfCounters&) = delete;
+    PerfCounters& operator=(const PerfCounters&) = delete;
+
+    bool available() const {
+        for (int fd : fds) {
+            if (fd >= 0) return true;
+        }
+        return false;
+    }
+
+    void start() {
+        for (int fd : fds) {
+            if (fd < 0) continue;
+            ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+            ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+        }
+    }
+
+    PerfSample stop() {
+        PerfSample sample;
+        for (int i = 0; i < PERF_EVENT_COUNT; i++) {
+            if (fds[i] < 0) continue;
+            ioctl(fds[i], PERF_EVENT_IOC_DISABLE, 0);
+
+            // Formato: valor, time_enabled, time_running
+            uint64_t data[3] = {0, 0, 0};
+            if (read(fds[i], data, sizeof(data)) != static_cast<ssize_t>(sizeof(data))) continue;
+
+            double scale = (data[2] > 0) ? static_cast<double>(data[1]) / data[2] : 0.0;
+            sample.values[i] = static_cast<uint64_t>(data[0] * scale);
+            sample.supported[i] = data[2] > 0;
+            sample.valid = sample.valid || sample.supported[i];
+        }
+        return sample;
+    }
+};
+
+#else
+
+// Stub: instrumentacao desligada (compile com -DPAA_PERF_COUNTERS para ativar)
+class PerfCounters {
+public:
+    bool available() const { return false; }
+    void start() {}
+    PerfSample stop() { return PerfSample(); }
+};
+
+#endif
+
+#endif
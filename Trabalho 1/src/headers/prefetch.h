@@ -0,0 +1,75 @@
+#ifndef PREFETCH_H
+#define PREFETCH_H
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+// ============================================================================
+// PREFETCH DE SOFTWARE NAS VARREDURAS DE CELULAS E FOLHAS
+// ============================================================================
+/*
+Buckets da grade hash e folhas das arvores sao vectors espalhados pelo heap:
+cada celula/folha visitada comeca com um cache miss no payload. A ordem de
+visita e conhecida (odometro do cubo, cascas, pilha da DFS), entao a busca
+trabalha com UM passo de antecedencia:
+
+  push(proximo): pede o payload do proximo a memoria (__builtin_prefetch) e
+                 so entao varre o anterior, enquanto a linha chega
+  flush():       varre o ultimo pendente
+
+A ordem dos resultados nao muda (so atrasa um passo). Prefetch so das
+primeiras PREFETCH_BYTES: dali em diante o prefetcher de hardware ja
+reconheceu a leitura sequencial.
+
+-DPAA_NO_PREFETCH desliga (comparacao A/B com os contadores de
+-DPAA_PERF_COUNTERS: LLC-miss por consulta).
+*/
+
+#ifdef PAA_NO_PREFETCH
+constexpr bool kPrefetchEnabled = false;
+#else
+constexpr bool kPrefetchEnabled = true;
+#endif
+
+constexpr size_t PREFETCH_BYTES = 256;  // 4 linhas de cache
+constexpr size_t CACHE_LINE_BYTES = 64;
+
+inline void prefetchRead(const void* address) {
+    if constexpr (kPrefetchEnabled) __builtin_prefetch(address, 0, 3);
+}
+
+template <typename T>
+inline void prefetchPayload(const std::vector<T>& items) {
+    if constexpr (kPrefetchEnabled) {
+        const char* data = reinterpret_cast<const char*>(items.data());
+        size_t bytes = std::min(items.size() * sizeof(T), PREFETCH_BYTES);
+        for (size_t offset = 0; offset < bytes; offset += CACHE_LINE_BYTES) __builtin_prefetch(data + offset, 0, 3);
+    }
+}
+
+// Varredura com um passo de antecedencia; scan(const std::vector<T>&) retorna false para parar
+template <typename T>
+class PrefetchPipeline {
+private:
+    const std::vector<T>* pending = nullptr;
+
+public:
+    template <typename Scan>
+    bool push(const std::vector<T>& next, Scan&& scan) {
+        if constexpr (!kPrefetchEnabled) return scan(next);
+        prefetchPayload(next);
+        const std::vector<T>* current = pending;
+        pending = &next;
+        return current == nullptr || scan(*current);
+    }
+
+    template <typename Scan>
+    bool flush(Scan&& scan) {
+        const std::vector<T>* current = pending;
+        pending = nullptr;
+        return current == nullptr || scan(*current);
+    }
+};
+
+#endif
@@ -1,270 +1,130 @@
 #ifndef QUADTREE_H
 #define QUADTREE_H
 
-#include <vector>
-#include <memory>
-#include <array>
-#include <stack>
-#include <queue>
 #include <algorithm>
-#include <iostream>
-#include <string>
-#include <cmath>
+#include <array>
+#include <limits>
+#include <memory>
+#include <vector>
+
+#include "spatial_tree.h"
+
+// ============================================================================
+// ESTRUTURA 4: QUADTREE (ARVORE ESPACIAL 2D)
+// ============================================================================
+/*
+ANALISE PAA - QUADTREE:
+
+CONCEITO:
+- Arvore de subdivisao para espaco 2D (usando apenas R,G)
+- Cada no tem exatamente 4 filhos (quadrantes)
+- Busca ainda considera distancia 3D completa (R,G,B)
 
-// Forward declaration
-struct Image;
-class ImageDatabase;
+MOTIVACAO:
+- Curse of dimensionality: estruturas espaciais degradam em alta dimensao
+- Reducao dimensional: projeta RGB(3D) → RG(2D)
+- Mantem eficacia para consultas de proximidade
+
+TECNICA DE PROJECAO:
+- Estruturacao: usa apenas coordenadas (R,G)
+- Busca: calcula distancia euclidiana completa em (R,G,B)
+- Trade-off: menor precisao de poda vs menor overhead
+- Poda pela caixa (R,G) AJUSTADA aos pontos do no, nao pelo quadrante
+
+COMPLEXIDADES:
+- Insercao: O(log n) esperado no espaco 2D
+- Busca: O(log n + k) com poda menos eficiente que Octree
+- Espaco: O(n + nos internos), menor overhead que Octree
+
+QUANDO USAR:
+- Datasets muito grandes (n > 100000)
+- Quando Octree e muito lento
+- Distribuicao concentrada em 2 dimensoes principais (com --frame pca os
+  eixos (R,G) passam a ser as duas componentes de maior variancia)
+*/
 
-// No da Quadtree (2D - usando apenas R e G)
 struct QuadtreeNode {
+    static constexpr const char* kName = "Quadtree";
+    static constexpr const char* kAnalysisTitle = "ANALISE QUADTREE 2D";
+    static constexpr const char* kAnalysisNote = "Estruturacao 2D (R,G), busca 3D (R,G,B)";
+
+    // BOUNDING RECTANGLE: regiao 2D que este no representa (apenas R,G; define os quadrantes)
     double minR, maxR, minG, maxG;
-    std::vector<Image> images;
-    std::array<std::unique_ptr<QuadtreeNode>, 4> children;
+
+    // RETANGULO AJUSTADO: extensao (R,G) dos pontos da subarvore (vazio = +inf/-inf)
+    double fitMinR = std::numeric_limits<double>::infinity(), fitMaxR = -std::numeric_limits<double>::infinity();
+    double fitMinG = std::numeric_limits<double>::infinity(), fitMaxG = -std::numeric_limits<double>::infinity();
+
+    std::vector<Image> images;  // Imagens nesta regiao (se folha)
+    std::array<std::unique_ptr<QuadtreeNode>, 4> children;  // 4 quadrantes
     bool isLeaf;
-    
-    QuadtreeNode(double minR, double maxR, double minG, double maxG)
-        : minR(minR), maxR(maxR), minG(minG), maxG(maxG), isLeaf(true) {
-        for (auto& child : children) {
-            child = nullptr;
-        }
-    }
-    
-    bool contains(const Image& img) const {
-        return img.r >= minR && img.r <= maxR &&
-               img.g >= minG && img.g <= maxG;
+
+    QuadtreeNode(double _minR, double _maxR, double _minG, double _maxG)
+        : minR(_minR), maxR(_maxR), minG(_minG), maxG(_maxG), isLeaf(true) {}
+
+    // Inicializar com espaco RG completo [0,255]² (ou o dominio pedido por setDomain)
+    static std::unique_ptr<QuadtreeNode> makeRoot(double lo = 0, double hi = 255) {
+        return std::make_unique<QuadtreeNode>(lo, hi, lo, hi);
     }
-    
+
+    // FUNCAO DE INDEXACAO 2D: qual quadrante contem este ponto?
+    /*
+    TECNICA PAA: Mapeamento binario 2D
+    - Bit 0: R >= midR ? 1 : 0  (direita/esquerda)
+    - Bit 1: G >= midG ? 1 : 0  (cima/baixo)
+    - Resulta em indice 0-3
+    */
     int getChildIndex(const Image& img) const {
+        double midR = (minR + maxR) / 2;
+        double midG = (minG + maxG) / 2;
+
         int index = 0;
-        double midR = (minR + maxR) / 2.0;
-        double midG = (minG + maxG) / 2.0;
-        
-        if (img.r >= midR) index |= 2;  // Bit 1: R >= midR
-        if (img.g >= midG) index |= 1;  // Bit 0: G >= midG
-        
+        if (img.r >= midR) index |= 1;
+        if (img.g >= midG) index |= 2;
         return index;
     }
-    
+
+    // SUBDIVISAO 2D: criar 4 quadrantes filhos
     void createChildren() {
-        double midR = (minR + maxR) / 2.0;
-        double midG = (minG + maxG) / 2.0;
-        
-        // 4 quadrantes: 
-        // 0: [minR,midR] x [minG,midG]  (bottom-left)
-        // 1: [minR,midR] x [midG,maxG]  (top-left)  
-        // 2: [midR,maxR] x [minG,midG]  (bottom-right)
-        // 3: [midR,maxR] x [midG,maxG]  (top-right)
-        children[0] = std::make_unique<QuadtreeNode>(minR, midR, minG, midG);
-        children[1] = std::make_unique<QuadtreeNode>(minR, midR, midG, maxG);
-        children[2] = std::make_unique<QuadtreeNode>(midR, maxR, minG, midG);
-        children[3] = std::make_unique<QuadtreeNode>(midR, maxR, midG, maxG);
-        
+        if (!isLeaf) return;
         isLeaf = false;
-    }
-};
 
-// Quadtree Search Iterativa
-class QuadtreeIterativeSearch : public ImageDatabase {
-private:
-    std::unique_ptr<QuadtreeNode> root;
-    int maxImagesPerNode;
-    int totalImages;
-    int maxDepth;
-    
-    void insertIterative(const Image& img) {
-        QuadtreeNode* currentNode = root.get();
-        int currentDepth = 0;
-        
-        while (true) {
-            maxDepth = std::max(maxDepth, currentDepth);
-            
-            if (currentNode->isLeaf) {
-                currentNode->images.push_back(img);
-                
-                // Verificar se precisa dividir
-                if (static_cast<int>(currentNode->images.size()) > maxImagesPerNode && currentDepth < 10) {
-                    currentNode->createChildren();
-                    
-                    // Redistribuir todas as imagens
-                    std::vector<Image> imagesToRedistribute = currentNode->images;
-                    currentNode->images.clear();
-                    
-                    // Redistribuir cada imagem para seus filhos
-                    for (const auto& existingImg : imagesToRedistribute) {
-                        int childIdx = currentNode->getChildIndex(existingImg);
-                        insertIntoChild(currentNode->children[childIdx].get(), existingImg, currentDepth + 1);
-                    }
-                }
-                break;
-            } else {
-                int childIdx = currentNode->getChildIndex(img);
-                currentNode = currentNode->children[childIdx].get();
-                currentDepth++;
-            }
-        }
-    }
-    
-    // Funcao auxiliar iterativa para insercao em filhos
-    void insertIntoChild(QuadtreeNode* startNode, const Image& img, int startDepth) {
-        std::stack<std::pair<QuadtreeNode*, int>> nodeStack;
-        nodeStack.push({startNode, startDepth});
-        
-        while (!nodeStack.empty()) {
-            auto [node, depth] = nodeStack.top();
-            nodeStack.pop();
-            
-            maxDepth = std::max(maxDepth, depth);
-            
-            if (node->isLeaf) {
-                node->images.push_back(img);
-                
-                if (static_cast<int>(node->images.size()) > maxImagesPerNode && depth < 10) {
-                    node->createChildren();
-                    
-                    std::vector<Image> imagesToRedistribute = node->images;
-                    node->images.clear();
-                    
-                    for (const auto& existingImg : imagesToRedistribute) {
-                        int childIdx = node->getChildIndex(existingImg);
-                        nodeStack.push({node->children[childIdx].get(), depth + 1});
-                        
-                        // Inserir diretamente no no filho
-                        QuadtreeNode* targetChild = node->children[childIdx].get();
-                        targetChild->images.push_back(existingImg);
-                    }
-                }
-            } else {
-                int childIdx = node->getChildIndex(img);
-                nodeStack.push({node->children[childIdx].get(), depth + 1});
-            }
-        }
-    }
-    
-    bool nodeIntersectsQueryRadius(QuadtreeNode* node, const Image& query, double threshold) const {
-        // Calcular distancia minima do ponto query ao retangulo do no
-        double minDistSq = 0.0;
-        
-        // Verificar componente R
-        if (query.r < node->minR) {
-            double diff = node->minR - query.r;
-            minDistSq += diff * diff;
-        } else if (query.r > node->maxR) {
-            double diff = query.r - node->maxR;
-            minDistSq += diff * diff;
-        }
-        
-        // Verificar componente G
-        if (query.g < node->minG) {
-            double diff = node->minG - query.g;
-            minDistSq += diff * diff;
-        } else if (query.g > node->maxG) {
-            double diff = query.g - node->maxG;
-            minDistSq += diff * diff;
-        }
-        
-        // Para Quadtree 2D, ainda precisamos considerar B na distancia final
-        // mas para pruning, usamos apenas R,G
-        return sqrt(minDistSq) <= threshold;
-    }
-    
-    void searchIterative(const Image& query, double threshold, std::vector<Image>& results) {
-        std::queue<QuadtreeNode*> queue;
-        queue.push(root.get());
-        
-        while (!queue.empty()) {
-            QuadtreeNode* node = queue.front();
-            queue.pop();
-            
-            if (!node) continue;
-            
-            if (!nodeIntersectsQueryRadius(node, query, threshold)) {
-                continue;
-            }
-            
-            if (node->isLeaf) {
-                for (const auto& img : node->images) {
-                    double distance = query.distanceTo(img); // Distancia 3D completa (R,G,B)
-                    if (distance <= threshold) {
-                        results.push_back(img);
-                    }
-                }
-            } else {
-                for (const auto& child : node->children) {
-                    if (child) {
-                        queue.push(child.get());
-                    }
-                }
-            }
-        }
-    }
-    
-    void countNodes(QuadtreeNode* node, int& leafCount, int& internalCount) const {
-        if (!node) return;
-        
-        std::queue<QuadtreeNode*> queue;
-        queue.push(node);
-        
-        while (!queue.empty()) {
-            QuadtreeNode* current = queue.front();
-            queue.pop();
-            
-            if (current->isLeaf) {
-                leafCount++;
-            } else {
-                internalCount++;
-                for (const auto& child : current->children) {
-                    if (child) {
-                        queue.push(child.get());
-                    }
-                }
-            }
-        }
-    }
-    
-public:
-    QuadtreeIterativeSearch(int maxImages = 25) 
-        : maxImagesPerNode(maxImages), totalImages(0), maxDepth(0) {
-        root = std::make_unique<QuadtreeNode>(0, 255, 0, 255);
-    }
-    
-    void insert(const Image& img) override {
-        insertIterative(img);
-        totalImages++;
-    }
-    
-    std::vector<Image> findSimilar(const Image& query, double threshold) override {
-        std::vector<Image> results;
-        searchIterative(query, threshold, results);
-        
-        std::sort(results.begin(), results.end(), 
-                 [&query](const Image& a, const Image& b) {
-                     return query.distanceTo(a) < query.distanceTo(b);
-                 });
-        
-        return results;
+        double midR = (minR + maxR) / 2;
+        double midG = (minG + maxG) / 2;
+
+        children[0] = std::make_unique<QuadtreeNode>(minR, midR, minG, midG);  // bottom-left
+        children[1] = std::make_unique<QuadtreeNode>(midR, maxR, minG, midG);  // bottom-right
+        children[2] = std::make_unique<QuadtreeNode>(minR, midR, midG, maxG);  // top-left
+        children[3] = std::make_unique<QuadtreeNode>(midR, maxR, midG, maxG);  // top-right
     }
-    
-    std::string getName() const override {
-        return "Quadtree Iterative (maxPerNode=" + std::to_string(maxImagesPerNode) + ")";
+
+    void include(const Image& img) {
+        fitMinR = std::min(fitMinR, img.r);
+        fitMaxR = std::max(fitMaxR, img.r);
+        fitMinG = std::min(fitMinG, img.g);
+        fitMaxG = std::max(fitMaxG, img.g);
     }
-    
-    void printStats() const {
-        int leafCount = 0, internalCount = 0;
-        countNodes(root.get(), leafCount, internalCount);
-        
-        std::cout << "Quadtree Iterative Stats:" << std::endl;
-        std::cout << "  Total de imagens: " << totalImages << std::endl;
-        std::cout << "  Max imagens por no: " << maxImagesPerNode << std::endl;
-        std::cout << "  Profundidade maxima: " << maxDepth << std::endl;
-        std::cout << "  Nos folha: " << leafCount << std::endl;
-        std::cout << "  Nos internos: " << internalCount << std::endl;
-        std::cout << "  Total de nos: " << (leafCount + internalCount) << std::endl;
-        
-        if (leafCount > 0) {
-            std::cout << "  Imagens por folha (media): " 
-                      << static_cast<double>(totalImages) / leafCount << std::endl;
-        }
+
+    // GEOMETRIC PRUNING 2D com distancia 3D
+    /*
+    TECNICA HIBRIDA PAA:
+    - Poda baseada em projecao 2D (R,G) do retangulo ajustado: limite inferior
+      valido da distancia RGB
+    - Componente B nao entra na poda, mas entra na distancia final
+    */
+    bool outsideRange(const Image& query, double threshold) const {
+        double minDist = 0;
+        if (query.r < fitMinR) minDist += (fitMinR - query.r) * (fitMinR - query.r);
+        else if (query.r > fitMaxR) minDist += (query.r - fitMaxR) * (query.r - fitMaxR);
+
+        if (query.g < fitMinG) minDist += (fitMinG - query.g) * (fitMinG - query.g);
+        else if (query.g > fitMaxG) minDist += (query.g - fitMaxG) * (query.g - fitMaxG);
+
+        return minDist > threshold * threshold;
     }
 };
 
-#endif
\ No newline at end of file
+using QuadtreeSearch = SpatialTreeSearch<QuadtreeNode, false>;
+using QuadtreeIterativo = SpatialTreeSearch<QuadtreeNode, true>;
+
+#endif
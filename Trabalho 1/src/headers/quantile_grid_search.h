@@ -0,0 +1,239 @@
+#ifndef QUANTILE_GRID_SEARCH_H
+#define QUANTILE_GRID_SEARCH_H
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "image.h"
+#include "hash_search.h"
+#include "prefetch.h"
+
+// ============================================================================
+// GRID FILE: FRONTEIRAS DA GRADE PELOS QUANTIS DE CADA CANAL
+// ============================================================================
+/*
+ANALISE PAA - GRADE NAO UNIFORME:
+
+PROBLEMA:
+- HashSearch corta cada canal a cada cellSize unidades, mas as marginais
+  R/G/B reais estao longe de uniformes: umas poucas celulas "quentes"
+  concentram os pontos e dominam o tempo das consultas que caem nelas
+
+IDEIA (grid file):
+- Mesmo numero de fatias por eixo da grade uniforme (255/cellSize), mas as
+  fronteiras de cada eixo sao os quantis dos dados naquele canal: cada
+  fatia tem ~n/fatias pontos, e as celulas ficam com contagens parecidas
+  (exato por eixo; no conjunto, so se os canais forem independentes)
+- Quantis de um histograma fino por canal (QUANTILE_BINS caixas): O(n),
+  sem ordenar; fronteiras repetidas (muitos pontos no mesmo valor) sao
+  fundidas, entao um eixo pode ficar com menos fatias
+- A consulta acha a faixa de fatias de cada eixo com busca binaria nas
+  fronteiras (upper_bound) e visita as celulas ocupadas do cubo (mesmo
+  bitmap de ocupacao e chave uint64 do HashSearch)
+
+CONSTRUCAO:
+- Antes da primeira selagem as fronteiras sao uniformes (igual HashSearch)
+  e insert vai direto para a celula
+- A primeira consulta com >= MIN_SEAL_POINTS imagens (ou finishBuild /
+  memoryUsage / printAnalysis) recalcula as fronteiras e redistribui tudo; de novo quando
+  o tamanho dobra desde a ultima selagem (O(n) amortizado por insercao)
+- Como na SortedLinearSearch, a selagem dentro da consulta const usa um mutex
+*/
+
+class QuantileGridSearch : public ImageDatabase {
+public:
+    static constexpr int QUANTILE_BINS = 4096;     // Resolucao do histograma (passo 255/4096)
+    static constexpr size_t MIN_SEAL_POINTS = 1024;
+    static constexpr size_t SEAL_GROWTH = 2;
+
+private:
+    int slabsPerAxis;  // Fatias pedidas (a grade uniforme equivalente)
+
+    // Fronteiras de cada eixo: fatia i = [bounds[i], bounds[i+1]); as pontas sao -inf/+inf
+    // na pratica (toCell so olha as internas). Mutaveis: selagem na primeira consulta
+    mutable std::array<std::vector<double>, 3> bounds;
+    mutable HashGrid grid;
+    mutable CellOccupancy occupancy;
+    size_t totalImages = 0;
+    mutable size_t sealedAt = 0;
+    mutable std::atomic<bool> sealPending{false};
+    mutable std::mutex sealMutex;
+    mutable size_t sealCount = 0;
+    mutable double lastSealMs = 0.0;
+
+    static double channel(const Image& img, int axis) { return axis == 0 ? img.r : (axis == 1 ? img.g : img.b); }
+
+    // Fatia do valor: busca binaria nas fronteiras internas
+    int toCell(int axis, double value) const {
+        const std::vector<double>& edges = bounds[axis];
+        return (int)(std::upper_bound(edges.begin() + 1, edges.end() - 1, value) - (edges.begin() + 1));
+    }
+
+    void uniformBounds() const {
+        for (auto& edges : bounds) {
+            edges.resize(slabsPerAxis + 1);
+            for (int i = 0; i <= slabsPerAxis; i++) edges[i] = 255.0 * i / slabsPerAxis;
+        }
+    }
+
+    void place(const Image& img) const {
+        int cellR = toCell(0, img.r), cellG = toCell(1, img.g), cellB = toCell(2, img.b);
+        grid[GridGeometry::packKey(cellR, cellG, cellB)].push_back(img);
+        occupancy.mark(cellR, cellG, cellB);
+    }
+
+    // Fronteiras pelos quantis de cada canal (histograma fino) e redistribuicao: O(n)
+    void seal() const {
+        auto start = std::chrono::high_resolution_clock::now();
+        std::vector<Image> all;
+        all.reserve(totalImages);
+        for (auto& cell : grid) {
+            for (auto& img : cell.second) all.push_back(std::move(img));
+        }
+        size_t activeCells = grid.size();
+        HashGrid().swap(grid);
+        grid.reserve(activeCells);
+
+        for (int axis = 0; axis < 3; axis++) {
+            std::vector<size_t> histogram(QUANTILE_BINS, 0);
+            for (const auto& img : all) {
+                int bin = (int)(channel(img, axis) * QUANTILE_BINS / 255.0);
+                histogram[std::min(std::max(bin, 0), QUANTILE_BINS - 1)]++;
+            }
+            std::vector<double>& edges = bounds[axis];
+            edges.assign(1, 0.0);
+            size_t cumulative = 0;
+            int slab = 1;
+            for (int bin = 0; bin < QUANTILE_BINS && slab < slabsPerAxis; bin++) {
+                cumulative += histogram[bin];
+                // Fecha todas as fatias cujo quantil ja foi atingido nesta caixa (uma fronteira so)
+                bool closes = false;
+                while (slab < slabsPerAxis && cumulative * slabsPerAxis >= all.size() * (size_t)slab) {
+                    closes = true;
+                    slab++;
+                }
+                if (closes && cumulative < all.size()) edges.push_back(255.0 * (bin + 1) / QUANTILE_BINS);
+            }
+            edges.push_back(255.0);
+        }
+
+        occupancy = CellOccupancy(slabsPerAxis);
+        for (const auto& img : all) place(img);
+        sealedAt = all.size();
+        sealCount++;
+        lastSealMs = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+    }
+
+    void ensureSealed() const {
+        if (!sealPending.load(std::memory_order_acquire)) return;
+        std::lock_guard<std::mutex> lock(sealMutex);
+        if (!sealPending.load(std::memory_order_relaxed)) return;
+        seal();
+        sealPending.store(false, std::memory_order_release);
+    }
+
+    template <typename Visitor>
+    bool visitSimilar(const Image& query, double threshold, Visitor&& visit) const {
+        ensureSealed();
+        int minR = toCell(0, query.r - threshold), maxR = toCell(0, query.r + threshold);
+        int minG = toCell(1, query.g - threshold), maxG = toCell(1, query.g + threshold);
+        int minB = toCell(2, query.b - threshold), maxB = toCell(2, query.b + threshold);
+
+        auto scanCell = [&](const std::vector<Image>& bucket) {
+            for (const auto& img : bucket) {
+                queryCounters.pointTested();
+                if (query.distanceTo(img) <= threshold) {
+                    queryCounters.pointAccepted();
+                    if (!visit(img)) return false;
+                }
+            }
+            return true;
+        };
+
+        PrefetchPipeline<Image> pipeline;
+        bool completed = occupancy.forEachInBox(minR, maxR, minG, maxG, minB, maxB, [&](int cellR, int cellG, int cellB) {
+            if (stopRequested()) return false;
+            auto it = grid.find(GridGeometry::packKey(cellR, cellG, cellB));
+            queryCounters.cellProbed(it != grid.end());
+            return it == grid.end() || pipeline.push(it->second, scanCell);
+        });
+        return completed && pipeline.flush(scanCell);
+    }
+
+public:
+    // cellSize: mesmo numero de fatias da grade uniforme de HashSearch(cellSize)
+    QuantileGridSearch(double cellSize = HashSearch::DEFAULT_CELL_SIZE)
+        : slabsPerAxis(GridGeometry(cellSize).gridSize), occupancy(slabsPerAxis) {
+        uniformBounds();
+    }
+
+    void insert(const Image& img) override {
+        place(img);
+        totalImages++;
+        if (totalImages >= std::max(MIN_SEAL_POINTS, SEAL_GROWTH * sealedAt)) {
+            sealPending.store(true, std::memory_order_release);
+        }
+    }
+
+    std::vector<Image> findSimilar(const Image& query, double threshold) const override {
+        std::vector<Image> results;
+        queryCounters.reset();
+        visitSimilar(query, threshold, [&results](const Image& img) {
+            results.push_back(img);
+            return true;
+        });
+        return results;
+    }
+
+    bool forEachSimilar(const Image& query, double threshold, const SimilarVisitor& visit) const override {
+        queryCounters.reset();
+        return visitSimilar(query, threshold, visit);
+    }
+
+    size_t size() const override { return totalImages; }
+    std::string getName() const override {
+        return "Quantile Grid (" + formatParam("fatias", slabsPerAxis, 0) + ")";
+    }
+
+    void finishBuild() const override { ensureSealed(); }
+
+    MemoryUsage memoryUsage() const override {
+        ensureSealed();
+        MemoryUsage usage;
+        accountHashGrid(grid, usage);
+        occupancy.accountMemory(usage);
+        for (const auto& edges : bounds) usage.nodeBytes += edges.capacity() * sizeof(double);
+        return usage;
+    }
+
+    void printAnalysis() const override {
+        ensureSealed();
+        size_t largest = 0;
+        for (const auto& cell : grid) largest = std::max(largest, cell.second.size());
+        std::cout << "  ANALISE GRID FILE (QUANTIS):" << std::endl;
+        std::cout << "    Celulas ativas: " << grid.size() << " | densidade media: "
+                  << averageCellOccupancy(grid, totalImages) << " | celula mais cheia: " << largest << std::endl;
+        const char* names[3] = {"R", "G", "B"};
+        for (int axis = 0; axis < 3; axis++) {
+            const std::vector<double>& edges = bounds[axis];
+            double narrowest = 255.0, widest = 0.0;
+            for (size_t i = 0; i + 1 < edges.size(); i++) {
+                narrowest = std::min(narrowest, edges[i + 1] - edges[i]);
+                widest = std::max(widest, edges[i + 1] - edges[i]);
+            }
+            std::cout << "    Eixo " << names[axis] << ": " << edges.size() - 1 << " fatias, largura "
+                      << narrowest << " a " << widest << std::endl;
+        }
+        std::cout << "    Selagens: " << sealCount << " (ultima: " << lastSealMs << "ms, " << sealedAt
+                  << " imagens)" << std::endl;
+    }
+};
+
+#endif
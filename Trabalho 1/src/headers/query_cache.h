@@ -0,0 +1,407 @@
+#ifndef QUERY_CACHE_H
+#define QUERY_CACHE_H
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "image.h"
+
+// ============================================================================
+// CACHE DE RESULTADOS NA FRENTE DE QUALQUER ESTRUTURA
+// ============================================================================
+/*
+ANALISE PAA - CACHE DE CONSULTAS:
+
+PROBLEMA:
+- O trafego real repete muito as mesmas consultas (cores de marca, o mesmo
+  query.jpg), mas cada findSimilar recomeca do zero
+
+CHAVE (cor quantizada, faixa de threshold, k):
+- Cor: cubo de lado quantum que contem a consulta (centro c, meia diagonal h)
+- Threshold: arredondado para cima ao multiplo de thresholdStep (T)
+- k: 0 para busca por raio
+
+RESULTADO EXATO COM CHAVE QUANTIZADA:
+- Raio: o cache guarda os candidatos de findSimilar(c, T + h). Toda consulta
+  q do mesmo cubo com threshold t <= T tem sua bola dentro dessa (|q-c| <= h),
+  entao filtrar os candidatos por distancia(q) <= t da a resposta exata
+- kNN: com r_k = distancia do k-esimo vizinho de c, os k vizinhos de q estao
+  a menos de r_k + h de q, logo a menos de r_k + 2h de c: guarda-se
+  findSimilar(c, r_k + 2h) e cada consulta ordena e corta em k
+- Quanto maior o quantum, mais consultas vizinhas compartilham uma entrada,
+  mas cada entrada guarda (e cada acerto filtra) mais candidatos
+
+SUBSTITUICAO (CLOCK):
+- Capacidade fixa de entradas; cada acerto liga o bit de referencia
+- Para liberar espaco o ponteiro gira: entradas referenciadas ganham uma
+  segunda chance (bit desligado), a primeira nao referenciada sai
+- Aproxima LRU sem reordenar lista a cada acerto
+
+INVALIDACAO POR CELULA:
+- Cada entrada cobre uma bola (c, raio de cobertura). Ela e registrada nas
+  celulas de uma grade grossa (lado INVALIDATION_CELL) que a bola toca
+- insert(p) so examina as entradas registradas na celula de p e descarta as
+  que cobrem p; o resto do cache continua valido
+- Registros de entradas ja substituidas sao removidos de forma preguicosa
+
+CONCORRENCIA:
+- findSimilar continua const e pode ser chamado por varias threads: o
+  estado do cache fica atras de um mutex, segurado so para procurar e
+  guardar a entrada (a busca na estrutura e o filtro rodam fora dele)
+- insert precisa das mesmas garantias da estrutura embrulhada (um escritor
+  sem leitores, ou um embrulho de concurrent_index.h por fora)
+
+Remocao nao existe na interface ImageDatabase; se existir, invalida-se da
+mesma forma que insert.
+*/
+
+struct QueryCacheStats {
+    uint64_t hits = 0;
+    uint64_t misses = 0;
+    uint64_t evictions = 0;
+    uint64_t invalidations = 0;
+    double hitMs = 0.0;    // Tempo total das consultas atendidas pelo cache
+    double missMs = 0.0;   // Tempo total das consultas que foram a estrutura
+
+    double hitRate() const {
+        uint64_t total = hits + misses;
+        return total > 0 ? 100.0 * hits / total : 0.0;
+    }
+    // Estimativa: cada acerto teria custado um miss medio
+    double savedMs() const {
+        if (misses == 0) return 0.0;
+        return hits * (missMs / misses) - hitMs;
+    }
+};
+
+class CachedIndex : public ImageDatabase {
+private:
+    struct CacheKey {
+        int32_t r, g, b;       // Cubo de lado quantum
+        int32_t threshold;     // Faixa (multiplos de thresholdStep); -1 em kNN
+        uint32_t k;            // 0 em busca por raio
+
+        bool operator==(const CacheKey& other) const {
+            return r == other.r && g == other.g && b == other.b && threshold == other.threshold &&
+                   k == other.k;
+        }
+    };
+
+    struct CacheKeyHash {
+        size_t operator()(const CacheKey& key) const {
+            uint64_t h = (uint64_t)(uint32_t)key.r * 0x9E3779B97F4A7C15ULL;
+            h ^= (uint64_t)(uint32_t)key.g + 0x632BE59BD9B4E019ULL + (h << 6) + (h >> 2);
+            h ^= (uint64_t)(uint32_t)key.b + 0x85EBCA77C2B2AE63ULL + (h << 6) + (h >> 2);
+            h ^= (uint64_t)(uint32_t)key.threshold + (h << 6) + (h >> 2);
+            h ^= (uint64_t)key.k + (h << 6) + (h >> 2);
+            return (size_t)h;
+        }
+    };
+
+    struct Entry {
+        CacheKey key{};
+        Image center{-1, "", 0, 0, 0};
+        double coverage = 0.0;                        // Raio coberto pelos candidatos
+        std::shared_ptr<const std::vector<Image>> candidates;
+        uint64_t generation = 0;                      // Muda quando o slot e reutilizado
+        bool referenced = false;
+        bool valid = false;
+    };
+
+    struct Registration {
+        size_t slot;
+        uint64_t generation;
+    };
+
+    std::unique_ptr<ImageDatabase> inner;
+    double quantum;
+    double thresholdStep;
+    double halfDiagonal;
+    size_t capacity;
+
+    mutable std::mutex cacheMutex;
+    mutable std::vector<Entry> slots;
+    mutable std::unordered_map<CacheKey, size_t, CacheKeyHash> lookup;
+    mutable std::vector<size_t> freeSlots;
+    mutable size_t clockHand = 0;
+    mutable uint64_t nextGeneration = 1;
+    mutable std::vector<std::vector<Registration>> registrations;  // Por celula da grade grossa
+    mutable QueryCacheStats counters;
+
+    static int invalidationCoord(double value) {
+        return std::min(INVALIDATION_GRID - 1, std::max(0, (int)std::floor(value / INVALIDATION_CELL)));
+    }
+
+    static size_t invalidationIndex(int r, int g, int b) {
+        return ((size_t)r * INVALIDATION_GRID + g) * INVALIDATION_GRID + b;
+    }
+
+    CacheKey makeKey(const Image& query, int32_t thresholdBucket, uint32_t k) const {
+        return CacheKey{(int32_t)std::floor(query.r / quantum), (int32_t)std::floor(query.g / quantum),
+                        (int32_t)std::floor(query.b / quantum), thresholdBucket, k};
+    }
+
+    Image centerOf(const CacheKey& key) const {
+        return Image(-1, "", (key.r + 0.5) * quantum, (key.g + 0.5) * quantum, (key.b + 0.5) * quantum);
+    }
+
+    // Candidatos guardados para key (nullptr = miss); chamado sem lock
+    std::shared_ptr<const std::vector<Image>> lookupCandidates(const CacheKey& key) const {
+        std::lock_guard<std::mutex> lock(cacheMutex);
+        auto it = lookup.find(key);
+        if (it == lookup.end()) return nullptr;
+        slots[it->second].referenced = true;
+        return slots[it->second].candidates;
+    }
+
+    // Chamado com cacheMutex travado
+    void releaseSlotLocked(size_t slot) const {
+        Entry& entry = slots[slot];
+        lookup.erase(entry.key);
+        entry.candidates.reset();
+        entry.valid = false;
+        freeSlots.push_back(slot);
+    }
+
+    // CLOCK: segunda chance para entradas referenciadas desde a ultima volta
+    size_t acquireSlotLocked() const {
+        if (!freeSlots.empty()) {
+            size_t slot = freeSlots.back();
+            freeSlots.pop_back();
+            return slot;
+        }
+        if (slots.size() < capacity) {
+            slots.emplace_back();
+            return slots.size() - 1;
+        }
+        while (slots[clockHand].referenced) {
+            slots[clockHand].referenced = false;
+            clockHand = (clockHand + 1) % slots.size();
+        }
+        size_t victim = clockHand;
+        clockHand = (clockHand + 1) % slots.size();
+        counters.evictions++;
+        releaseSlotLocked(victim);
+        freeSlots.pop_back();
+        return victim;
+    }
+
+    void registerCoverageLocked(size_t slot) const {
+        const Entry& entry = slots[slot];
+        auto range = [&](double value, int& low, int& high) {
+            low = invalidationCoord(value - entry.coverage);
+            high = invalidationCoord(value + entry.coverage);
+        };
+        int r0, r1, g0, g1, b0, b1;
+        range(entry.center.r, r0, r1);
+        range(entry.center.g, g0, g1);
+        range(entry.center.b, b0, b1);
+        for (int r = r0; r <= r1; r++) {
+            for (int g = g0; g <= g1; g++) {
+                for (int b = b0; b <= b1; b++) {
+                    auto& list = registrations[invalidationIndex(r, g, b)];
+                    list.push_back(Registration{slot, entry.generation});
+                    // Limpeza preguicosa: no maximo 'capacity' registros vivos por celula
+                    if (list.size() > 2 * capacity) compactLocked(list);
+                }
+            }
+        }
+    }
+
+    void compactLocked(std::vector<Registration>& list) const {
+        list.erase(std::remove_if(list.begin(), list.end(),
+                                  [this](const Registration& reg) {
+                                      const Entry& entry = slots[reg.slot];
+                                      return !entry.valid || entry.generation != reg.generation;
+                                  }),
+                   list.end());
+    }
+
+    // Guarda candidatos (se outra thread ja guardou a mesma chave, mantem a dela)
+    void storeCandidates(const CacheKey& key, const Image& center, double coverage,
+                         std::shared_ptr<const std::vector<Image>> candidates) const {
+        std::lock_guard<std::mutex> lock(cacheMutex);
+        if (lookup.count(key)) return;
+        size_t slot = acquireSlotLocked();
+        Entry& entry = slots[slot];
+        entry.key = key;
+        entry.center = center;
+        entry.coverage = coverage;
+        entry.candidates = std::move(candidates);
+        entry.generation = nextGeneration++;
+        entry.referenced = false;
+        entry.valid = true;
+        lookup[key] = slot;
+        registerCoverageLocked(slot);
+    }
+
+    void recordLatency(bool hit, std::chrono::high_resolution_clock::time_point start) const {
+        double ms = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+        std::lock_guard<std::mutex> lock(cacheMutex);
+        if (hit) {
+            counters.hits++;
+            counters.hitMs += ms;
+        } else {
+            counters.misses++;
+            counters.missMs += ms;
+        }
+    }
+
+    // Candidatos do cache (ou da estrutura, no miss) filtrados pelo raio exato
+    template <typename Visitor>
+    bool visitSimilar(const Image& query, double threshold, Visitor&& visit) const {
+        auto start = std::chrono::high_resolution_clock::now();
+        int32_t bucket = (int32_t)std::ceil(std::max(0.0, threshold) / thresholdStep);
+        CacheKey key = makeKey(query, bucket, 0);
+
+        std::shared_ptr<const std::vector<Image>> candidates = lookupCandidates(key);
+        bool hit = candidates != nullptr;
+        if (!hit) {
+            Image center = centerOf(key);
+            double coverage = bucket * thresholdStep + halfDiagonal;
+            candidates = std::make_shared<const std::vector<Image>>(inner->findSimilar(center, coverage));
+            // Busca interrompida (prazo/cancelamento) e parcial: nao entra no cache
+            if (!queryInterrupted()) storeCandidates(key, center, coverage, candidates);
+        }
+        if (hit) queryCounters.reset();
+
+        bool completed = true;
+        for (const auto& img : *candidates) {
+            queryCounters.pointTested();
+            if (query.distanceTo(img) <= threshold) {
+                queryCounters.pointAccepted();
+                if (!visit(img)) {
+                    completed = false;
+                    break;
+                }
+            }
+        }
+        recordLatency(hit, start);
+        return completed && !queryInterrupted();
+    }
+
+public:
+    static constexpr size_t DEFAULT_CAPACITY = 1024;
+    static constexpr double DEFAULT_QUANTUM = 1.0;         // Cores de 8 bits: cubo de 1 nivel
+    static constexpr double DEFAULT_THRESHOLD_STEP = 5.0;
+    static constexpr double INVALIDATION_CELL = 32.0;      // Grade grossa 8x8x8 sobre [0,256)
+    static constexpr int INVALIDATION_GRID = 8;
+
+    explicit CachedIndex(std::unique_ptr<ImageDatabase> _inner, size_t _capacity = DEFAULT_CAPACITY,
+                         double _quantum = DEFAULT_QUANTUM, double _thresholdStep = DEFAULT_THRESHOLD_STEP)
+        : inner(std::move(_inner)), quantum(_quantum > 0 ? _quantum : DEFAULT_QUANTUM),
+          thresholdStep(_thresholdStep > 0 ? _thresholdStep : DEFAULT_THRESHOLD_STEP),
+          halfDiagonal(quantum * std::sqrt(3.0) / 2.0), capacity(std::max<size_t>(1, _capacity)),
+          registrations((size_t)INVALIDATION_GRID * INVALIDATION_GRID * INVALIDATION_GRID) {
+        slots.reserve(capacity);
+    }
+
+    // Invalida so as entradas cuja bola de cobertura contem a nova imagem
+    void insert(const Image& img) override {
+        {
+            std::lock_guard<std::mutex> lock(cacheMutex);
+            auto& list = registrations[invalidationIndex(invalidationCoord(img.r), invalidationCoord(img.g),
+                                                         invalidationCoord(img.b))];
+            for (const Registration& reg : list) {
+                Entry& entry = slots[reg.slot];
+                if (!entry.valid || entry.generation != reg.generation) continue;
+                if (entry.center.distanceTo(img) <= entry.coverage) {
+                    releaseSlotLocked(reg.slot);
+                    counters.invalidations++;
+                }
+            }
+            compactLocked(list);
+        }
+        inner->insert(img);
+    }
+
+    std::vector<Image> findSimilar(const Image& query, double threshold) const override {
+        std::vector<Image> results;
+        visitSimilar(query, threshold, [&results](const Image& img) {
+            results.push_back(img);
+            return true;
+        });
+        return results;
+    }
+
+    // Streaming sobre os candidatos guardados; no miss a estrutura interna ainda
+    // materializa a cobertura inteira (e ela que vai para o cache)
+    bool forEachSimilar(const Image& query, double threshold, const SimilarVisitor& visit) const override {
+        return visitSimilar(query, threshold, visit);
+    }
+
+    std::vector<Image> findKNearest(const Image& query, size_t k) const override {
+        if (k == 0) return {};
+        auto start = std::chrono::high_resolution_clock::now();
+        CacheKey key = makeKey(query, -1, (uint32_t)std::min<size_t>(k, UINT32_MAX));
+
+        std::shared_ptr<const std::vector<Image>> candidates = lookupCandidates(key);
+        bool hit = candidates != nullptr;
+        if (!hit) {
+            Image center = centerOf(key);
+            std::vector<Image> nearest = inner->findKNearest(center, k);
+            double kthDistance = nearest.size() >= k ? center.distanceTo(nearest.back()) : kMaxRGBDistance;
+            double coverage = kthDistance + 2.0 * halfDiagonal;
+            candidates = std::make_shared<const std::vector<Image>>(inner->findSimilar(center, coverage));
+            if (!queryInterrupted()) storeCandidates(key, center, coverage, candidates);
+        }
+
+        std::vector<Image> results(*candidates);
+        sortByDistance(results, query);
+        if (results.size() > k) results.erase(results.begin() + k, results.end());
+        recordLatency(hit, start);
+        return results;
+    }
+
+    size_t size() const override { return inner->size(); }
+
+    std::string getName() const override {
+        return "Cache(" + inner->getName() + ", " + formatParam("cap", (double)capacity, 0) + ", " +
+               formatParam("q", quantum, 1) + ")";
+    }
+
+    void finishBuild() const override { inner->finishBuild(); }
+
+    MemoryUsage memoryUsage() const override {
+        MemoryUsage usage = inner->memoryUsage();
+        std::lock_guard<std::mutex> lock(cacheMutex);
+        MemoryUsage cached;
+        for (const auto& entry : slots) {
+            if (entry.valid) accountImageVector(*entry.candidates, cached);
+        }
+        usage.overheadBytes += cached.total() + slots.capacity() * sizeof(Entry) +
+                               lookup.size() * (sizeof(CacheKey) + sizeof(size_t) + 2 * sizeof(void*));
+        for (const auto& list : registrations) usage.overheadBytes += list.capacity() * sizeof(Registration);
+        return usage;
+    }
+
+    void printAnalysis() const override {
+        QueryCacheStats snapshot = stats();
+        size_t entries;
+        {
+            std::lock_guard<std::mutex> lock(cacheMutex);
+            entries = lookup.size();
+        }
+        std::cout << "\n=== ANALISE DO CACHE ===" << std::endl;
+        printf("Entradas: %zu/%zu | acertos: %llu (%.1f%%) | misses: %llu | substituicoes: %llu | "
+               "invalidacoes: %llu | economia estimada: %.2fms\n",
+               entries, capacity, (unsigned long long)snapshot.hits, snapshot.hitRate(),
+               (unsigned long long)snapshot.misses, (unsigned long long)snapshot.evictions,
+               (unsigned long long)snapshot.invalidations, snapshot.savedMs());
+        inner->printAnalysis();
+    }
+
+    QueryCacheStats stats() const {
+        std::lock_guard<std::mutex> lock(cacheMutex);
+        return counters;
+    }
+};
+
+#endif
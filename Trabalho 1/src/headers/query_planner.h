@@ -0,0 +1,531 @@
+#ifndef QUERY_PLANNER_H
+#define QUERY_PLANNER_H
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "image.h"
+
+// ============================================================================
+// PLANEJADOR DE CONSULTAS POR CUSTO (UMA ESTRUTURA POR CONSULTA)
+// ============================================================================
+/*
+FUNCIONALIDADE PAA: a estrutura vencedora muda com escala e threshold
+(resultados finais.txt: linear vence o hash em 10K, o hash vence de 50K em
+diante), e dentro de um mesmo indice muda com a regiao da consulta
+
+IDEIA:
+- O planejador guarda varios indices ja construidos (caminhos de acesso) com
+  os mesmos pontos, mais estatisticas leves do dataset: tamanho e um
+  histograma 3D de ocupacao (HIST_BINS^3 caixas de 8 unidades)
+- Para cada consulta (cor, threshold) estima o trabalho de cada caminho e
+  manda a consulta para o mais barato
+
+ESTIMATIVA (pontos estimados pelo histograma com somas prefixadas 3D,
+interpoladas dentro das caixas: contagem de qualquer caixa RGB em O(1)):
+- SCAN  (linear):   pontos = n
+- GRID  (hash):     sondas = celulas do cubo alinhado a grade,
+                    pontos = contagem desse cubo alinhado
+- TREE3 (octree):   lado tipico de folha s = cbrt(L / densidade local);
+                    pontos = contagem do cubo de lado 2(t + s/2),
+                    nos = pontos/L * 8/7 + 8 * log8(n/L)
+- TREE2 (quadtree): o mesmo em (R,G), com B inteiro
+- resultados = contagem do cubo do threshold * pi/6 (esfera/cubo)
+
+  custo(ns) = c0 + c1*pontos + c2*sondas + c3*resultados
+
+CALIBRACAO:
+- Cada consulta roteada e cronometrada: (features, custo real) entra no
+  acumulador de minimos quadrados do caminho usado e o log guarda previsto x
+  real (planLog, ultimos LOG_CAPACITY registros)
+- A cada REFIT_INTERVAL observacoes os coeficientes sao reajustados (4x4,
+  coeficientes negativos zerados); calibrate(amostra) roda a amostra em
+  TODOS os caminhos para partir de um modelo ajustado
+- Exploracao: 1 consulta em EXPLORE_INTERVAL vai para o caminho com menos
+  observacoes, se a previsao dele nao passar de EXPLORE_MAX_RATIO x a melhor
+
+CUSTO: memoria de todos os indices somada; insert alimenta todos.
+findSimilar continua const e reentrante (estado do modelo atras de mutex).
+*/
+
+enum class PlanPathKind { SCAN, GRID, TREE3, TREE2 };
+
+inline const char* planPathKindName(PlanPathKind kind) {
+    switch (kind) {
+        case PlanPathKind::SCAN: return "scan";
+        case PlanPathKind::GRID: return "grid";
+        case PlanPathKind::TREE3: return "tree3";
+        case PlanPathKind::TREE2: return "tree2";
+    }
+    return "?";
+}
+
+// Trabalho estimado de um caminho para uma consulta
+struct PlanFeatures {
+    static constexpr int COUNT = 4;
+    std::array<double, COUNT> values{};  // 1, pontos, sondas (celulas/nos), resultados
+
+    double points() const { return values[1]; }
+    double probes() const { return values[2]; }
+    double results() const { return values[3]; }
+};
+
+struct PlanLogEntry {
+    double r, g, b, threshold;
+    int path;             // Caminho escolhido (indice em paths)
+    double predictedUs;
+    double actualUs;
+    size_t results;
+    bool explored;        // Escolhido pela exploracao, nao pelo custo
+};
+
+struct PlanPathStats {
+    uint64_t queries = 0;
+    double predictedUs = 0.0;
+    double actualUs = 0.0;
+    double absErrorUs = 0.0;
+
+    // >1: o modelo subestima o caminho
+    double actualOverPredicted() const { return predictedUs > 0 ? actualUs / predictedUs : 0.0; }
+};
+
+class QueryPlanner : public ImageDatabase {
+public:
+    static constexpr int HIST_BINS = 32;
+    static constexpr double HIST_BIN_WIDTH = 256.0 / HIST_BINS;
+    static constexpr size_t LOG_CAPACITY = 65536;
+    static constexpr uint64_t REFIT_INTERVAL = 256;
+    static constexpr uint64_t EXPLORE_INTERVAL = 64;
+    static constexpr double EXPLORE_MAX_RATIO = 4.0;
+    static constexpr double kBallOverCube = 0.5235987755982988;  // pi/6
+
+private:
+    // Modelo: custo(ns) = coefficients . features; ajuste por minimos quadrados
+    struct PathModel {
+        std::array<double, PlanFeatures::COUNT> coefficients{};
+        std::array<std::array<double, PlanFeatures::COUNT>, PlanFeatures::COUNT> xtx{};
+        std::array<double, PlanFeatures::COUNT> xty{};
+        uint64_t observations = 0;
+        PlanPathStats stats;
+    };
+
+    struct AccessPath {
+        std::unique_ptr<ImageDatabase> db;
+        PlanPathKind kind;
+        double param;             // cellSize (GRID) ou capacidade de folha (TREE)
+        mutable PathModel model;  // Estado interno das consultas const (protegido por modelMutex)
+    };
+
+    std::vector<AccessPath> paths;
+    size_t count = 0;
+
+    // Histograma de ocupacao + somas prefixadas (reconstruidas na primeira consulta apos inserts)
+    std::vector<uint32_t> histogram;
+    mutable std::vector<double> prefix;  // (HIST_BINS+1)^3: pontos com bin < (i,j,k)
+    mutable std::atomic<bool> prefixStale{false};
+    mutable std::mutex prefixMutex;
+
+    mutable std::mutex modelMutex;
+    mutable std::vector<PlanLogEntry> log;
+    mutable size_t logNext = 0;
+    mutable uint64_t routedQueries = 0;
+    mutable uint64_t pendingObservations = 0;
+
+    static int histBin(double value) {
+        return std::clamp((int)(value / HIST_BIN_WIDTH), 0, HIST_BINS - 1);
+    }
+    static size_t prefixIndex(int i, int j, int k) {
+        return ((size_t)i * (HIST_BINS + 1) + j) * (HIST_BINS + 1) + k;
+    }
+
+    void ensurePrefix() const {
+        if (!prefixStale.load(std::memory_order_acquire)) return;
+        std::lock_guard<std::mutex> lock(prefixMutex);
+        if (!prefixStale.load(std::memory_order_relaxed)) return;
+        constexpr int side = HIST_BINS + 1;
+        prefix.assign((size_t)side * side * side, 0.0);
+        for (int i = 1; i < side; i++) {
+            for (int j = 1; j < side; j++) {
+                for (int k = 1; k < side; k++) {
+                    double cell = histogram[((size_t)(i - 1) * HIST_BINS + (j - 1)) * HIST_BINS + (k - 1)];
+                    prefix[prefixIndex(i, j, k)] = cell + prefix[prefixIndex(i - 1, j, k)] +
+                        prefix[prefixIndex(i, j - 1, k)] + prefix[prefixIndex(i, j, k - 1)] -
+                        prefix[prefixIndex(i - 1, j - 1, k)] - prefix[prefixIndex(i - 1, j, k - 1)] -
+                        prefix[prefixIndex(i, j - 1, k - 1)] + prefix[prefixIndex(i - 1, j - 1, k - 1)];
+                }
+            }
+        }
+        prefixStale.store(false, std::memory_order_release);
+    }
+
+    // Pontos estimados na caixa [low, high) por canal. Contagem acumulada (pontos
+    // com r < x, g < y, b < z) interpolada trilinearmente nas somas prefixadas
+    // (uniforme dentro da caixa do histograma); a caixa e a inclusao-exclusao dos
+    // 8 cantos, que por eixo vira 4 pesos: +interp(high) -interp(low)
+    double boxCount(const double low[3], const double high[3]) const {
+        int index[3][4];
+        double weight[3][4];
+        for (int axis = 0; axis < 3; axis++) {
+            for (int side = 0; side < 2; side++) {
+                double u = std::clamp((side ? high[axis] : low[axis]) / HIST_BIN_WIDTH, 0.0, (double)HIST_BINS);
+                int bin = std::min((int)u, HIST_BINS - 1);
+                double frac = u - bin, sign = side ? 1.0 : -1.0;
+                index[axis][2 * side] = bin;
+                index[axis][2 * side + 1] = bin + 1;
+                weight[axis][2 * side] = sign * (1 - frac);
+                weight[axis][2 * side + 1] = sign * frac;
+            }
+        }
+        double sum = 0.0;
+        for (int a = 0; a < 4; a++) {
+            for (int b = 0; b < 4; b++) {
+                double wab = weight[0][a] * weight[1][b];
+                if (wab == 0) continue;
+                const double* row = &prefix[prefixIndex(index[0][a], index[1][b], 0)];
+                for (int c = 0; c < 4; c++) sum += wab * weight[2][c] * row[index[2][c]];
+            }
+        }
+        return std::max(0.0, sum);
+    }
+
+    double cubeCount(const Image& center, double halfSide) const {
+        double low[3] = {center.r - halfSide, center.g - halfSide, center.b - halfSide};
+        double high[3] = {center.r + halfSide, center.g + halfSide, center.b + halfSide};
+        return boxCount(low, high);
+    }
+
+    // Resultados esperados: contagem do cubo do threshold x (esfera/cubo), igual para todos os caminhos
+    double expectedResults(const Image& query, double threshold) const {
+        return cubeCount(query, threshold) * kBallOverCube;
+    }
+
+    PlanFeatures estimate(const AccessPath& path, const Image& query, double threshold, double results) const {
+        PlanFeatures features;
+        features.values[0] = 1.0;
+        double n = (double)count;
+        features.values[3] = results;
+        const double center[3] = {query.r, query.g, query.b};
+
+        switch (path.kind) {
+            case PlanPathKind::SCAN:
+                features.values[1] = n;
+                break;
+            case PlanPathKind::GRID: {
+                // Cubo de celulas que a busca visita, alinhado a grade
+                double cell = path.param, low[3], high[3], probes = 1.0;
+                for (int axis = 0; axis < 3; axis++) {
+                    double first = std::floor((center[axis] - threshold) / cell);
+                    double last = std::floor((center[axis] + threshold) / cell);
+                    low[axis] = first * cell;
+                    high[axis] = (last + 1) * cell;
+                    probes *= last - first + 1;
+                }
+                features.values[1] = boxCount(low, high);
+                features.values[2] = probes;
+                break;
+            }
+            case PlanPathKind::TREE3:
+            case PlanPathKind::TREE2: {
+                // Folhas cruzadas pela borda da bola: cubo do threshold inflado por meia folha
+                bool planar = path.kind == PlanPathKind::TREE2;
+                int dims = planar ? 2 : 3;
+                double leaf = std::max(1.0, path.param);
+                double probe = std::max(threshold, HIST_BIN_WIDTH);
+                double low[3], high[3];
+                for (int axis = 0; axis < 3; axis++) {
+                    bool fullAxis = planar && axis == 2;
+                    low[axis] = fullAxis ? 0.0 : center[axis] - probe;
+                    high[axis] = fullAxis ? 256.0 : center[axis] + probe;
+                }
+                double density = std::max(boxCount(low, high), 1.0) / std::pow(2 * probe, dims);
+                double leafSide = std::clamp(std::pow(leaf / density, 1.0 / dims), 1.0, 256.0);
+                for (int axis = 0; axis < dims; axis++) {
+                    low[axis] = center[axis] - threshold - leafSide / 2;
+                    high[axis] = center[axis] + threshold + leafSide / 2;
+                }
+                double points = boxCount(low, high);
+                double fanout = planar ? 4.0 : 8.0;
+                double depth = std::log(std::max(n / leaf, 1.0)) / std::log(fanout);
+                features.values[1] = points;
+                features.values[2] = points / leaf * fanout / (fanout - 1) + fanout * depth;
+                break;
+            }
+        }
+        return features;
+    }
+
+    static double predictNs(const AccessPath& path, const PlanFeatures& features) {
+        double cost = 0.0;
+        for (int f = 0; f < PlanFeatures::COUNT; f++) cost += path.model.coefficients[f] * features.values[f];
+        return cost;
+    }
+
+    // Coeficientes iniciais (ns) ate a primeira calibracao
+    static std::array<double, PlanFeatures::COUNT> defaultCoefficients(PlanPathKind kind) {
+        switch (kind) {
+            case PlanPathKind::SCAN: return {500.0, 2.0, 0.0, 30.0};
+            case PlanPathKind::GRID: return {500.0, 4.0, 40.0, 30.0};
+            case PlanPathKind::TREE3:
+            case PlanPathKind::TREE2: return {500.0, 4.0, 15.0, 30.0};
+        }
+        return {};
+    }
+
+    static void observe(PathModel& model, const PlanFeatures& features, double actualNs) {
+        for (int i = 0; i < PlanFeatures::COUNT; i++) {
+            for (int j = 0; j < PlanFeatures::COUNT; j++) model.xtx[i][j] += features.values[i] * features.values[j];
+            model.xty[i] += features.values[i] * actualNs;
+        }
+        model.observations++;
+    }
+
+    // Minimos quadrados com coeficientes >= 0: resolve, zera as features com
+    // coeficiente negativo e resolve de novo so com as restantes
+    static void refit(PathModel& model) {
+        constexpr int F = PlanFeatures::COUNT;
+        if (model.observations < (uint64_t)F) return;
+        std::array<bool, F> active;
+        active.fill(true);
+        for (int f = 1; f < F; f++) active[f] = model.xtx[f][f] > 0;
+
+        std::array<double, F> solution{};
+        for (int round = 0; round < F; round++) {
+            // Sistema normal das features ativas, escalado pela diagonal (+ ridge pequeno)
+            double a[F][F + 1] = {};
+            std::array<double, F> scale{};
+            for (int i = 0; i < F; i++) scale[i] = active[i] ? std::sqrt(std::max(model.xtx[i][i], 1e-12)) : 1.0;
+            for (int i = 0; i < F; i++) {
+                for (int j = 0; j < F; j++) {
+                    a[i][j] = active[i] && active[j] ? model.xtx[i][j] / (scale[i] * scale[j]) : (i == j ? 1.0 : 0.0);
+                }
+                a[i][i] += 1e-9;
+                a[i][F] = active[i] ? model.xty[i] / scale[i] : 0.0;
+            }
+            for (int col = 0; col < F; col++) {
+                int pivot = col;
+                for (int row = col + 1; row < F; row++) {
+                    if (std::fabs(a[row][col]) > std::fabs(a[pivot][col])) pivot = row;
+                }
+                for (int k = 0; k <= F; k++) std::swap(a[col][k], a[pivot][k]);
+                if (std::fabs(a[col][col]) < 1e-15) return;  // Degenerado: mantem o modelo atual
+                for (int row = 0; row < F; row++) {
+                    if (row == col) continue;
+                    double factor = a[row][col] / a[col][col];
+                    for (int k = col; k <= F; k++) a[row][k] -= factor * a[col][k];
+                }
+            }
+            bool negative = false;
+            for (int i = 0; i < F; i++) {
+                solution[i] = active[i] ? a[i][F] / a[i][i] / scale[i] : 0.0;
+                if (active[i] && solution[i] < 0) {
+                    active[i] = false;
+                    negative = true;
+                }
+            }
+            if (!negative) break;
+        }
+        for (int i = 0; i < F; i++) model.coefficients[i] = std::max(0.0, solution[i]);
+    }
+
+    struct Plan {
+        int path = 0;
+        PlanFeatures features;
+        double predictedNs = 0.0;
+        bool explored = false;
+    };
+
+    Plan choosePath(const Image& query, double threshold) const {
+        ensurePrefix();
+        std::lock_guard<std::mutex> lock(modelMutex);
+        Plan plan;
+        int least = 0;
+        double results = expectedResults(query, threshold);
+        for (size_t p = 0; p < paths.size(); p++) {
+            PlanFeatures features = estimate(paths[p], query, threshold, results);
+            double predicted = predictNs(paths[p], features);
+            if (p == 0 || predicted < plan.predictedNs) {
+                plan.path = (int)p;
+                plan.features = features;
+                plan.predictedNs = predicted;
+            }
+            if (paths[p].model.observations < paths[least].model.observations) least = (int)p;
+        }
+
+        // Exploracao: o caminho menos observado, se nao for caro demais
+        if (++routedQueries % EXPLORE_INTERVAL == 0 && least != plan.path) {
+            PlanFeatures features = estimate(paths[least], query, threshold, results);
+            double predicted = predictNs(paths[least], features);
+            if (predicted <= EXPLORE_MAX_RATIO * plan.predictedNs) plan = Plan{least, features, predicted, true};
+        }
+        return plan;
+    }
+
+    void record(const Plan& plan, const Image& query, double threshold, double actualNs, size_t results) const {
+        std::lock_guard<std::mutex> lock(modelMutex);
+        PathModel& model = paths[plan.path].model;
+        observe(model, plan.features, actualNs);
+        model.stats.queries++;
+        model.stats.predictedUs += plan.predictedNs / 1000.0;
+        model.stats.actualUs += actualNs / 1000.0;
+        model.stats.absErrorUs += std::fabs(plan.predictedNs - actualNs) / 1000.0;
+
+        PlanLogEntry entry{query.r, query.g, query.b, threshold, plan.path, plan.predictedNs / 1000.0,
+                           actualNs / 1000.0, results, plan.explored};
+        if (log.size() < LOG_CAPACITY) log.push_back(entry);
+        else log[logNext] = entry;
+        logNext = (logNext + 1) % LOG_CAPACITY;
+
+        if (++pendingObservations >= REFIT_INTERVAL) {
+            pendingObservations = 0;
+            for (const auto& each : paths) refit(each.model);
+        }
+    }
+
+public:
+    QueryPlanner() : histogram((size_t)HIST_BINS * HIST_BINS * HIST_BINS, 0) { prefixStale = true; }
+
+    // Indice vazio; os pontos chegam por insert (alimenta todos os caminhos)
+    void addPath(std::unique_ptr<ImageDatabase> db, PlanPathKind kind, double param) {
+        AccessPath path;
+        path.db = std::move(db);
+        path.kind = kind;
+        path.param = param;
+        path.model.coefficients = defaultCoefficients(kind);
+        paths.push_back(std::move(path));
+    }
+
+    void insert(const Image& img) override {
+        for (auto& path : paths) path.db->insert(img);
+        histogram[((size_t)histBin(img.r) * HIST_BINS + histBin(img.g)) * HIST_BINS + histBin(img.b)]++;
+        count++;
+        prefixStale.store(true, std::memory_order_release);
+    }
+
+    std::vector<Image> findSimilar(const Image& query, double threshold) const override {
+        Plan plan = choosePath(query, threshold);
+        auto start = std::chrono::steady_clock::now();
+        std::vector<Image> results = paths[plan.path].db->findSimilar(query, threshold);
+        double actualNs = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+        if (!queryInterrupted()) record(plan, query, threshold, actualNs, results.size());
+        return results;
+    }
+
+    bool forEachSimilar(const Image& query, double threshold, const SimilarVisitor& visit) const override {
+        Plan plan = choosePath(query, threshold);
+        size_t visited = 0;
+        auto start = std::chrono::steady_clock::now();
+        bool completed = paths[plan.path].db->forEachSimilar(query, threshold, [&](const Image& img) {
+            visited++;
+            return visit(img);
+        });
+        double actualNs = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+        if (completed) record(plan, query, threshold, actualNs, visited);  // Parada antecipada nao calibra
+        return completed;
+    }
+
+    // Roda cada consulta x threshold em TODOS os caminhos e reajusta os modelos
+    void calibrate(const std::vector<Image>& queries, const std::vector<double>& thresholds) {
+        ensurePrefix();
+        std::lock_guard<std::mutex> lock(modelMutex);
+        for (const auto& query : queries) {
+            for (double threshold : thresholds) {
+                double expected = expectedResults(query, threshold);
+                for (auto& path : paths) {
+                    PlanFeatures features = estimate(path, query, threshold, expected);
+                    auto start = std::chrono::steady_clock::now();
+                    // Resultado so e liberado depois do cronometro, como numa consulta roteada
+                    std::vector<Image> found = path.db->findSimilar(query, threshold);
+                    observe(path.model, features,
+                            std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count());
+                }
+            }
+        }
+        for (auto& path : paths) refit(path.model);
+    }
+
+    // Previsao (us) de um caminho para uma consulta, com o modelo atual
+    double predictUs(size_t path, const Image& query, double threshold) const {
+        ensurePrefix();
+        std::lock_guard<std::mutex> lock(modelMutex);
+        return predictNs(paths[path], estimate(paths[path], query, threshold, expectedResults(query, threshold))) / 1000.0;
+    }
+
+    size_t pathCount() const { return paths.size(); }
+    const ImageDatabase& path(size_t index) const { return *paths[index].db; }
+
+    PlanPathStats pathStats(size_t index) const {
+        std::lock_guard<std::mutex> lock(modelMutex);
+        return paths[index].model.stats;
+    }
+
+    // Log em ordem cronologica (ultimos LOG_CAPACITY registros)
+    std::vector<PlanLogEntry> planLog() const {
+        std::lock_guard<std::mutex> lock(modelMutex);
+        if (log.size() < LOG_CAPACITY) return log;
+        std::vector<PlanLogEntry> ordered(log.begin() + logNext, log.end());
+        ordered.insert(ordered.end(), log.begin(), log.begin() + logNext);
+        return ordered;
+    }
+
+    void resetStats() {
+        std::lock_guard<std::mutex> lock(modelMutex);
+        for (auto& path : paths) path.model.stats = PlanPathStats{};
+        log.clear();
+        logNext = 0;
+    }
+
+    size_t size() const override { return count; }
+
+    std::string getName() const override {
+        std::string name = "Planner(";
+        for (size_t p = 0; p < paths.size(); p++) name += (p ? ", " : "") + paths[p].db->getName();
+        return name + ")";
+    }
+
+    void finishBuild() const override {
+        ensurePrefix();
+        for (const auto& path : paths) path.db->finishBuild();
+    }
+
+    MemoryUsage memoryUsage() const override {
+        MemoryUsage usage;
+        for (const auto& path : paths) {
+            MemoryUsage each = path.db->memoryUsage();
+            usage.nodeBytes += each.nodeBytes;
+            usage.bucketBytes += each.bucketBytes;
+            usage.payloadBytes += each.payloadBytes;
+            usage.overheadBytes += each.overheadBytes;
+        }
+        usage.overheadBytes += histogram.size() * sizeof(uint32_t) + prefix.capacity() * sizeof(double) +
+                               log.capacity() * sizeof(PlanLogEntry);
+        return usage;
+    }
+
+    void printAnalysis() const override {
+        std::cout << "\n=== ANALISE DO PLANEJADOR ===" << std::endl;
+        std::lock_guard<std::mutex> lock(modelMutex);
+        printf("%-36s %-8s %-9s %-12s %-12s %-10s %s\n", "Caminho", "Tipo", "Consultas", "Previsto(us)",
+               "Real(us)", "Real/Prev", "Modelo (ns: fixo, /ponto, /sonda, /resultado)");
+        for (const auto& path : paths) {
+            const PlanPathStats& stats = path.model.stats;
+            double queries = std::max<double>(1, stats.queries);
+            printf("%-36.36s %-8s %-9llu %-12.1f %-12.1f %-10.2f %.0f, %.2f, %.1f, %.1f\n",
+                   path.db->getName().c_str(), planPathKindName(path.kind), (unsigned long long)stats.queries,
+                   stats.predictedUs / queries, stats.actualUs / queries, stats.actualOverPredicted(),
+                   path.model.coefficients[0], path.model.coefficients[1], path.model.coefficients[2],
+                   path.model.coefficients[3]);
+        }
+    }
+};
+
+#endif
@@ -0,0 +1,173 @@
+#ifndef QUERY_PROTOCOL_H
+#define QUERY_PROTOCOL_H
+
+#include <atomic>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include "image.h"
+
+// ============================================================================
+// PROTOCOLO BINARIO DO SERVIDOR DE CONSULTAS (UNIX DOMAIN SOCKET)
+// ============================================================================
+/*
+Mensagens de tamanho fixo, sem texto nem parsing: o servidor le o buffer e
+reinterpreta direto. Ordem de bytes do host (socket local: cliente e servidor
+estao na mesma maquina).
+
+Requisicao (28 bytes):
+  requestId  uint32   devolvido na resposta (o cliente casa pedido/resposta)
+  type       uint8    1 = raio (threshold), 2 = kNN (k)
+  reserved   3 bytes
+  r, g, b    float
+  threshold  float    so para type 1
+  k          uint32   so para type 2
+
+Resposta (12 bytes + count × 16):
+  requestId  uint32
+  status     uint16   0 = ok, 1 = requisicao invalida
+  reserved   uint16
+  count      uint32
+  count × { id int32, r float, g float, b float }  (kNN: mais proximo primeiro)
+
+PIPELINING: o cliente pode enviar varias requisicoes sem esperar respostas.
+O servidor responde cada conexao NA ORDEM em que as requisicoes chegaram.
+O cliente precisa LER enquanto envia: com uma janela maior que os buffers do
+socket o servidor fica esperando o cliente consumir respostas, e um cliente
+que so le depois de escrever tudo trava os dois lados.
+*/
+
+enum WireQueryType : uint8_t {
+    WIRE_QUERY_RANGE = 1,
+    WIRE_QUERY_KNN = 2
+};
+
+enum WireStatus : uint16_t {
+    WIRE_STATUS_OK = 0,
+    WIRE_STATUS_BAD_REQUEST = 1
+};
+
+struct WireRequest {
+    uint32_t requestId;
+    uint8_t type;
+    uint8_t reserved[3];
+    float r, g, b;
+    float threshold;
+    uint32_t k;
+};
+
+struct WireResponseHeader {
+    uint32_t requestId;
+    uint16_t status;
+    uint16_t reserved;
+    uint32_t count;
+};
+
+struct WireImage {
+    int32_t id;
+    float r, g, b;
+};
+
+static_assert(sizeof(WireRequest) == 28, "layout do protocolo mudou");
+static_assert(sizeof(WireResponseHeader) == 12, "layout do protocolo mudou");
+static_assert(sizeof(WireImage) == 16, "layout do protocolo mudou");
+
+constexpr const char* kDefaultSocketPath = "/tmp/paa_query.sock";
+constexpr uint32_t kMaxKnn = 1u << 20;
+
+// Resposta montada aos poucos (streaming via forEachSimilar): beginResponse
+// grava o cabecalho com count 0, appendWireImage acrescenta cada imagem e
+// finishResponse corrige o count
+inline size_t beginResponse(std::vector<char>& out, uint32_t requestId, WireStatus status) {
+    WireResponseHeader header{requestId, status, 0, 0};
+    size_t offset = out.size();
+    out.resize(offset + sizeof(header));
+    std::memcpy(out.data() + offset, &header, sizeof(header));
+    return offset;
+}
+
+inline void appendWireImage(std::vector<char>& out, const Image& img) {
+    WireImage wire{img.id, (float)img.r, (float)img.g, (float)img.b};
+    size_t offset = out.size();
+    out.resize(offset + sizeof(wire));
+    std::memcpy(out.data() + offset, &wire, sizeof(wire));
+}
+
+inline void finishResponse(std::vector<char>& out, size_t headerOffset, uint32_t count) {
+    std::memcpy(out.data() + headerOffset + offsetof(WireResponseHeader, count), &count, sizeof(count));
+}
+
+// Acrescenta uma resposta completa (cabecalho + imagens) ao buffer de saida
+inline void appendResponse(std::vector<char>& out, uint32_t requestId, WireStatus status,
+                           const std::vector<Image>& images) {
+    size_t headerOffset = beginResponse(out, requestId, status);
+    out.reserve(out.size() + images.size() * sizeof(WireImage));
+    for (const auto& img : images) appendWireImage(out, img);
+    finishResponse(out, headerOffset, (uint32_t)images.size());
+}
+
+// ============================================================================
+// E/S EM SOCKETS
+// ============================================================================
+
+// Escreve tudo (write pode ser parcial); false se a conexao caiu
+inline bool writeAll(int fd, const char* data, size_t size) {
+    while (size > 0) {
+        ssize_t written = send(fd, data, size, MSG_NOSIGNAL);
+        if (written < 0 && errno == EINTR) continue;
+        if (written <= 0) return false;
+        data += written;
+        size -= (size_t)written;
+    }
+    return true;
+}
+
+// writeAll sem ficar preso em send: espera POLLOUT em fatias de pollMs e desiste
+// quando stop vira true (cliente que parou de ler nao segura o encerramento)
+inline bool writeAllUnless(int fd, const char* data, size_t size, const std::atomic<bool>& stop,
+                           int pollMs = 200) {
+    while (size > 0) {
+        if (stop.load(std::memory_order_relaxed)) return false;
+        pollfd waitFor{fd, POLLOUT, 0};
+        int ready = poll(&waitFor, 1, pollMs);
+        if (ready < 0 && errno != EINTR) return false;
+        if (ready <= 0) continue;
+        ssize_t written = send(fd, data, size, MSG_NOSIGNAL | MSG_DONTWAIT);
+        if (written < 0 && (errno == EINTR || errno == EAGAIN || errno == EWOULDBLOCK)) continue;
+        if (written <= 0) return false;
+        data += written;
+        size -= (size_t)written;
+    }
+    return true;
+}
+
+// Le exatamente size bytes; false em EOF ou erro
+inline bool readExact(int fd, char* data, size_t size) {
+    while (size > 0) {
+        ssize_t received = read(fd, data, size);
+        if (received < 0 && errno == EINTR) continue;
+        if (received <= 0) return false;
+        data += received;
+        size -= (size_t)received;
+    }
+    return true;
+}
+
+// Endereco AF_UNIX; false se o caminho nao cabe em sun_path
+inline bool makeSocketAddress(const std::string& path, sockaddr_un& address) {
+    std::memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    if (path.size() >= sizeof(address.sun_path)) return false;
+    std::memcpy(address.sun_path, path.c_str(), path.size() + 1);
+    return true;
+}
+
+#endif
@@ -0,0 +1,108 @@
+#ifndef QUERY_STATS_H
+#define QUERY_STATS_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+
+/**
+ * @brief Estatisticas internas de UMA consulta findSimilar
+ *
+ * Complementa printStats/printAnalysis (forma estatica da estrutura) com o trabalho
+ * efetivamente realizado pela busca:
+ * - nodesVisited / nodesPruned: nos de arvore examinados e descartados pela poda
+ * - cellsProbed / cellsEmpty: lookups na hash table e quantos nao acharam celula
+ * - pointsTested / pointsAccepted: calculos de distancia e resultados aceitos
+ */
+struct QueryStats {
+    uint64_t nodesVisited = 0;
+    uint64_t nodesPruned = 0;
+    uint64_t cellsProbed = 0;
+    uint64_t cellsEmpty = 0;
+    uint64_t pointsTested = 0;
+    uint64_t pointsAccepted = 0;
+
+    // Fracao do dataset descartada sem calcular distancia
+    double pointPruningRate(size_t datasetSize) const {
+        if (datasetSize == 0) return 0.0;
+        return 100.0 * (1.0 - static_cast<double>(pointsTested) / datasetSize);
+    }
+
+    // Fracao dos candidatos testados que realmente estavam dentro do threshold
+    double candidatePrecision() const {
+        return pointsTested > 0 ? 100.0 * pointsAccepted / pointsTested : 0.0;
+    }
+
+    double nodePruningRate() const {
+        return nodesVisited > 0 ? 100.0 * nodesPruned / nodesVisited : 0.0;
+    }
+
+    double emptyCellRate() const {
+        return cellsProbed > 0 ? 100.0 * cellsEmpty / cellsProbed : 0.0;
+    }
+
+    void print(size_t datasetSize) const {
+        printf("    Consulta: nos=%llu podados=%llu (%.1f%%) | celulas=%llu vazias=%llu (%.1f%%) | "
+               "testados=%llu aceitos=%llu (%.1f%%) | poda de pontos=%.2f%%\n",
+               (unsigned long long)nodesVisited, (unsigned long long)nodesPruned, nodePruningRate(),
+               (unsigned long long)cellsProbed, (unsigned long long)cellsEmpty, emptyCellRate(),
+               (unsigned long long)pointsTested, (unsigned long long)pointsAccepted, candidatePrecision(),
+               pointPruningRate(datasetSize));
+    }
+};
+
+#ifdef PAA_QUERY_STATS
+constexpr bool kQueryStatsEnabled = true;
+#else
+constexpr bool kQueryStatsEnabled = false;
+#endif
+
+/**
+ * @brief Contadores usados DENTRO das buscas
+ *
+ * Sem -DPAA_QUERY_STATS todos os metodos sao vazios (if constexpr) e o compilador
+ * elimina as chamadas: custo zero nas medicoes de tempo normais.
+ */
+class QueryCounters {
+private:
+    QueryStats current;
+
+public:
+    void reset() {
+        if constexpr (kQueryStatsEnabled) current = QueryStats();
+    }
+    void nodeVisited() {
+        if constexpr (kQueryStatsEnabled) current.nodesVisited++;
+    }
+    void nodePruned() {
+        if constexpr (kQueryStatsEnabled) current.nodesPruned++;
+    }
+    void cellProbed(bool found) {
+        if constexpr (kQueryStatsEnabled) {
+            current.cellsProbed++;
+            if (!found) current.cellsEmpty++;
+        }
+    }
+    void pointTested() {
+        if constexpr (kQueryStatsEnabled) current.pointsTested++;
+    }
+    void pointAccepted() {
+        if constexpr (kQueryStatsEnabled) current.pointsAccepted++;
+    }
+
+    // Soma contadores de uma parte da busca feita em outra thread
+    void merge(const QueryStats& part) {
+        if constexpr (kQueryStatsEnabled) {
+            current.nodesVisited += part.nodesVisited;
+            current.nodesPruned += part.nodesPruned;
+            current.cellsProbed += part.cellsProbed;
+            current.cellsEmpty += part.cellsEmpty;
+            current.pointsTested += part.pointsTested;
+            current.pointsAccepted += part.pointsAccepted;
+        }
+    }
+
+    const QueryStats& stats() const { return current; }
+};
+
+#endif
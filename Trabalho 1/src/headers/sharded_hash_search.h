@@ -0,0 +1,188 @@
+#ifndef SHARDED_HASH_SEARCH_H
+#define SHARDED_HASH_SEARCH_H
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "hash_search.h"
+
+// ============================================================================
+// ESTRUTURA 2b: HASH TABLE PARTICIONADA (INGESTAO PARALELA)
+// ============================================================================
+/*
+ANALISE PAA - SHARDED SPATIAL HASHING:
+
+PROBLEMA:
+- HashSearch insere num unico unordered_map: uma thread so, e proteger o
+  mapa inteiro com um lock serializaria qualquer ingestao paralela
+
+SOLUCAO:
+- Mesma grade (GridGeometry) e mesma busca por faixa de celulas do HashSearch
+- As celulas sao repartidas em M shards pelo hash da chave; cada shard tem
+  seu proprio unordered_map e seu proprio mutex
+- Duas threads so disputam lock quando caem no mesmo shard (prob. ~1/M)
+- Chave espalhada por hash multiplicativo: celulas vizinhas (mesma regiao
+  do espaco, tipicas de lotes de fotos parecidas) vao para shards diferentes
+- Cada shard ocupa linhas de cache proprias (alignas(64)): sem false sharing
+  entre os mutexes
+
+CONTRATO:
+- insert pode ser chamado por varias threads ao mesmo tempo
+- findSimilar e const e sem lock: vale depois da ingestao (ou com as
+  insercoes protegidas por concurrent_index.h)
+
+COMPLEXIDADES:
+- Insercao: O(1) esperado, escala com as threads ate a banda de memoria
+- Busca: identica ao HashSearch (+1 indirecao para achar o shard)
+- Espaco: O(n + m) + M tabelas de buckets
+*/
+
+class ShardedHashSearch : public ImageDatabase {
+private:
+    struct alignas(64) Shard {
+        std::mutex lock;
+        HashGrid grid;
+    };
+
+    GridGeometry geometry;
+    std::vector<std::unique_ptr<Shard>> shards;
+    int shardBits;
+    std::atomic<size_t> totalImages{0};
+
+    // Fibonacci hashing: bits altos do produto, bem misturados
+    size_t shardOf(uint64_t key) const {
+        if (shardBits == 0) return 0;
+        return (size_t)((key * 0x9E3779B97F4A7C15ULL) >> (64 - shardBits));
+    }
+
+    // Travessia comum a findSimilar e forEachSimilar; false = interrompida
+    template <typename Visitor>
+    bool visitSimilar(const Image& query, double threshold, Visitor&& visit) const {
+        int minR = geometry.toCell(query.r - threshold), maxR = geometry.toCell(query.r + threshold);
+        int minG = geometry.toCell(query.g - threshold), maxG = geometry.toCell(query.g + threshold);
+        int minB = geometry.toCell(query.b - threshold), maxB = geometry.toCell(query.b + threshold);
+
+        auto scanCell = [&](const std::vector<Image>& bucket) {
+            for (const auto& img : bucket) {
+                queryCounters.pointTested();
+                if (query.distanceTo(img) <= threshold) {
+                    queryCounters.pointAccepted();
+                    if (!visit(img)) return false;
+                }
+            }
+            return true;
+        };
+
+        // Bucket da proxima celula pedido (prefetch) antes de varrer o atual
+        PrefetchPipeline<Image> pipeline;
+        for (int cellR = minR; cellR <= maxR; cellR++) {
+            for (int cellG = minG; cellG <= maxG; cellG++) {
+                for (int cellB = minB; cellB <= maxB; cellB++) {
+                    if (stopRequested()) return false;
+                    uint64_t key = GridGeometry::packKey(cellR, cellG, cellB);
+                    const HashGrid& grid = shards[shardOf(key)]->grid;
+                    auto it = grid.find(key);
+                    queryCounters.cellProbed(it != grid.end());
+                    if (it != grid.end() && !pipeline.push(it->second, scanCell)) return false;
+                }
+            }
+        }
+        return pipeline.flush(scanCell);
+    }
+
+public:
+    static constexpr double DEFAULT_CELL_SIZE = HashSearch::DEFAULT_CELL_SIZE;
+    static constexpr int DEFAULT_SHARDS = 64;
+
+    // shardCount e arredondado para potencia de 2
+    ShardedHashSearch(double _cellSize = DEFAULT_CELL_SIZE, int shardCount = DEFAULT_SHARDS)
+        : geometry(_cellSize), shardBits(0) {
+        while ((1 << shardBits) < std::max(1, shardCount) && shardBits < 16) shardBits++;
+        for (int s = 0; s < (1 << shardBits); s++) shards.push_back(std::make_unique<Shard>());
+    }
+
+    void insert(const Image& img) override {
+        uint64_t key = geometry.keyOf(img);
+        Shard& shard = *shards[shardOf(key)];
+        {
+            std::lock_guard<std::mutex> guard(shard.lock);
+            shard.grid[key].push_back(img);
+        }
+        totalImages.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    // Ingestao paralela: cada thread insere um bloco contiguo de [begin, end)
+    void insertParallel(const Image* begin, const Image* end, int threadCount) {
+        size_t count = end - begin;
+        threadCount = std::max(1, std::min<int>(threadCount, (int)std::max<size_t>(1, count)));
+        std::vector<std::thread> workers;
+        for (int t = 0; t < threadCount; t++) {
+            const Image* first = begin + count * t / threadCount;
+            const Image* last = begin + count * (t + 1) / threadCount;
+            workers.emplace_back([this, first, last]() {
+                for (const Image* img = first; img != last; ++img) insert(*img);
+            });
+        }
+        for (auto& worker : workers) worker.join();
+    }
+
+    std::vector<Image> findSimilar(const Image& query, double threshold) const override {
+        std::vector<Image> results;
+        queryCounters.reset();
+        visitSimilar(query, threshold, [&results](const Image& img) {
+            results.push_back(img);
+            return true;
+        });
+        return results;
+    }
+
+    bool forEachSimilar(const Image& query, double threshold, const SimilarVisitor& visit) const override {
+        queryCounters.reset();
+        return visitSimilar(query, threshold, visit);
+    }
+
+    size_t size() const override { return totalImages.load(std::memory_order_relaxed); }
+    std::string getName() const override {
+        return "Sharded Hash (" + formatParam("cell", geometry.cellSize, 1) + ", " +
+               formatParam("shards", (double)shards.size(), 0) + ")";
+    }
+
+    MemoryUsage memoryUsage() const override {
+        MemoryUsage usage;
+        for (const auto& shard : shards) {
+            usage.overheadBytes += sizeof(Shard) + mallocOverheadBytes(sizeof(Shard));
+            accountHashGrid(shard->grid, usage);
+        }
+        return usage;
+    }
+
+    size_t getNumCells() const {
+        size_t cells = 0;
+        for (const auto& shard : shards) cells += shard->grid.size();
+        return cells;
+    }
+
+    void printAnalysis() const override {
+        size_t smallest = SIZE_MAX, largest = 0;
+        for (const auto& shard : shards) {
+            smallest = std::min(smallest, shard->grid.size());
+            largest = std::max(largest, shard->grid.size());
+        }
+        size_t cells = getNumCells();
+        std::cout << "  ANALISE SHARDED HASHING:" << std::endl;
+        std::cout << "    Shards: " << shards.size() << " | celulas por shard: min " << smallest
+                  << ", max " << largest << std::endl;
+        std::cout << "    Celulas ativas: " << cells << std::endl;
+        std::cout << "    Densidade media: " << (cells ? (double)size() / cells : 0.0) << " imagens/celula" << std::endl;
+        std::cout << "    Tamanho da celula: " << geometry.cellSize << std::endl;
+    }
+};
+
+#endif
@@ -0,0 +1,294 @@
+#ifndef SORTED_LINEAR_SEARCH_H
+#define SORTED_LINEAR_SEARCH_H
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "image.h"
+
+// ============================================================================
+// ESTRUTURA 1c: BUSCA LINEAR ORDENADA (MORTON + CAIXAS POR BLOCO)
+// ============================================================================
+/*
+ANALISE PAA - VARREDURA ORDENADA:
+
+CONCEITO:
+- Mesma forca bruta da LinearSearch, mas sobre o array ordenado pela curva de
+  Morton (Z-order): pontos vizinhos no array ficam vizinhos no espaco RGB
+- O array ordenado e cortado em blocos fixos de BLOCK_POINTS pontos; cada
+  bloco guarda a caixa RGB (min/max) dos seus pontos
+- A busca descarta o bloco inteiro quando a caixa esta a mais de threshold
+  da consulta; os blocos restantes sao varridos sem desvios sobre copias
+  float das coordenadas em SoA (r[], g[], b[]), que o compilador vetoriza
+
+CONSTRUCAO:
+- insert so acrescenta ao fim (cauda nao ordenada, varrida linearmente)
+- A cauda e "selada" (todas as imagens reordenadas) quando passa de
+  max(BLOCK_POINTS, ordenados / SEAL_FRACTION): no fluxo construir-depois-
+  consultar isso acontece UMA vez, na primeira consulta (ou em finishBuild/
+  memoryUsage/printAnalysis; o tempo da ultima selagem aparece em printAnalysis)
+- Chave Morton de 30 bits (10 por canal, passo 0.25); radix sort LSD de 3
+  passadas de 10 bits: O(n), sem comparacoes
+- Selar dentro de uma consulta const usa um mutex: leitores concorrentes que
+  chegam juntos esperam o primeiro terminar (o contrato continua o mesmo:
+  nenhuma consulta concorrente com insert)
+
+EXATIDAO:
+- O filtro float usa uma folga (FILTER_SLACK) e so seleciona candidatos; o
+  aceite final e query.distanceTo(img) <= threshold, como na LinearSearch.
+  O resultado e o mesmo conjunto (em outra ordem)
+- A poda por caixa e feita em double sobre os valores originais
+
+COMPLEXIDADES:
+- Insercao: O(1) amortizado (cada selagem e O(n) e a cauda cresce
+  geometricamente entre selagens)
+- Busca: O(n / BLOCK_POINTS) testes de caixa + O(B × BLOCK_POINTS) nos B
+  blocos que cruzam a bola + O(cauda)
+- Espaco: O(n): imagens + 12 bytes/ponto de coordenadas float + 48 bytes/bloco
+*/
+
+class SortedLinearSearch : public ImageDatabase {
+public:
+    static constexpr size_t BLOCK_POINTS = 256;
+    static constexpr size_t SEAL_FRACTION = 16;
+    static constexpr double FILTER_SLACK = 1e-3;  // >> erro de arredondamento float em [0,255]
+    static constexpr int MORTON_BITS = 10;        // bits por canal da chave
+
+private:
+    struct BlockBox {
+        double minR, minG, minB;
+        double maxR, maxG, maxB;
+
+        // Distancia minima (ao quadrado) da consulta a caixa; 0 se dentro
+        double minDistanceSquared(const Image& query) const {
+            double dr = std::max({minR - query.r, 0.0, query.r - maxR});
+            double dg = std::max({minG - query.g, 0.0, query.g - maxG});
+            double db = std::max({minB - query.b, 0.0, query.b - maxB});
+            return dr * dr + dg * dg + db * db;
+        }
+    };
+
+    // [0, sortedCount) em ordem Morton; [sortedCount, size) = cauda em ordem de insercao.
+    // Mutaveis: a selagem pode acontecer na primeira consulta (const)
+    mutable std::vector<Image> images;
+    mutable size_t sortedCount = 0;
+    mutable std::vector<float> coordR, coordG, coordB;  // SoA, preenchidos ate multiplo de BLOCK_POINTS
+    mutable std::vector<BlockBox> boxes;
+    mutable std::atomic<bool> sealPending{false};
+    mutable std::mutex sealMutex;
+    mutable size_t sealCount = 0;
+    mutable double lastSealMs = 0.0;
+
+    static uint32_t spreadBits(uint32_t value) {
+        // 10 bits -> bits nas posicoes 0, 3, 6, ... (intercalacao de Morton)
+        value &= 0x3FF;
+        value = (value | (value << 16)) & 0x030000FF;
+        value = (value | (value << 8)) & 0x0300F00F;
+        value = (value | (value << 4)) & 0x030C30C3;
+        value = (value | (value << 2)) & 0x09249249;
+        return value;
+    }
+
+    static uint32_t quantize(double value) {
+        double scaled = value * (1 << (MORTON_BITS - 8));
+        return (uint32_t)std::min(std::max(scaled, 0.0), (double)((1 << MORTON_BITS) - 1));
+    }
+
+    static uint32_t mortonKey(const Image& img) {
+        return (spreadBits(quantize(img.r)) << 2) | (spreadBits(quantize(img.g)) << 1) | spreadBits(quantize(img.b));
+    }
+
+    // LSD radix sort pelos 30 bits altos (chave Morton << 32 | posicao): 3 passadas estaveis de 10 bits
+    static void radixSortByKey(std::vector<uint64_t>& items) {
+        constexpr int RADIX_BITS = 10;
+        constexpr size_t BUCKETS = (size_t)1 << RADIX_BITS;
+        std::vector<uint64_t> scratch(items.size());
+        std::vector<size_t> offsets(BUCKETS);
+        for (int pass = 0; pass < 3; pass++) {
+            int shift = 32 + pass * RADIX_BITS;
+            std::fill(offsets.begin(), offsets.end(), 0);
+            for (uint64_t item : items) offsets[(item >> shift) & (BUCKETS - 1)]++;
+            size_t sum = 0;
+            for (size_t& offset : offsets) {
+                size_t count = offset;
+                offset = sum;
+                sum += count;
+            }
+            for (uint64_t item : items) scratch[offsets[(item >> shift) & (BUCKETS - 1)]++] = item;
+            items.swap(scratch);
+        }
+    }
+
+    // Reordena TODAS as imagens por Morton e refaz SoA e caixas: O(n)
+    void seal() const {
+        auto start = std::chrono::high_resolution_clock::now();
+        size_t n = images.size();
+
+        std::vector<uint64_t> keyed(n);
+        for (size_t i = 0; i < n; i++) keyed[i] = ((uint64_t)mortonKey(images[i]) << 32) | (uint64_t)i;
+        radixSortByKey(keyed);
+
+        std::vector<Image> sorted;
+        sorted.reserve(n);
+        for (uint64_t item : keyed) sorted.push_back(std::move(images[(uint32_t)item]));
+        images.swap(sorted);
+        sortedCount = n;
+
+        size_t blockCount = (n + BLOCK_POINTS - 1) / BLOCK_POINTS;
+        size_t padded = blockCount * BLOCK_POINTS;
+        // Preenchimento longe de [0,255]: nunca passa no filtro
+        coordR.assign(padded, 1e9f);
+        coordG.assign(padded, 1e9f);
+        coordB.assign(padded, 1e9f);
+        boxes.assign(blockCount, BlockBox{});
+        for (size_t block = 0; block < blockCount; block++) {
+            size_t first = block * BLOCK_POINTS, last = std::min(n, first + BLOCK_POINTS);
+            BlockBox& box = boxes[block];
+            box = {images[first].r, images[first].g, images[first].b, images[first].r, images[first].g, images[first].b};
+            for (size_t i = first; i < last; i++) {
+                const Image& img = images[i];
+                coordR[i] = (float)img.r;
+                coordG[i] = (float)img.g;
+                coordB[i] = (float)img.b;
+                box.minR = std::min(box.minR, img.r);
+                box.minG = std::min(box.minG, img.g);
+                box.minB = std::min(box.minB, img.b);
+                box.maxR = std::max(box.maxR, img.r);
+                box.maxG = std::max(box.maxG, img.g);
+                box.maxB = std::max(box.maxB, img.b);
+            }
+        }
+
+        sealCount++;
+        lastSealMs = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+    }
+
+    void ensureSealed() const {
+        if (!sealPending.load(std::memory_order_acquire)) return;
+        std::lock_guard<std::mutex> lock(sealMutex);
+        if (!sealPending.load(std::memory_order_relaxed)) return;
+        seal();
+        sealPending.store(false, std::memory_order_release);
+    }
+
+    // Filtro sem desvios sobre um bloco inteiro (trip count fixo: vetorizavel)
+    static void blockFilter(const float* r, const float* g, const float* b, float qr, float qg, float qb,
+                            float bound, uint8_t* pass) {
+        for (size_t i = 0; i < BLOCK_POINTS; i++) {
+            float dr = r[i] - qr, dg = g[i] - qg, db = b[i] - qb;
+            pass[i] = (dr * dr + dg * dg + db * db) <= bound;
+        }
+    }
+
+    // Travessia comum a findSimilar e forEachSimilar; false = interrompida
+    template <typename Visitor>
+    bool visitSimilar(const Image& query, double threshold, Visitor&& visit) const {
+        ensureSealed();
+        double boxBound = threshold * threshold;
+        float filterBound = (float)((threshold + FILTER_SLACK) * (threshold + FILTER_SLACK));
+        constexpr size_t blocksPerStopCheck = std::max<size_t>(1, STOP_CHECK_POINTS / BLOCK_POINTS);
+        uint8_t pass[BLOCK_POINTS];
+
+        for (size_t block = 0; block < boxes.size(); block++) {
+            if (block % blocksPerStopCheck == 0 && stopRequested()) return false;
+            queryCounters.nodeVisited();
+            if (boxes[block].minDistanceSquared(query) > boxBound) {
+                queryCounters.nodePruned();
+                continue;
+            }
+            size_t first = block * BLOCK_POINTS;
+            blockFilter(&coordR[first], &coordG[first], &coordB[first], (float)query.r, (float)query.g,
+                        (float)query.b, filterBound, pass);
+            size_t count = std::min(BLOCK_POINTS, sortedCount - first);
+            for (size_t i = 0; i < count; i++) {
+                if (!pass[i]) continue;
+                const Image& img = images[first + i];
+                queryCounters.pointTested();
+                if (query.distanceTo(img) <= threshold) {
+                    queryCounters.pointAccepted();
+                    if (!visit(img)) return false;
+                }
+            }
+        }
+
+        // Cauda ainda nao selada: forca bruta
+        for (size_t i = sortedCount; i < images.size(); i++) {
+            if ((i - sortedCount) % STOP_CHECK_POINTS == 0 && stopRequested()) return false;
+            const Image& img = images[i];
+            queryCounters.pointTested();
+            if (query.distanceTo(img) <= threshold) {
+                queryCounters.pointAccepted();
+                if (!visit(img)) return false;
+            }
+        }
+        return true;
+    }
+
+public:
+    void insert(const Image& img) override {
+        images.push_back(img);
+        size_t tail = images.size() - sortedCount;
+        if (tail > std::max(BLOCK_POINTS, sortedCount / SEAL_FRACTION)) {
+            sealPending.store(true, std::memory_order_release);
+        }
+    }
+
+    std::vector<Image> findSimilar(const Image& query, double threshold) const override {
+        std::vector<Image> results;
+        queryCounters.reset();
+        visitSimilar(query, threshold, [&results](const Image& img) {
+            results.push_back(img);
+            return true;
+        });
+        return results;
+    }
+
+    bool forEachSimilar(const Image& query, double threshold, const SimilarVisitor& visit) const override {
+        queryCounters.reset();
+        return visitSimilar(query, threshold, visit);
+    }
+
+    size_t size() const override { return images.size(); }
+    std::string getName() const override {
+        return "Linear Ordenado (" + formatParam("bloco", BLOCK_POINTS, 0) + ")";
+    }
+
+    // O(n): imagens + coordenadas float (payload duplicado, conta como no) + caixas.
+    // Sela antes, para medir o layout final
+    void finishBuild() const override { ensureSealed(); }
+
+    MemoryUsage memoryUsage() const override {
+        ensureSealed();
+        MemoryUsage usage;
+        accountImageVector(images, usage);
+        for (const auto* coords : {&coordR, &coordG, &coordB}) {
+            usage.nodeBytes += coords->capacity() * sizeof(float);
+            usage.overheadBytes += mallocOverheadBytes(coords->capacity() * sizeof(float));
+        }
+        usage.nodeBytes += boxes.capacity() * sizeof(BlockBox);
+        usage.overheadBytes += mallocOverheadBytes(boxes.capacity() * sizeof(BlockBox));
+        return usage;
+    }
+
+    void printAnalysis() const override {
+        ensureSealed();
+        double sideSum = 0.0;
+        for (const auto& box : boxes) {
+            sideSum += ((box.maxR - box.minR) + (box.maxG - box.minG) + (box.maxB - box.minB)) / 3.0;
+        }
+        std::cout << "  ANALISE VARREDURA ORDENADA (MORTON):" << std::endl;
+        std::cout << "    Blocos: " << boxes.size() << " de " << BLOCK_POINTS << " pontos" << std::endl;
+        std::cout << "    Lado medio da caixa: " << (boxes.empty() ? 0.0 : sideSum / boxes.size()) << std::endl;
+        std::cout << "    Selagens: " << sealCount << " (ultima: " << lastSealMs << "ms, "
+                  << sortedCount << " imagens)" << std::endl;
+        std::cout << "    Cauda nao ordenada: " << images.size() - sortedCount << " imagens" << std::endl;
+    }
+};
+
+#endif
@@ -0,0 +1,299 @@
+#ifndef SPATIAL_TREE_H
+#define SPATIAL_TREE_H
+
+#include <algorithm>
+#include <iostream>
+#include <memory>
+#include <stack>
+#include <string>
+#include <vector>
+
+#include "image.h"
+#include "prefetch.h"
+
+// ============================================================================
+// ARVORE ESPACIAL GENERICA (Octree e Quadtree, recursiva e iterativa)
+// ============================================================================
+/*
+Octree e Quadtree so diferem no no: quantos filhos, como escolher o filho
+(getChildIndex) e como podar (outsideRange). Insercao, busca e analise sao
+as mesmas, entao ficam aqui, parametrizadas por:
+
+- Node: OctreeNode (octree_search.h) ou QuadtreeNode (quadtree.h). Precisa de
+  images, children, isLeaf, createChildren(), getChildIndex(), outsideRange(),
+  include() (amplia a caixa ajustada que outsideRange usa) e das constantes
+  kName / kAnalysisTitle / kAnalysisNote.
+- Iterative: false = recursao (pilha de chamadas); true = pilha explicita.
+
+IMPLEMENTACAO ITERATIVA:
+- Evita recursao (stack overflow em datasets grandes)
+- Usa stack explicita (DFS: pilha menor que a fila de uma BFS)
+- Melhor controle de memoria
+*/
+
+template <typename Node, bool Iterative>
+class SpatialTreeSearch : public ImageDatabase {
+protected:
+    // Limite de subdivisao: evita recursao infinita com pontos repetidos
+    static constexpr int kMaxDepth = 15;
+
+    std::unique_ptr<Node> root;
+    size_t totalImages = 0;
+    int maxImagesPerNode;  // Parametro de balanceamento
+    int maxDepth = 0;
+
+    struct InsertItem {
+        Node* node;
+        Image img;
+        int depth;
+    };
+
+    // CRITERIO DE DIVISAO: muito cheio e nao muito profundo
+    bool shouldSplit(const Node* node, int depth) const {
+        return static_cast<int>(node->images.size()) > maxImagesPerNode && depth < kMaxDepth;
+    }
+
+    // INSERCAO RECURSIVA com divisao adaptativa
+    // Cada no do caminho (e cada filho na redistribuicao) amplia a caixa ajustada
+    void insertRecursive(Node* node, const Image& img, int depth) {
+        maxDepth = std::max(maxDepth, depth);
+        node->include(img);
+
+        if (node->isLeaf) {
+            node->images.push_back(img);
+            if (shouldSplit(node, depth)) {
+                node->createChildren();
+                // REDISTRIBUICAO: realocar todas as imagens
+                for (const auto& existingImg : node->images) {
+                    insertRecursive(node->children[node->getChildIndex(existingImg)].get(), existingImg, depth + 1);
+                }
+                node->images.clear();
+                node->images.shrink_to_fit();  // No interno nao guarda imagens
+            }
+        } else {
+            insertRecursive(node->children[node->getChildIndex(img)].get(), img, depth + 1);
+        }
+    }
+
+    // INSERCAO ITERATIVA: simulacao de recursao com stack
+    void insertIterative(const Image& img) {
+        std::stack<InsertItem> stack;
+        stack.push({root.get(), img, 0});
+
+        while (!stack.empty()) {
+            InsertItem item = stack.top();
+            stack.pop();
+            maxDepth = std::max(maxDepth, item.depth);
+            item.node->include(item.img);
+
+            if (item.node->isLeaf) {
+                item.node->images.push_back(item.img);
+                if (shouldSplit(item.node, item.depth)) {
+                    item.node->createChildren();
+                    // Cada imagem existente desce exatamente uma vez
+                    for (const auto& existingImg : item.node->images) {
+                        stack.push({item.node->children[item.node->getChildIndex(existingImg)].get(),
+                                    existingImg, item.depth + 1});
+                    }
+                    item.node->images.clear();
+                    item.node->images.shrink_to_fit();
+                }
+            } else {
+                stack.push({item.node->children[item.node->getChildIndex(item.img)].get(), item.img, item.depth + 1});
+            }
+        }
+    }
+
+    // Examinar todas as imagens de uma folha (distancia 3D completa)
+    // counters: os da thread (queryCounters) ou os de uma tarefa paralela
+    // visit: bool(const Image&), false interrompe a busca
+    template <typename Visitor>
+    bool scanLeaf(const Node* node, const Image& query, double threshold, QueryCounters& counters,
+                  Visitor& visit) const {
+        return scanImages(node->images, query, threshold, counters, visit);
+    }
+
+    template <typename Visitor>
+    static bool scanImages(const std::vector<Image>& images, const Image& query, double threshold,
+                           QueryCounters& counters, Visitor& visit) {
+        for (const auto& img : images) {
+            counters.pointTested();
+            if (query.distanceTo(img) <= threshold) {
+                counters.pointAccepted();
+                if (!visit(img)) return false;
+            }
+        }
+        return true;
+    }
+
+    // Folhas passam pelo pipeline de prefetch: a folha atual so e varrida
+    // quando a proxima chega (ou no flush), com o payload desta ja pedido
+    template <typename Visitor>
+    bool queueLeaf(const Node* node, PrefetchPipeline<Image>& pipeline, const Image& query, double threshold,
+                   Visitor& visit) const {
+        return pipeline.push(node->images, [&](const std::vector<Image>& images) {
+            return scanImages(images, query, threshold, queryCounters, visit);
+        });
+    }
+
+    // Filhos pedidos de uma vez antes de descer: outsideRange le as caixas deles
+    static void prefetchChildren(const Node* node) {
+        for (const auto& child : node->children) {
+            if (child) prefetchRead(child.get());
+        }
+    }
+
+    // BUSCA RECURSIVA com PODA ESPACIAL
+    template <typename Visitor>
+    bool searchRecursive(const Node* node, const Image& query, double threshold,
+                         PrefetchPipeline<Image>& pipeline, Visitor& visit) const {
+        if (!node) return true;
+        if (stopRequested()) return false;
+        queryCounters.nodeVisited();
+
+        // TECNICA DE PODA: regiao pode conter pontos proximos?
+        if (node->outsideRange(query, threshold)) {
+            queryCounters.nodePruned();
+            return true;  // Poda toda a subarvore
+        }
+
+        if (node->isLeaf) return queueLeaf(node, pipeline, query, threshold, visit);
+        prefetchChildren(node);
+        for (const auto& child : node->children) {
+            if (!searchRecursive(child.get(), query, threshold, pipeline, visit)) return false;
+        }
+        return true;
+    }
+
+    // BUSCA ITERATIVA (DFS com stack explicita)
+    template <typename Visitor>
+    bool searchIterative(const Image& query, double threshold, PrefetchPipeline<Image>& pipeline,
+                         Visitor& visit) const {
+        std::stack<const Node*> stack;
+        stack.push(root.get());
+
+        while (!stack.empty()) {
+            if (stopRequested()) return false;
+            const Node* node = stack.top();
+            stack.pop();
+
+            if (!node) continue;
+            queryCounters.nodeVisited();
+
+            if (node->outsideRange(query, threshold)) {
+                queryCounters.nodePruned();
+                continue;
+            }
+
+            if (node->isLeaf) {
+                if (!queueLeaf(node, pipeline, query, threshold, visit)) return false;
+            } else {
+                prefetchChildren(node);
+                for (const auto& child : node->children) {
+                    if (child) stack.push(child.get());
+                }
+            }
+        }
+        return true;
+    }
+
+    template <typename Visitor>
+    bool visitSimilar(const Image& query, double threshold, Visitor&& visit) const {
+        PrefetchPipeline<Image> pipeline;
+        bool completed;
+        if constexpr (Iterative) completed = searchIterative(query, threshold, pipeline, visit);
+        else completed = searchRecursive(root.get(), query, threshold, pipeline, visit);
+        return completed && pipeline.flush([&](const std::vector<Image>& images) {
+            return scanImages(images, query, threshold, queryCounters, visit);
+        });
+    }
+
+    // ANALISE ESTRUTURAL: contar nos da arvore (iterativo, serve aos dois modos)
+    void countNodes(int& leafCount, int& internalCount) const {
+        std::stack<const Node*> stack;
+        stack.push(root.get());
+        while (!stack.empty()) {
+            const Node* node = stack.top();
+            stack.pop();
+            if (node->isLeaf) {
+                leafCount++;
+            } else {
+                internalCount++;
+                for (const auto& child : node->children) {
+                    if (child) stack.push(child.get());
+                }
+            }
+        }
+    }
+
+public:
+    static constexpr int DEFAULT_LEAF_CAPACITY = 20;
+
+    SpatialTreeSearch(int leafCapacity = DEFAULT_LEAF_CAPACITY)
+        : root(Node::makeRoot()), maxImagesPerNode(leafCapacity) {}
+
+    void insert(const Image& img) override {
+        if constexpr (Iterative) insertIterative(img);
+        else insertRecursive(root.get(), img, 0);
+        totalImages++;
+    }
+
+    std::vector<Image> findSimilar(const Image& query, double threshold) const override {
+        std::vector<Image> results;
+        queryCounters.reset();
+        visitSimilar(query, threshold, [&results](const Image& img) {
+            results.push_back(img);
+            return true;
+        });
+        return results;
+    }
+
+    // Visitantes rodam sempre na thread chamadora (tambem nas variantes paralelas)
+    bool forEachSimilar(const Image& query, double threshold, const SimilarVisitor& visit) const override {
+        queryCounters.reset();
+        return visitSimilar(query, threshold, visit);
+    }
+
+    size_t size() const override { return totalImages; }
+
+    // Raiz sobre [lo, hi] (referencial PCA passa de 255); so com a arvore vazia
+    bool setDomain(double lo, double hi) override {
+        if (totalImages > 0) return false;
+        root = Node::makeRoot(lo, hi);
+        return true;
+    }
+
+    std::string getName() const override {
+        return std::string(Node::kName) + (Iterative ? " Iterativo (" : " Search (") +
+               formatParam("leaf", maxImagesPerNode, 0) + ")";
+    }
+
+    // O(n + nos): cada no carrega bounding box + ponteiros de filhos
+    MemoryUsage memoryUsage() const override {
+        MemoryUsage usage;
+        accountTree(root.get(), usage);
+        return usage;
+    }
+
+    void printAnalysis() const override {
+        int leafCount = 0, internalCount = 0;
+        countNodes(leafCount, internalCount);
+
+        std::cout << "  " << Node::kAnalysisTitle << ":" << std::endl;
+        std::cout << "    Total de imagens: " << totalImages << std::endl;
+        std::cout << "    Profundidade maxima: " << maxDepth << std::endl;
+        std::cout << "    Nos folha: " << leafCount << std::endl;
+        std::cout << "    Nos internos: " << internalCount << std::endl;
+        std::cout << "    Razao folha/interno: "
+                  << (internalCount > 0 ? static_cast<double>(leafCount) / internalCount : 0) << std::endl;
+        if (leafCount > 0) {
+            std::cout << "    Densidade media por folha: "
+                      << static_cast<double>(totalImages) / leafCount << " imagens" << std::endl;
+        }
+        if (Node::kAnalysisNote[0] != '\0') {
+            std::cout << "    Observacao: " << Node::kAnalysisNote << std::endl;
+        }
+    }
+};
+
+#endif
@@ -0,0 +1,619 @@
+#ifndef STATIC_INDEX_H
+#define STATIC_INDEX_H
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "image.h"
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+// ============================================================================
+// INDICES COM POLITICAS EM TEMPO DE COMPILACAO
+// ============================================================================
+/*
+As estruturas de ImageDatabase pagam uma chamada virtual por insert/findSimilar
+e fixam coordenadas double + distanceTo euclidiana. Aqui os mesmos algoritmos
+(linear, grade hash, octree/quadtree) sao templates parametrizados por:
+
+  Coord         uint8_t / float / double (uint8_t: 1 byte por canal, quantizado;
+                so aqui - as estruturas dinamicas guardam Image, sempre double)
+  Dims          dimensoes do ponto (RGB = 3)
+  Metric        EuclideanMetric / ManhattanMetric / ChebyshevMetric
+  CellSize      tamanho da celula da grade (constexpr)
+  LeafCapacity  maximo de pontos por folha (constexpr)
+  SplitDims     dimensoes usadas na subdivisao (3 = octree, 2 = quadtree)
+
+Com Dims, metrica e capacidades conhecidas o compilador desenrola o calculo de
+distancia e a poda e usa pilhas de tamanho fixo. StaticIndexAdapter embrulha
+qualquer indice na interface ImageDatabase para os drivers escolherem em tempo
+de execucao: uma chamada virtual por consulta, nenhuma por ponto.
+*/
+
+// ----------------------------------------------------------------------------
+// Politica de coordenada
+// ----------------------------------------------------------------------------
+template <typename Coord> struct CoordTraits;
+
+template <> struct CoordTraits<double> {
+    static constexpr const char* kName = "double";
+    static double encode(double value) { return value; }
+};
+
+template <> struct CoordTraits<float> {
+    static constexpr const char* kName = "float";
+    static float encode(double value) { return static_cast<float>(value); }
+};
+
+// Quantizacao para o inteiro mais proximo: erro maximo de 0.5 por canal
+template <> struct CoordTraits<uint8_t> {
+    static constexpr const char* kName = "uint8";
+    static uint8_t encode(double value) {
+        return static_cast<uint8_t>(std::lround(std::min(255.0, std::max(0.0, value))));
+    }
+};
+
+// ----------------------------------------------------------------------------
+// Politica de metrica: distancia acumulada dimensao a dimensao
+// ----------------------------------------------------------------------------
+/*
+accumulate combina a diferenca de uma dimensao; o ponto e aceito quando o
+acumulado <= bound(threshold). Aplicado as folgas de uma caixa, o mesmo
+acumulado e um limite inferior valido da distancia a qualquer ponto dentro
+dela, entao a poda serve para as tres metricas.
+*/
+struct EuclideanMetric {
+    static constexpr const char* kName = "L2";
+    static double accumulate(double acc, double diff) { return acc + diff * diff; }
+    static double bound(double threshold) { return threshold * threshold; }
+};
+
+struct ManhattanMetric {
+    static constexpr const char* kName = "L1";
+    static double accumulate(double acc, double diff) { return acc + std::abs(diff); }
+    static double bound(double threshold) { return threshold; }
+};
+
+struct ChebyshevMetric {
+    static constexpr const char* kName = "Linf";
+    static double accumulate(double acc, double diff) { return std::max(acc, std::abs(diff)); }
+    static double bound(double threshold) { return threshold; }
+};
+
+// ----------------------------------------------------------------------------
+// Pontos compactos e laco interno comum
+// ----------------------------------------------------------------------------
+template <typename Coord, int Dims>
+struct StaticPoint {
+    using CoordType = Coord;
+    static constexpr int kDims = Dims;
+    std::array<Coord, Dims> coords;
+    uint32_t slot;  // posicao da Image original no adaptador
+};
+
+template <int Dims>
+using QueryPoint = std::array<double, Dims>;
+
+inline double channelOf(const Image& img, int dim) {
+    return dim == 0 ? img.r : (dim == 1 ? img.g : img.b);
+}
+
+// Dims vem do tipo do ponto (QueryPoint<Point::kDims> nao participa da deducao)
+template <typename Metric, typename Point>
+inline bool pointWithin(const Point& point, const QueryPoint<Point::kDims>& query, double bound) {
+    double acc = 0.0;
+    for (int d = 0; d < Point::kDims; d++) {  // Dims constexpr: desenrolado
+        acc = Metric::accumulate(acc, static_cast<double>(point.coords[d]) - query[d]);
+    }
+    return acc <= bound;
+}
+
+// ----------------------------------------------------------------------------
+// Nucleo inteiro: coordenadas uint8, L2, consulta com canais inteiros
+// ----------------------------------------------------------------------------
+/*
+Com pontos e consulta inteiros a distancia ao quadrado e um inteiro exato
+(<= 3 × 255^2), entao acc <= bound equivale a acc <= floor(bound): o mesmo
+resultado do laco em double, sem nenhuma conversao para ponto flutuante.
+
+SSE2 (base de todo x86-64, sem flag extra): cada StaticPoint<uint8_t, 3> tem
+8 bytes (r, g, b, padding, slot). Duas cargas de 16 bytes trazem 4 pontos;
+unpack para 16 bits, subtrai a consulta, zera padding/slot e _mm_madd_epi16
+(pmaddwd) soma os quadrados aos pares; dois shuffles fecham as 4 distancias
+e uma comparacao gera a mascara de aceitos. Sem SSE2: mesmo calculo escalar.
+Consulta com canal fracionario (ou fora de [0,255]) segue pelo laco em double.
+*/
+template <typename Metric, typename Point>
+struct IntegerKernel {
+    static constexpr bool kEnabled = std::is_same<typename Point::CoordType, uint8_t>::value &&
+                                     std::is_same<Metric, EuclideanMetric>::value && Point::kDims == 3;
+};
+
+inline bool integralQuery(const QueryPoint<3>& query, std::array<int, 3>& out) {
+    for (int d = 0; d < 3; d++) {
+        if (query[d] < 0.0 || query[d] > 255.0 || query[d] != std::floor(query[d])) return false;
+        out[d] = static_cast<int>(query[d]);
+    }
+    return true;
+}
+
+template <typename Point>
+inline int integerDistanceSquared(const Point& point, const std::array<int, 3>& query) {
+    int dr = point.coords[0] - query[0], dg = point.coords[1] - query[1], db = point.coords[2] - query[2];
+    return dr * dr + dg * dg + db * db;
+}
+
+// Consulta preparada UMA vez por busca: limite da metrica e, quando o nucleo
+// inteiro se aplica, a consulta e o limite em inteiros (nao refeitos por folha/celula)
+template <typename Metric, typename Point>
+struct PointScan {
+    const QueryPoint<Point::kDims>& query;
+    double bound;
+    bool integral = false;
+    std::array<int, 3> integerQuery{};
+    int integerBound = 0;
+
+    PointScan(const QueryPoint<Point::kDims>& _query, double _bound) : query(_query), bound(_bound) {
+        if constexpr (IntegerKernel<Metric, Point>::kEnabled) {
+            integral = integralQuery(query, integerQuery);
+            integerBound = static_cast<int>(std::min(std::floor(bound), 1e9));
+        }
+    }
+};
+
+template <typename Metric, typename Point, typename Visitor>
+inline bool scanPointsInteger(const std::vector<Point>& points, const PointScan<Metric, Point>& scan,
+                              QueryCounters& counters, Visitor& visit) {
+    const std::array<int, 3>& query = scan.integerQuery;
+    size_t i = 0;
+#if defined(__SSE2__)
+    static_assert(sizeof(Point) == 8, "nucleo SSE2 assume pontos de 8 bytes");
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i query16 = _mm_setr_epi16((short)query[0], (short)query[1], (short)query[2], 0, 0, 0, 0, 0);
+    const __m128i keep = _mm_setr_epi16(-1, -1, -1, 0, 0, 0, 0, 0);
+    const __m128i limit = _mm_set1_epi32(scan.integerBound + 1);  // dist < bound + 1
+    auto squares = [&](__m128i bytes16) {  // 1 ponto (8 bytes -> 8 words): [dr²+dg², db², 0, 0]
+        __m128i diff = _mm_and_si128(_mm_sub_epi16(bytes16, query16), keep);
+        return _mm_madd_epi16(diff, diff);
+    };
+    for (; i + 4 <= points.size(); i += 4) {
+        __m128i first = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&points[i]));
+        __m128i second = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&points[i + 2]));
+        __m128 pair01 = _mm_castsi128_ps(_mm_unpacklo_epi64(squares(_mm_unpacklo_epi8(first, zero)),
+                                                            squares(_mm_unpackhi_epi8(first, zero))));
+        __m128 pair23 = _mm_castsi128_ps(_mm_unpacklo_epi64(squares(_mm_unpacklo_epi8(second, zero)),
+                                                            squares(_mm_unpackhi_epi8(second, zero))));
+        __m128i dist = _mm_add_epi32(_mm_castps_si128(_mm_shuffle_ps(pair01, pair23, _MM_SHUFFLE(2, 0, 2, 0))),
+                                     _mm_castps_si128(_mm_shuffle_ps(pair01, pair23, _MM_SHUFFLE(3, 1, 3, 1))));
+        int accepted = _mm_movemask_ps(_mm_castsi128_ps(_mm_cmplt_epi32(dist, limit)));
+        for (int lane = 0; lane < 4; lane++) counters.pointTested();
+        while (accepted) {
+            int lane = __builtin_ctz(accepted);
+            accepted &= accepted - 1;
+            counters.pointAccepted();
+            if (!visit(points[i + lane].slot)) return false;
+        }
+    }
+#endif
+    for (; i < points.size(); i++) {
+        counters.pointTested();
+        if (integerDistanceSquared(points[i], query) <= scan.integerBound) {
+            counters.pointAccepted();
+            if (!visit(points[i].slot)) return false;
+        }
+    }
+    return true;
+}
+
+// Varre um bloco contiguo de pontos chamando visit(slot) para cada aceito;
+// visit retorna false para interromper (propagado como false ate query)
+template <typename Metric, typename Point, typename Visitor>
+inline bool scanPoints(const std::vector<Point>& points, const PointScan<Metric, Point>& scan,
+                       QueryCounters& counters, Visitor&& visit) {
+    if constexpr (IntegerKernel<Metric, Point>::kEnabled) {
+        if (scan.integral) return scanPointsInteger(points, scan, counters, visit);
+    }
+    const QueryPoint<Point::kDims>& query = scan.query;
+    double bound = scan.bound;
+    for (const auto& point : points) {
+        counters.pointTested();
+        if (pointWithin<Metric>(point, query, bound)) {
+            counters.pointAccepted();
+            if (!visit(point.slot)) return false;
+        }
+    }
+    return true;
+}
+
+// Contabiliza um vector de pontos compactos (mesmo modelo de accountImageVector)
+template <typename Point>
+void accountPointVector(const std::vector<Point>& points, MemoryUsage& usage) {
+    usage.payloadBytes += points.size() * sizeof(Point);
+    if (points.capacity() > 0) {
+        usage.overheadBytes += (points.capacity() - points.size()) * sizeof(Point);
+        usage.overheadBytes += mallocOverheadBytes(points.capacity() * sizeof(Point));
+    }
+}
+
+// ============================================================================
+// 1. LINEAR
+// ============================================================================
+template <typename CoordT, int Dims, typename MetricT>
+class StaticLinearIndex {
+public:
+    using Coord = CoordT;
+    using Metric = MetricT;
+    using Point = StaticPoint<Coord, Dims>;
+    static constexpr int kDims = Dims;
+
+    void insert(const Point& point) { points.push_back(point); }
+
+    template <typename Visitor>
+    bool query(const QueryPoint<Dims>& query, double threshold, QueryCounters& counters, Visitor&& visit) const {
+        return scanPoints(points, PointScan<Metric, Point>(query, Metric::bound(threshold)), counters, visit);
+    }
+
+    static std::string name() { return "Linear"; }
+    static std::string params() { return ""; }
+    void accountMemory(MemoryUsage& usage) const { accountPointVector(points, usage); }
+
+private:
+    std::vector<Point> points;
+};
+
+// ============================================================================
+// 2. GRADE HASH (CellSize constexpr)
+// ============================================================================
+template <typename CoordT, int Dims, typename MetricT, int CellSize>
+class StaticGridIndex {
+public:
+    using Coord = CoordT;
+    using Metric = MetricT;
+    using Point = StaticPoint<Coord, Dims>;
+    static constexpr int kDims = Dims;
+
+    static_assert(Dims >= 1 && Dims <= 4, "chave de 64 bits: 16 bits por dimensao");
+    static_assert(CellSize >= 1, "CellSize deve ser positivo");
+    static constexpr int kGridSize = (255 + CellSize - 1) / CellSize;  // celulas por eixo
+
+    void insert(const Point& point) {
+        std::array<int, Dims> cell;
+        for (int d = 0; d < Dims; d++) cell[d] = toCell(static_cast<double>(point.coords[d]));
+        grid[packKey(cell)].push_back(point);
+    }
+
+    template <typename Visitor>
+    bool query(const QueryPoint<Dims>& query, double threshold, QueryCounters& counters, Visitor&& visit) const {
+        double bound = Metric::bound(threshold);
+        PointScan<Metric, Point> scan(query, bound);
+
+        // Faixa de celulas do cubo [query - threshold, query + threshold] (contem a bola das 3 metricas)
+        std::array<int, Dims> low, high, cell;
+        for (int d = 0; d < Dims; d++) {
+            low[d] = toCell(query[d] - threshold);
+            high[d] = toCell(query[d] + threshold);
+        }
+        cell = low;
+
+        while (true) {
+            auto it = grid.find(packKey(cell));
+            counters.cellProbed(it != grid.end());
+            if (it != grid.end() && !scanPoints(it->second, scan, counters, visit)) return false;
+
+            // Odometro: avanca a ultima dimensao, propagando o "vai um"
+            int d = Dims - 1;
+            while (d >= 0 && ++cell[d] > high[d]) {
+                cell[d] = low[d];
+                d--;
+            }
+            if (d < 0) break;
+        }
+        return true;
+    }
+
+    static std::string name() { return "Hash"; }
+    static std::string params() { return formatParam("cell", CellSize, 0); }
+
+    void accountMemory(MemoryUsage& usage) const {
+        size_t bucketArray = grid.bucket_count() * sizeof(void*);
+        usage.bucketBytes += bucketArray;
+        usage.overheadBytes += mallocOverheadBytes(bucketArray);
+        constexpr size_t entryBytes = sizeof(void*) + sizeof(typename Grid::value_type);
+        for (const auto& entry : grid) {
+            usage.nodeBytes += entryBytes;
+            usage.overheadBytes += mallocOverheadBytes(entryBytes);
+            accountPointVector(entry.second, usage);
+        }
+    }
+
+private:
+    using Grid = std::unordered_map<uint64_t, std::vector<Point>>;
+    Grid grid;
+
+    static int toCell(double value) {
+        return std::min(std::max(static_cast<int>(value / CellSize), 0), kGridSize - 1);
+    }
+
+    static uint64_t packKey(const std::array<int, Dims>& cell) {
+        uint64_t key = 0;
+        for (int d = 0; d < Dims; d++) key = (key << 16) | static_cast<uint64_t>(cell[d]);
+        return key;
+    }
+};
+
+// ============================================================================
+// 3. ARVORE 2^SplitDims-ARIA (octree: SplitDims = 3, quadtree: SplitDims = 2)
+// ============================================================================
+/*
+Nos em um unico vector (pool) com os filhos contiguos: um indice int32 no lugar
+de 2^SplitDims unique_ptr por no. A busca usa pilha de tamanho fixo, conhecida
+em tempo de compilacao a partir de kMaxDepth e kChildren.
+*/
+template <typename CoordT, int Dims, typename MetricT, int LeafCapacity, int SplitDims = Dims>
+class StaticTreeIndex {
+public:
+    using Coord = CoordT;
+    using Metric = MetricT;
+    using Point = StaticPoint<Coord, Dims>;
+    static constexpr int kDims = Dims;
+
+    static_assert(SplitDims >= 1 && SplitDims <= Dims, "SplitDims deve estar em [1, Dims]");
+    static_assert(LeafCapacity >= 1, "LeafCapacity deve ser positivo");
+    static constexpr int kChildren = 1 << SplitDims;
+    static constexpr int kMaxDepth = 15;
+    static constexpr int kStackSize = kMaxDepth * (kChildren - 1) + kChildren + 1;
+
+    StaticTreeIndex() {
+        Node root;
+        root.low.fill(0.0);
+        root.high.fill(255.0);
+        nodes.push_back(std::move(root));
+    }
+
+    void insert(const Point& point) { insertAt(0, point, 0); }
+
+    template <typename Visitor>
+    bool query(const QueryPoint<Dims>& query, double threshold, QueryCounters& counters, Visitor&& visit) const {
+        double bound = Metric::bound(threshold);
+        PointScan<Metric, Point> scan(query, bound);
+        std::array<int32_t, kStackSize> stack;
+        int top = 0;
+        stack[top++] = 0;
+
+        while (top > 0) {
+            const Node& node = nodes[stack[--top]];
+            counters.nodeVisited();
+
+            if (boxLowerBound(node, query) > bound) {
+                counters.nodePruned();
+                continue;
+            }
+
+            if (node.firstChild < 0) {
+                if (!scanPoints(node.points, scan, counters, visit)) return false;
+            } else {
+                for (int c = 0; c < kChildren; c++) stack[top++] = node.firstChild + c;
+            }
+        }
+        return true;
+    }
+
+    static std::string name() { return SplitDims == 3 ? "Octree" : (SplitDims == 2 ? "Quadtree" : "Tree"); }
+    static std::string params() { return formatParam("leaf", LeafCapacity, 0); }
+
+    void accountMemory(MemoryUsage& usage) const {
+        usage.nodeBytes += nodes.size() * sizeof(Node);
+        usage.overheadBytes += (nodes.capacity() - nodes.size()) * sizeof(Node);
+        usage.overheadBytes += mallocOverheadBytes(nodes.capacity() * sizeof(Node));
+        for (const auto& node : nodes) accountPointVector(node.points, usage);
+    }
+
+private:
+    struct Node {
+        std::array<double, SplitDims> low, high;
+        std::vector<Point> points;  // so folhas
+        int32_t firstChild = -1;    // filhos em nodes[firstChild .. firstChild + kChildren)
+    };
+    std::vector<Node> nodes;  // nodes[0] = raiz
+
+    // Distancia minima (na metrica) do query a caixa do no, nas dimensoes subdivididas
+    static double boxLowerBound(const Node& node, const QueryPoint<Dims>& query) {
+        double acc = 0.0;
+        for (int d = 0; d < SplitDims; d++) {
+            double gap = 0.0;
+            if (query[d] < node.low[d]) gap = node.low[d] - query[d];
+            else if (query[d] > node.high[d]) gap = query[d] - node.high[d];
+            acc = Metric::accumulate(acc, gap);
+        }
+        return acc;
+    }
+
+    int32_t childFor(const Node& node, const Point& point) const {
+        int index = 0;
+        for (int d = 0; d < SplitDims; d++) {
+            if (static_cast<double>(point.coords[d]) >= (node.low[d] + node.high[d]) / 2) index |= 1 << d;
+        }
+        return node.firstChild + index;
+    }
+
+    void insertAt(int32_t nodeIndex, const Point& point, int depth) {
+        while (nodes[nodeIndex].firstChild >= 0) {
+            nodeIndex = childFor(nodes[nodeIndex], point);
+            depth++;
+        }
+        nodes[nodeIndex].points.push_back(point);
+        if (static_cast<int>(nodes[nodeIndex].points.size()) > LeafCapacity && depth < kMaxDepth) {
+            split(nodeIndex, depth);
+        }
+    }
+
+    void split(int32_t nodeIndex, int depth) {
+        // Copias: push_back abaixo pode realocar o pool
+        std::array<double, SplitDims> low = nodes[nodeIndex].low, high = nodes[nodeIndex].high;
+        int32_t first = static_cast<int32_t>(nodes.size());
+
+        for (int c = 0; c < kChildren; c++) {
+            Node child;
+            for (int d = 0; d < SplitDims; d++) {
+                double mid = (low[d] + high[d]) / 2;
+                child.low[d] = (c >> d) & 1 ? mid : low[d];
+                child.high[d] = (c >> d) & 1 ? high[d] : mid;
+            }
+            nodes.push_back(std::move(child));
+        }
+
+        std::vector<Point> moved;
+        moved.swap(nodes[nodeIndex].points);  // no interno fica sem capacidade
+        nodes[nodeIndex].firstChild = first;
+        for (const auto& point : moved) insertAt(childFor(nodes[nodeIndex], point), point, depth + 1);
+    }
+};
+
+// ============================================================================
+// ADAPTADOR TYPE-ERASED PARA ImageDatabase
+// ============================================================================
+/*
+Guarda as Image originais (filename incluso) e passa ao indice apenas os
+pontos compactos com o slot de cada uma. findSimilar materializa as Image dos
+slots aceitos, entao o contrato e o mesmo das outras estruturas.
+*/
+template <typename Index>
+class StaticIndexAdapter : public ImageDatabase {
+private:
+    using Coord = typename Index::Coord;
+    using Metric = typename Index::Metric;
+    static constexpr int Dims = Index::kDims;
+    static_assert(Dims <= 3, "Image tem apenas 3 canais");
+
+    Index index;
+    std::vector<Image> images;
+
+public:
+    void insert(const Image& img) override {
+        typename Index::Point point;
+        for (int d = 0; d < Dims; d++) point.coords[d] = CoordTraits<Coord>::encode(channelOf(img, d));
+        point.slot = static_cast<uint32_t>(images.size());
+        images.push_back(img);
+        index.insert(point);
+    }
+
+    std::vector<Image> findSimilar(const Image& query, double threshold) const override {
+        QueryPoint<Dims> point;
+        for (int d = 0; d < Dims; d++) point[d] = channelOf(query, d);
+
+        std::vector<Image> results;
+        queryCounters.reset();
+        index.query(point, threshold, queryCounters, [&](uint32_t slot) {
+            results.push_back(images[slot]);
+            return true;
+        });
+        return results;
+    }
+
+    bool forEachSimilar(const Image& query, double threshold, const SimilarVisitor& visit) const override {
+        QueryPoint<Dims> point;
+        for (int d = 0; d < Dims; d++) point[d] = channelOf(query, d);
+
+        queryCounters.reset();
+        return index.query(point, threshold, queryCounters, [&](uint32_t slot) { return visit(images[slot]); });
+    }
+
+    size_t size() const override { return images.size(); }
+
+    std::string getName() const override {
+        std::string name = Index::name() + "<" + CoordTraits<Coord>::kName + "," + Metric::kName + ">";
+        std::string params = Index::params();
+        return params.empty() ? name : name + " (" + params + ")";
+    }
+
+    MemoryUsage memoryUsage() const override {
+        MemoryUsage usage;
+        index.accountMemory(usage);
+        accountImageVector(images, usage);
+        return usage;
+    }
+};
+
+// ============================================================================
+// SELECAO EM TEMPO DE EXECUCAO
+// ============================================================================
+/*
+Cada combinacao precisa ser instanciada: as listas abaixo definem quais
+valores de CellSize/LeafCapacity existem no binario (cobrem a grade do tuner
+e os padroes das estruturas dinamicas). Metrica fixa em L2 para os drivers;
+as outras ficam disponiveis para uso direto dos templates.
+*/
+using StaticCellSizes = std::integer_sequence<int, 4, 8, 12, 16, 25, 32, 48, 64>;
+using StaticLeafCapacities = std::integer_sequence<int, 4, 8, 16, 20, 32, 64, 128>;
+const std::vector<std::string> kStaticCoords = {"double", "float", "uint8"};
+
+template <typename T> struct TypeTag { using type = T; };
+
+template <int... Options>
+bool staticValueSupported(int value, std::integer_sequence<int, Options...>) {
+    return ((value == Options) || ...);
+}
+
+template <int... Options>
+std::string staticValueList(std::integer_sequence<int, Options...>) {
+    std::string text;
+    ((text += (text.empty() ? "" : ",") + std::to_string(Options)), ...);
+    return text;
+}
+
+// Chama make(std::integral_constant<int, V>) para o V igual a value (nullptr se nenhum)
+template <typename Make, int... Options>
+std::unique_ptr<ImageDatabase> dispatchStaticValue(int value, std::integer_sequence<int, Options...>, Make&& make) {
+    std::unique_ptr<ImageDatabase> result;
+    ((value == Options ? (result = make(std::integral_constant<int, Options>{}), true) : false) || ...);
+    return result;
+}
+
+template <typename Make>
+std::unique_ptr<ImageDatabase> dispatchStaticCoord(const std::string& coord, Make&& make) {
+    if (coord == "double") return make(TypeTag<double>{});
+    if (coord == "float") return make(TypeTag<float>{});
+    if (coord == "uint8") return make(TypeTag<uint8_t>{});
+    return nullptr;
+}
+
+// kind: linear / hash / octree / quadtree; nullptr se a combinacao nao foi instanciada
+inline std::unique_ptr<ImageDatabase> makeStaticIndex(const std::string& kind, const std::string& coord,
+                                                      int cellSize, int leafCapacity) {
+    return dispatchStaticCoord(coord, [&](auto coordTag) -> std::unique_ptr<ImageDatabase> {
+        using Coord = typename decltype(coordTag)::type;
+        if (kind == "linear") {
+            return std::make_unique<StaticIndexAdapter<StaticLinearIndex<Coord, 3, EuclideanMetric>>>();
+        }
+        if (kind == "hash") {
+            return dispatchStaticValue(cellSize, StaticCellSizes{}, [](auto cell) -> std::unique_ptr<ImageDatabase> {
+                return std::make_unique<StaticIndexAdapter<
+                    StaticGridIndex<Coord, 3, EuclideanMetric, decltype(cell)::value>>>();
+            });
+        }
+        if (kind == "octree" || kind == "quadtree") {
+            bool octree = kind == "octree";
+            return dispatchStaticValue(leafCapacity, StaticLeafCapacities{}, [octree](auto leaf) -> std::unique_ptr<ImageDatabase> {
+                if (octree) {
+                    return std::make_unique<StaticIndexAdapter<
+                        StaticTreeIndex<Coord, 3, EuclideanMetric, decltype(leaf)::value, 3>>>();
+                }
+                return std::make_unique<StaticIndexAdapter<
+                    StaticTreeIndex<Coord, 3, EuclideanMetric, decltype(leaf)::value, 2>>>();
+            });
+        }
+        return nullptr;
+    });
+}
+
+#endif
@@ -0,0 +1,174 @@
+#ifndef STRUCTURE_FACTORY_H
+#define STRUCTURE_FACTORY_H
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "image.h"
+#include "linear_search.h"
+#include "sorted_linear_search.h"
+#include "parallel_linear_search.h"
+#include "hash_search.h"
+#include "hash_dynamic_search.h"
+#include "sharded_hash_search.h"
+#include "hybrid_grid_search.h"
+#include "quantile_grid_search.h"
+#include "octree_search.h"
+#include "octree_iterative.h"
+#include "quadtree.h"
+#include "parallel_tree_search.h"
+#include "static_index.h"
+#include "query_planner.h"
+#include "pca_frame.h"
+
+// ============================================================================
+// FABRICA DE ESTRUTURAS (COMPARTILHADA PELOS EXECUTAVEIS)
+// ============================================================================
+/*
+Chave de linha de comando -> estrutura construida com seus parametros.
+Usada pelo benchmark (varreduras) e pelo servidor de consultas (uma estrutura).
+*/
+
+inline const std::vector<std::string> kStructureKeys = {
+    "linear", "hash", "hashdyn", "octree", "quadtree", "octree-iter", "quadtree-iter", "hash-sharded",
+    "linear-par", "octree-par", "quadtree-par", "linear-sorted", "hybrid", "hash-quantile",
+    "linear-t", "hash-t", "octree-t", "quadtree-t",  // templates de static_index.h
+    "planner"                                          // planejador sobre kPlannerDefaultPaths
+};
+
+// Caminhos do planejador quando escolhido por chave (benchmark --planner usa --structures)
+inline const std::vector<std::string> kPlannerDefaultPaths = {"linear", "hash", "octree-iter"};
+
+struct StructureVariant {
+    // Construtor em vez de agregado: {chave, cell, leaf} deixa os demais campos nos padroes
+    // sem listar todos (e sem -Wmissing-field-initializers a cada campo novo)
+    StructureVariant(std::string _key = "", double _cellSize = 0.0, int _leafCapacity = 0)
+        : key(std::move(_key)), cellSize(_cellSize), leafCapacity(_leafCapacity) {}
+
+    std::string key;
+    double cellSize = 0.0;   // 0 = nao se aplica
+    int leafCapacity = 0;    // 0 = nao se aplica
+    std::string coord;       // vazio = nao se aplica (so estruturas -t)
+    int shards = 0;          // 0 = nao se aplica (so hash-sharded)
+    int poolThreads = 0;     // 0 = pool compartilhado (so estruturas -par)
+    std::string frame;       // vazio/"rgb" = coordenadas originais; "pca" = PcaFrameIndex na frente
+};
+
+inline const std::vector<std::string> kFrames = {"rgb", "pca"};
+
+inline bool usesPool(const std::string& key) { return key.size() > 4 && key.compare(key.size() - 4, 4, "-par") == 0; }
+
+inline bool isStaticKey(const std::string& key) { return key.size() > 2 && key.compare(key.size() - 2, 2, "-t") == 0; }
+inline std::string staticKind(const std::string& key) { return key.substr(0, key.size() - 2); }
+inline bool usesCellSize(const std::string& key) {
+    return key == "hash" || key == "hashdyn" || key == "hash-t" || key == "hash-sharded" || key == "hybrid" ||
+           key == "hash-quantile";
+}
+inline bool usesLeafCapacity(const std::string& key) { return key.rfind("octree", 0) == 0 || key.rfind("quadtree", 0) == 0; }
+
+// Templates so existem para os valores instanciados em static_index.h
+inline bool staticVariantSupported(const StructureVariant& variant) {
+    if (usesCellSize(variant.key) && !staticValueSupported((int)std::lround(variant.cellSize), StaticCellSizes{})) {
+        printf("AVISO: %s sem instancia para cell=%.1f (disponiveis: %s)\n", variant.key.c_str(),
+               variant.cellSize, staticValueList(StaticCellSizes{}).c_str());
+        return false;
+    }
+    if (usesLeafCapacity(variant.key) && !staticValueSupported(variant.leafCapacity, StaticLeafCapacities{})) {
+        printf("AVISO: %s sem instancia para leaf=%d (disponiveis: %s)\n", variant.key.c_str(),
+               variant.leafCapacity, staticValueList(StaticLeafCapacities{}).c_str());
+        return false;
+    }
+    return true;
+}
+
+// --frame pca so sobre estruturas dinamicas: as -t tem raiz fixa em [0,255], podam pelas
+// caixas de particao (sem setDomain) e uint8 satura em 255 - resultados errados no referencial rodado
+inline bool frameSupported(const StructureVariant& variant) {
+    if (variant.frame != "pca" || !isStaticKey(variant.key)) return true;
+    printf("AVISO: %s nao aceita --frame pca (dominio fixo em [0,255]); use a versao dinamica\n",
+           variant.key.c_str());
+    return false;
+}
+
+// Parametros padrao de cada estrutura (0 = nao se aplica)
+inline double defaultCellSize(const std::string& key) {
+    if (!usesCellSize(key)) return 0.0;
+    if (key == "hybrid") return HybridGridSearch::DEFAULT_CELL_SIZE;
+    return key == "hashdyn" ? HashDynamicSearch::DEFAULT_CELL_SIZE : HashSearch::DEFAULT_CELL_SIZE;
+}
+
+inline int defaultLeafCapacity(const std::string& key) {
+    if (!usesLeafCapacity(key)) return 0;
+    return key.rfind("octree", 0) == 0 ? OctreeSearch::DEFAULT_LEAF_CAPACITY : QuadtreeSearch::DEFAULT_LEAF_CAPACITY;
+}
+
+// Modelo de custo do planejador para cada chave (linear-par/-t etc. caem no tipo da versao base)
+inline PlanPathKind plannerPathKind(const std::string& key) {
+    if (usesCellSize(key)) return PlanPathKind::GRID;
+    if (key.rfind("octree", 0) == 0) return PlanPathKind::TREE3;
+    if (key.rfind("quadtree", 0) == 0) return PlanPathKind::TREE2;
+    return PlanPathKind::SCAN;
+}
+
+inline std::unique_ptr<ImageDatabase> makeStructure(const StructureVariant& variant);
+
+inline std::unique_ptr<QueryPlanner> makePlanner(const std::vector<StructureVariant>& paths) {
+    auto planner = std::make_unique<QueryPlanner>();
+    for (const StructureVariant& path : paths) {
+        auto db = makeStructure(path);
+        if (!db) continue;
+        double param = usesCellSize(path.key) ? path.cellSize : (double)path.leafCapacity;
+        planner->addPath(std::move(db), plannerPathKind(path.key), param);
+    }
+    return planner;
+}
+
+inline std::unique_ptr<ImageDatabase> makeStructure(const StructureVariant& variant) {
+    if (variant.frame == "pca") {
+        if (!frameSupported(variant)) return nullptr;
+        StructureVariant base = variant;
+        base.frame.clear();
+        auto inner = makeStructure(base);
+        return inner ? std::make_unique<PcaFrameIndex>(std::move(inner)) : nullptr;
+    }
+    if (isStaticKey(variant.key)) {
+        return makeStaticIndex(staticKind(variant.key), variant.coord, (int)variant.cellSize, variant.leafCapacity);
+    }
+    if (variant.key == "planner") {
+        std::vector<StructureVariant> paths;
+        for (const auto& key : kPlannerDefaultPaths) {
+            paths.push_back({key, defaultCellSize(key), defaultLeafCapacity(key)});
+        }
+        return makePlanner(paths);
+    }
+    if (variant.key == "linear") return std::make_unique<LinearSearch>();
+    if (variant.key == "linear-sorted") return std::make_unique<SortedLinearSearch>();
+    if (usesPool(variant.key)) {
+        // --pool T: pool proprio com T-1 workers (a chamadora e a T-esima thread)
+        auto pool = variant.poolThreads > 0 ? std::make_shared<ThreadPool>(variant.poolThreads - 1)
+                                            : ThreadPool::shared();
+        if (variant.key == "linear-par") return std::make_unique<ParallelLinearSearch>(pool);
+        if (variant.key == "octree-par") return std::make_unique<OctreeParalelo>(variant.leafCapacity, pool);
+        if (variant.key == "quadtree-par") return std::make_unique<QuadtreeParalelo>(variant.leafCapacity, pool);
+    }
+    if (variant.key == "hash") return std::make_unique<HashSearch>(variant.cellSize);
+    if (variant.key == "hash-sharded") {
+        int shards = variant.shards > 0 ? variant.shards : ShardedHashSearch::DEFAULT_SHARDS;
+        return std::make_unique<ShardedHashSearch>(variant.cellSize, shards);
+    }
+    if (variant.key == "hashdyn") return std::make_unique<HashDynamicSearch>(variant.cellSize);
+    if (variant.key == "hybrid") return std::make_unique<HybridGridSearch>(variant.cellSize);
+    if (variant.key == "hash-quantile") return std::make_unique<QuantileGridSearch>(variant.cellSize);
+    if (variant.key == "octree") return std::make_unique<OctreeSearch>(variant.leafCapacity);
+    if (variant.key == "quadtree") return std::make_unique<QuadtreeSearch>(variant.leafCapacity);
+    if (variant.key == "octree-iter") return std::make_unique<OctreeIterativo>(variant.leafCapacity);
+    if (variant.key == "quadtree-iter") return std::make_unique<QuadtreeIterativo>(variant.leafCapacity);
+    return nullptr;
+}
+
+#endif
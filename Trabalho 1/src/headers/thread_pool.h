@@ -0,0 +1,191 @@
+#ifndef THREAD_POOL_H
+#define THREAD_POOL_H
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// ============================================================================
+// POOL DE THREADS PERSISTENTE COM ROUBO DE TAREFAS (WORK STEALING)
+// ============================================================================
+/*
+FUNCIONALIDADE PAA: Paralelismo dentro de UMA consulta
+
+- Criar threads a cada consulta custa dezenas de microssegundos por thread,
+  da mesma ordem de uma busca inteira em datasets medios: as threads sao
+  criadas uma vez e ficam dormindo numa condition_variable
+- parallelFor(count, body) reparte as tarefas em blocos contiguos, um bloco
+  na fila de cada worker (tarefas vizinhas tendem a tocar dados vizinhos)
+- Cada worker consome a propria fila pela frente; quando ela esvazia, ROUBA
+  do fim da fila de outro worker. Tarefas desbalanceadas (uma subarvore
+  muito maior que as outras) nao deixam threads paradas
+- A thread chamadora tambem rouba tarefas enquanto espera (nunca fica
+  parada, e um pool com 0 workers simplesmente roda tudo na chamadora)
+- Varias threads podem chamar parallelFor ao mesmo tempo, inclusive de
+  dentro de uma tarefa do proprio pool (aninhado: kNN de linear-par/-par
+  num lote do servidor); benchmark --selftest cobre esse caso
+- submit(task) enfileira uma tarefa avulsa e retorna na hora (consultas
+  assincronas, ver async_query.h)
+- body nao deve lancar excecoes
+
+Cada fila tem seu proprio mutex (mais simples que uma deque lock-free de
+Chase-Lev); a disputa so acontece durante um roubo.
+*/
+
+class ThreadPool {
+private:
+    using Task = std::function<void()>;
+
+    struct alignas(64) WorkerQueue {
+        std::mutex lock;
+        std::deque<Task> tasks;
+    };
+
+    std::vector<std::unique_ptr<WorkerQueue>> queues;  // Uma por worker
+    std::vector<std::thread> workers;
+    std::atomic<size_t> pendingTasks{0};
+    std::atomic<size_t> nextQueue{0};  // Rodizio das tarefas avulsas
+    std::mutex sleepMutex;
+    std::condition_variable wakeWorkers;
+    bool stopping = false;
+
+    bool popFront(WorkerQueue& queue, Task& task) {
+        std::lock_guard<std::mutex> lock(queue.lock);
+        if (queue.tasks.empty()) return false;
+        task = std::move(queue.tasks.front());
+        queue.tasks.pop_front();
+        return true;
+    }
+
+    bool stealBack(WorkerQueue& queue, Task& task) {
+        std::lock_guard<std::mutex> lock(queue.lock);
+        if (queue.tasks.empty()) return false;
+        task = std::move(queue.tasks.back());
+        queue.tasks.pop_back();
+        return true;
+    }
+
+    // Propria fila primeiro (self < 0: chamadora, so rouba); false se nao ha tarefa
+    // A chamadora percorre TODAS as filas: num parallelFor aninhado (worker chamando
+    // parallelFor) as subtarefas podem estar em qualquer fila, e esperar por elas sem
+    // ajudar travaria o pool
+    bool runOneTask(int self) {
+        Task task;
+        bool found = self >= 0 && popFront(*queues[self], task);
+        for (size_t k = 1; !found && k <= queues.size(); k++) {
+            size_t victim = (size_t)(self < 0 ? k - 1 : self + k) % queues.size();
+            found = stealBack(*queues[victim], task);
+        }
+        if (!found) return false;
+        pendingTasks.fetch_sub(1);
+        task();
+        return true;
+    }
+
+    void workerLoop(int self) {
+        while (true) {
+            if (runOneTask(self)) continue;
+            std::unique_lock<std::mutex> lock(sleepMutex);
+            wakeWorkers.wait(lock, [this]() { return stopping || pendingTasks.load() > 0; });
+            if (stopping && pendingTasks.load() == 0) return;
+        }
+    }
+
+public:
+    explicit ThreadPool(int workerCount) {
+        for (int w = 0; w < workerCount; w++) queues.push_back(std::make_unique<WorkerQueue>());
+        for (int w = 0; w < workerCount; w++) workers.emplace_back([this, w]() { workerLoop(w); });
+    }
+
+    ~ThreadPool() {
+        {
+            std::lock_guard<std::mutex> lock(sleepMutex);
+            stopping = true;
+        }
+        wakeWorkers.notify_all();
+        for (auto& worker : workers) worker.join();
+    }
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    // Threads que executam tarefas (workers + a chamadora)
+    int concurrency() const { return (int)workers.size() + 1; }
+
+    // Executa body(0..count-1) e retorna quando todas terminaram
+    void parallelFor(size_t count, const std::function<void(size_t)>& body) {
+        if (count == 0) return;
+        if (count == 1 || workers.empty()) {
+            for (size_t i = 0; i < count; i++) body(i);
+            return;
+        }
+
+        struct Completion {
+            std::atomic<size_t> remaining;
+            std::mutex mutex;
+            std::condition_variable done;
+        };
+        auto completion = std::make_shared<Completion>();
+        completion->remaining = count;
+
+        {
+            // Contado antes de enfileirar (runOneTask nunca decrementa abaixo de zero) e sob
+            // sleepMutex: nenhum worker perde o aviso entre testar o predicado e dormir
+            std::lock_guard<std::mutex> lock(sleepMutex);
+            pendingTasks.fetch_add(count);
+        }
+
+        // Bloco contiguo [i*W/count] por fila de worker
+        for (size_t i = 0; i < count; i++) {
+            WorkerQueue& queue = *queues[i * queues.size() / count];
+            std::lock_guard<std::mutex> lock(queue.lock);
+            queue.tasks.emplace_back([completion, &body, i]() {
+                body(i);
+                if (completion->remaining.fetch_sub(1) == 1) {
+                    std::lock_guard<std::mutex> doneLock(completion->mutex);
+                    completion->done.notify_all();
+                }
+            });
+        }
+        wakeWorkers.notify_all();
+
+        // A chamadora rouba tarefas ate nao sobrar nenhuma, depois espera as ultimas
+        while (completion->remaining.load() > 0 && runOneTask(-1)) {}
+        std::unique_lock<std::mutex> lock(completion->mutex);
+        completion->done.wait(lock, [&completion]() { return completion->remaining.load() == 0; });
+    }
+
+    // Tarefa avulsa, sem esperar; pool sem workers executa na propria chamadora
+    void submit(Task task) {
+        if (workers.empty()) {
+            task();
+            return;
+        }
+        {
+            std::lock_guard<std::mutex> lock(sleepMutex);
+            pendingTasks.fetch_add(1);
+        }
+        WorkerQueue& queue = *queues[nextQueue.fetch_add(1) % queues.size()];
+        {
+            std::lock_guard<std::mutex> lock(queue.lock);
+            queue.tasks.push_back(std::move(task));
+        }
+        wakeWorkers.notify_one();
+    }
+
+    // Pool do processo: um worker por nucleo alem da thread chamadora
+    static std::shared_ptr<ThreadPool> shared() {
+        static std::shared_ptr<ThreadPool> pool =
+            std::make_shared<ThreadPool>(std::max(0, (int)std::thread::hardware_concurrency() - 1));
+        return pool;
+    }
+};
+
+#endif
@@ -28,1138 +28,23 @@ Conceitos de PAA demonstrados:
 #include <string>
 #include <chrono>
 #include <cmath>
-#include <random>
 #include <algorithm>
-#include <unordered_map>
 #include <memory>
-#include <array>
-#include <stack>
-#include <queue>
-#include <filesystem>  // C++17 REQUIRED: Para contagem automática de imagens
 #include <fstream>     // Para carregar query fixa
-// OpenCV não disponível - implementação alternativa para extração de RGB
-// #include <opencv2/opencv.hpp>  // Para processar imagens reais
 
-// ============================================================================
-// REPRESENTAÇÃO DE DADOS - ESPAÇO RGB COMO PROBLEMA MULTIDIMENSIONAL
-// ============================================================================
-
-struct Image {
-    int id;
-    std::string filename;
-    double r, g, b;  // Coordenadas no espaço RGB (0-255)
-    
-    Image(int _id, const std::string& _filename, double _r, double _g, double _b) 
-        : id(_id), filename(_filename), r(_r), g(_g), b(_b) {}
-    
-    // MÉTRICA DE SIMILARIDADE: Distância Euclidiana no Espaço 3D
-    /*
-    ANÁLISE PAA:
-    - Função de distância define a métrica de similaridade
-    - Espaço RGB = R³ (3 dimensões)
-    - Distância euclidiana é métrica padrão para espaços contínuos
-    - Complexidade: O(1) para calcular distância entre 2 pontos
-    */
-    double distanceTo(const Image& other) const {
-        double dr = r - other.r;
-        double dg = g - other.g;
-        double db = b - other.b;
-        return sqrt(dr*dr + dg*dg + db*db);
-    }
-    
-    void print() const {
-        std::cout << "Image " << id << " (" << filename << "): "
-                  << "RGB(" << r << ", " << g << ", " << b << ")" << std::endl;
-    }
-};
-
-// ============================================================================
-// INTERFACE ABSTRATA - PADRÃO DE DESIGN PARA COMPARAÇÃO JUSTA
-// ============================================================================
-
-class ImageDatabase {
-public:
-    virtual ~ImageDatabase() = default;
-    
-    // Operacoes fundamentais para analise de complexidade
-    virtual void insert(const Image& img) = 0;
-    virtual std::vector<Image> findSimilar(const Image& query, double threshold) = 0;
-    virtual std::string getName() const = 0;
-};
-
-// ============================================================================
-// ESTRUTURA 1: BUSCA LINEAR (BASELINE)
-// ============================================================================
-/*
-ANÁLISE PAA - BUSCA LINEAR:
-
-CARACTERÍSTICAS:
-- Estrutura mais simples possível
-- Não há pré-processamento dos dados
-- Serve como baseline para comparação
-
-COMPLEXIDADES:
-- Inserção: O(1) - apenas adiciona ao final
-- Busca: O(n) - deve verificar todos os elementos
-- Espaço: O(n) - armazena apenas os dados
-
-TRADE-OFFS:
-- Vantagem: Implementação trivial, sem overhead
-- Desvantagem: Busca lenta para grandes datasets
-
-QUANDO USAR:
-- Datasets pequenos (n < 1000)
-- Quando implementação simples é prioridade
-- Como baseline para avaliar outras estruturas
-*/
-
-class LinearSearch : public ImageDatabase {
-private:
-    std::vector<Image> images;  // Array dinamico simples
-    
-public:
-    void insert(const Image& img) override {
-        // O(1) - inserção no final do array
-        images.push_back(img);
-    }
-    
-    std::vector<Image> findSimilar(const Image& query, double threshold) override {
-        std::vector<Image> results;
-        
-        // O(n) - FORÇA BRUTA: examina todos os elementos
-        for (const auto& img : images) {
-            double distance = query.distanceTo(img);  // O(1)
-            if (distance <= threshold) {
-                results.push_back(img);
-            }
-        }
-        
-        // O(k log k) onde k = número de resultados
-        std::sort(results.begin(), results.end(), 
-                 [&query](const Image& a, const Image& b) {
-                     return query.distanceTo(a) < query.distanceTo(b);
-                 });
-        
-        return results;
-    }
-    
-    std::string getName() const override {
-        return "Linear Search";
-    }
-    
-    size_t size() const { return images.size(); }
-};
-
-// ============================================================================
-// ESTRUTURA 2: HASH TABLE com SPATIAL HASHING
-// ============================================================================
-/*
-ANÁLISE PAA - SPATIAL HASHING:
-
-CONCEITO:
-- Divide o espaço RGB em células (grid 3D)
-- Cada celula e uma "bucket" na hash table
-- Imagens similares ficam em celulas proximas
-
-TECNICA DE INDEXACÃO:
-- Hash function: (r/cellSize, g/cellSize, b/cellSize)
-- Collision resolution: chaining (lista em cada celula)
-- Spatial locality: celulas vizinhas contem pontos proximos
-
-COMPLEXIDADES:
-- Insercao: O(1) esperado - hash + insert na lista
-- Busca: O(k) onde k = celulas examinadas × densidade
-- Espaco: O(n + m) onde m = numero de celulas ativas
-
-OTIMIZACÃO:
-- Cell size determina trade-off precisao vs performance
-- Muito pequeno: muitas celulas, overhead alto  
-- Muito grande: muitas comparacoes desnecessarias
-
-QUANDO USAR:
-- Datasets medios/grandes (n > 1000)
-- Distribuicao uniforme dos dados
-- Quando busca rapida e prioridade
-*/
-
-class HashSearch : public ImageDatabase {
-private:
-    double cellSize;  // Parametro de tunning do algoritmo
-    
-    // Hash Table: chave = coordenada da celula, valor = lista de imagens
-    std::unordered_map<std::string, std::vector<Image>> grid;
-    
-    // FUNCÃO HASH: Mapeia coordenada RGB para coordenada de celula
-    int rgbToCell(double value) const {
-        return static_cast<int>(value / cellSize);
-    }
-    
-    // CHAVE DA HASH TABLE: Serializa coordenadas 3D em string
-    std::string getCellKey(const Image& img) const {
-        int r_cell = rgbToCell(img.r);
-        int g_cell = rgbToCell(img.g);
-        int b_cell = rgbToCell(img.b);
-        return std::to_string(r_cell) + "," + 
-               std::to_string(g_cell) + "," + 
-               std::to_string(b_cell);
-    }
-    
-    std::string getCellKey(int r_cell, int g_cell, int b_cell) const {
-        return std::to_string(r_cell) + "," + 
-               std::to_string(g_cell) + "," + 
-               std::to_string(b_cell);
-    }
-    
-public:
-    HashSearch(double _cellSize = 30.0) : cellSize(_cellSize) {}
-    
-    void insert(const Image& img) override {
-        // O(1) esperado - hash + insert
-        std::string key = getCellKey(img);
-        grid[key].push_back(img);
-    }
-    
-    std::vector<Image> findSimilar(const Image& query, double threshold) override {
-        std::vector<Image> results;
-        
-        // OTIMIZACÃO ESPACIAL: calcular raio de busca em celulas
-        int query_r = rgbToCell(query.r);
-        int query_g = rgbToCell(query.g);
-        int query_b = rgbToCell(query.b);
-        
-        // Quantas celulas precisamos examinar baseado no threshold?
-        int cell_radius = static_cast<int>(ceil(threshold / cellSize));
-        
-        // BUSCA EM CUBO 3D: examina apenas celulas relevantes
-        for (int dr = -cell_radius; dr <= cell_radius; dr++) {
-            for (int dg = -cell_radius; dg <= cell_radius; dg++) {
-                for (int db = -cell_radius; db <= cell_radius; db++) {
-                    std::string key = getCellKey(query_r + dr, 
-                                               query_g + dg, 
-                                               query_b + db);
-                    
-                    auto it = grid.find(key);
-                    if (it != grid.end()) {
-                        // Examinar todas as imagens nesta celula
-                        for (const auto& img : it->second) {
-                            double distance = query.distanceTo(img);
-                            if (distance <= threshold) {
-                                results.push_back(img);
-                            }
-                        }
-                    }
-                }
-            }
-        }
-        
-        // Ordenar por distancia
-        std::sort(results.begin(), results.end(), 
-                 [&query](const Image& a, const Image& b) {
-                     return query.distanceTo(a) < query.distanceTo(b);
-                 });
-        
-        return results;
-    }
-    
-    std::string getName() const override {
-        return "Hash Search";
-    }
-    
-    // METRICA DE ANALISE: distribuicao de dados
-    size_t getNumCells() const { return grid.size(); }
-    
-    double getAverageCellSize() const {
-        if (grid.empty()) return 0;
-        
-        size_t totalImages = 0;
-        for (const auto& pair : grid) {
-            totalImages += pair.second.size();
-        }
-        return static_cast<double>(totalImages) / grid.size();
-    }
-    
-    void printAnalysis() const {
-        std::cout << "  ANALISE SPATIAL HASHING:" << std::endl;
-        std::cout << "    Celulas ativas: " << getNumCells() << std::endl;
-        std::cout << "    Densidade media: " << getAverageCellSize() << " imagens/celula" << std::endl;
-        std::cout << "    Tamanho da celula: " << cellSize << std::endl;
-    }
-};
-
-// ============================================================================
-// ESTRUTURA 3: OCTREE (ARVORE ESPACIAL 3D)
-// ============================================================================
-/*
-ANALISE PAA - OCTREE:
-
-CONCEITO:
-- Arvore de subdivisao espacial para espaco 3D
-- Cada no representa uma regiao cubica do espaco RGB
-- Divisao adaptativa baseada na densidade de dados
-
-PROPRIEDADES ESTRUTURAIS:
-- Cada no interno tem exatamente 8 filhos (octantes)
-- Nos folha contem as imagens da regiao
-- Profundidade varia conforme distribuicao dos dados
-
-ALGORITMO DE CONSTRUCÃO:
-1. Inserir ponto no no raiz
-2. Se no folha e nao cheio: adicionar ponto
-3. Se no folha e cheio: dividir em 8 octantes
-4. Redistribuir pontos pelos octantes apropriados
-5. Recursivamente inserir novo ponto
-
-COMPLEXIDADES:
-- Insercao: O(log n) esperado, O(h) onde h = altura
-- Busca: O(log n + k) onde k = resultados
-- Espaco: O(n + nos internos)
-
-TECNICA DE PODA (PRUNING):
-- Calcula distancia minima do query a regiao do no
-- Se > threshold, poda toda a subarvore
-- Evita examinar regioes distantes
-
-QUANDO USAR:
-- Datasets grandes (n > 10000)
-- Distribuicao nao-uniforme dos dados
-- Busca em alta dimensionalidade (ate ~10D)
-*/
-
-struct OctreeNode {
-    // BOUNDING BOX: regiao 3D que este no representa
-    double minR, maxR, minG, maxG, minB, maxB;
-    
-    std::vector<Image> images;  // Imagens nesta regiao (se folha)
-    std::array<std::unique_ptr<OctreeNode>, 8> children;  // 8 octantes
-    bool isLeaf;
-    
-    OctreeNode(double minR, double maxR, double minG, double maxG, 
-               double minB, double maxB)
-        : minR(minR), maxR(maxR), minG(minG), maxG(maxG), 
-          minB(minB), maxB(maxB), isLeaf(true) {
-        for (auto& child : children) {
-            child = nullptr;
-        }
-    }
-    
-    // TESTE DE CONTENCÃO: ponto esta nesta regiao?
-    bool contains(const Image& img) const {
-        return img.r >= minR && img.r <= maxR &&
-               img.g >= minG && img.g <= maxG &&
-               img.b >= minB && img.b <= maxB;
-    }
-    
-    // FUNCÃO DE INDEXACÃO: qual octante contem este ponto?
-    /*
-    TECNICA PAA: Mapeamento bit a bit
-    - Bit 2: R >= midR ? 1 : 0
-    - Bit 1: G >= midG ? 1 : 0  
-    - Bit 0: B >= midB ? 1 : 0
-    - Resulta em indice 0-7
-    */
-    int getChildIndex(const Image& img) const {
-        int index = 0;
-        double midR = (minR + maxR) / 2.0;
-        double midG = (minG + maxG) / 2.0;  
-        double midB = (minB + maxB) / 2.0;
-        
-        if (img.r >= midR) index |= 4;  // Bit 2
-        if (img.g >= midG) index |= 2;  // Bit 1
-        if (img.b >= midB) index |= 1;  // Bit 0
-        
-        return index;
-    }
-    
-    // SUBDIVISÃO ESPACIAL: criar 8 octantes filhos
-    void createChildren() {
-        double midR = (minR + maxR) / 2.0;
-        double midG = (minG + maxG) / 2.0;
-        double midB = (minB + maxB) / 2.0;
-        
-        // 8 octantes do cubo 3D
-        children[0] = std::make_unique<OctreeNode>(minR, midR, minG, midG, minB, midB);
-        children[1] = std::make_unique<OctreeNode>(minR, midR, minG, midG, midB, maxB);
-        children[2] = std::make_unique<OctreeNode>(minR, midR, midG, maxG, minB, midB);
-        children[3] = std::make_unique<OctreeNode>(minR, midR, midG, maxG, midB, maxB);
-        children[4] = std::make_unique<OctreeNode>(midR, maxR, minG, midG, minB, midB);
-        children[5] = std::make_unique<OctreeNode>(midR, maxR, minG, midG, minB, maxB);
-        children[6] = std::make_unique<OctreeNode>(midR, maxR, midG, maxG, minB, midB);
-        children[7] = std::make_unique<OctreeNode>(midR, maxR, midG, maxG, minB, maxB);
-        
-        isLeaf = false;
-    }
-};
-
-class OctreeSearch : public ImageDatabase {
-private:
-    std::unique_ptr<OctreeNode> root;
-    int maxImagesPerNode;  // Parametro de balanceamento
-    int totalImages;
-    int maxDepth;
-    
-    // INSERCÃO RECURSIVA com divisao adaptativa
-    void insertRecursive(OctreeNode* node, const Image& img, int depth = 0) {
-        maxDepth = std::max(maxDepth, depth);
-        
-        if (node->isLeaf) {
-            node->images.push_back(img);
-            
-            // CRITERIO DE DIVISÃO: muito cheio e nao muito profundo (aumentado limite para mais precisão)
-            if (static_cast<int>(node->images.size()) > maxImagesPerNode && depth < 25) {
-                node->createChildren();
-                
-                // REDISTRIBUICÃO: realocar todas as imagens
-                for (const auto& existingImg : node->images) {
-                    int childIdx = node->getChildIndex(existingImg);
-                    insertRecursive(node->children[childIdx].get(), existingImg, depth + 1);
-                }
-                
-                node->images.clear();  // No nao e mais folha
-            }
-        } else {
-            // Navegar para o octante apropriado
-            int childIdx = node->getChildIndex(img);
-            insertRecursive(node->children[childIdx].get(), img, depth + 1);
-        }
-    }
-    
-    // BUSCA RECURSIVA com PODA ESPACIAL
-    void searchRecursive(OctreeNode* node, const Image& query, double threshold, 
-                        std::vector<Image>& results) const {
-        if (!node) return;
-        
-        // TECNICA DE PODA: regiao pode conter pontos proximos?
-        if (!nodeIntersectsQueryRadius(node, query, threshold)) {
-            return;  // Poda toda a subarvore
-        }
-        
-        if (node->isLeaf) {
-            // Examinar todas as imagens nesta folha
-            for (const auto& img : node->images) {
-                double distance = query.distanceTo(img);
-                if (distance <= threshold) {
-                    results.push_back(img);
-                }
-            }
-        } else {
-            // Recursivamente buscar nos filhos
-            for (const auto& child : node->children) {
-                if (child) {
-                    searchRecursive(child.get(), query, threshold, results);
-                }
-            }
-        }
-    }
-    
-    // GEOMETRIC PRUNING: distancia minima do query ao bounding box
-    /*
-    TECNICA PAA: Distancia ponto-retangulo em 3D
-    - Se query esta dentro do box: distancia = 0
-    - Caso contrario: distancia = sqrt(soma dos quadrados das diferencas)
-    */
-    bool nodeIntersectsQueryRadius(OctreeNode* node, const Image& query, double threshold) const {
-        double minDistSq = 0.0;
-        
-        // Componente R
-        if (query.r < node->minR) {
-            double diff = node->minR - query.r;
-            minDistSq += diff * diff;
-        } else if (query.r > node->maxR) {
-            double diff = query.r - node->maxR;  
-            minDistSq += diff * diff;
-        }
-        
-        // Componente G
-        if (query.g < node->minG) {
-            double diff = node->minG - query.g;
-            minDistSq += diff * diff;
-        } else if (query.g > node->maxG) {
-            double diff = query.g - node->maxG;
-            minDistSq += diff * diff;
-        }
-        
-        // Componente B
-        if (query.b < node->minB) {
-            double diff = node->minB - query.b;
-            minDistSq += diff * diff;
-        } else if (query.b > node->maxB) {
-            double diff = query.b - node->maxB;
-            minDistSq += diff * diff;
-        }
-        
-        return sqrt(minDistSq) <= threshold * 4.0;  // RELAXAR MUITO MAIS a poda - sacrifica tempo por precisão
-    }
-    
-    // ANALISE ESTRUTURAL: contar nos da arvore
-    void countNodes(OctreeNode* node, int& leafCount, int& internalCount) const {
-        if (!node) return;
-        
-        if (node->isLeaf) {
-            leafCount++;
-        } else {
-            internalCount++;
-            for (const auto& child : node->children) {
-                countNodes(child.get(), leafCount, internalCount);
-            }
-        }
-    }
-    
-public:
-    OctreeSearch(int maxImages = 1) 
-        : maxImagesPerNode(maxImages), totalImages(0), maxDepth(0) {
-        // Inicializar com espaco RGB completo [0,255]³
-        root = std::make_unique<OctreeNode>(0, 255, 0, 255, 0, 255);
-    }
-    
-    void insert(const Image& img) override {
-        insertRecursive(root.get(), img);
-        totalImages++;
-    }
-    
-    std::vector<Image> findSimilar(const Image& query, double threshold) override {
-        std::vector<Image> results;
-        searchRecursive(root.get(), query, threshold, results);
-        
-        std::sort(results.begin(), results.end(), 
-                 [&query](const Image& a, const Image& b) {
-                     return query.distanceTo(a) < query.distanceTo(b);
-                 });
-        
-        return results;
-    }
-    
-    std::string getName() const override {
-        return "Octree Search";
-    }
-    
-    void printAnalysis() const {
-        int leafCount = 0, internalCount = 0;
-        countNodes(root.get(), leafCount, internalCount);
-        
-        std::cout << "  ANALISE OCTREE 3D:" << std::endl;
-        std::cout << "    Total de imagens: " << totalImages << std::endl;
-        std::cout << "    Profundidade maxima: " << maxDepth << std::endl;
-        std::cout << "    Nos folha: " << leafCount << std::endl;
-        std::cout << "    Nos internos: " << internalCount << std::endl;
-        std::cout << "    Fator de ramificacao medio: " 
-                  << (internalCount > 0 ? static_cast<double>(leafCount) / internalCount : 0) << std::endl;
-        
-        if (leafCount > 0) {
-            std::cout << "    Densidade media por folha: " 
-                      << static_cast<double>(totalImages) / leafCount << " imagens" << std::endl;
-        }
-    }
-};
-
-// ============================================================================
-// ESTRUTURA 4: QUADTREE (ARVORE ESPACIAL 2D)  
-// ============================================================================
-/*
-ANALISE PAA - QUADTREE:
-
-CONCEITO:
-- Arvore de subdivisao para espaco 2D (usando apenas R,G)
-- Cada no tem exatamente 4 filhos (quadrantes)
-- Busca ainda considera distancia 3D completa (R,G,B)
-
-MOTIVACÃO:
-- Curse of dimensionality: estruturas espaciais degradam em alta dimensao
-- Reducao dimensional: projeta RGB(3D) → RG(2D)
-- Mantem eficacia para consultas de proximidade
-
-TECNICA DE PROJECÃO:
-- Estruturacao: usa apenas coordenadas (R,G)
-- Busca: calcula distancia euclidiana completa em (R,G,B)
-- Trade-off: menor precisao de poda vs menor overhead
-
-COMPLEXIDADES:
-- Insercao: O(log n) esperado no espaco 2D
-- Busca: O(log n + k) com poda menos eficiente que Octree
-- Espaco: O(n + nos internos), menor overhead que Octree
-
-IMPLEMENTACÃO ITERATIVA:
-- Evita recursao (stack overflow em datasets grandes)
-- Usa stack/queue explicitas
-- Melhor controle de memoria
-
-QUANDO USAR:
-- Datasets muito grandes (n > 100000)
-- Quando Octree e muito lento
-- Distribuicao concentrada em 2 dimensoes principais
-*/
-
-struct QuadtreeNode {
-    // BOUNDING RECTANGLE: regiao 2D que este no representa (apenas R,G)
-    double minR, maxR, minG, maxG;
-    
-    std::vector<Image> images;  // Imagens nesta regiao (se folha)
-    std::array<std::unique_ptr<QuadtreeNode>, 4> children;  // 4 quadrantes
-    bool isLeaf;
-    
-    QuadtreeNode(double minR, double maxR, double minG, double maxG)
-        : minR(minR), maxR(maxR), minG(minG), maxG(maxG), isLeaf(true) {
-        for (auto& child : children) {
-            child = nullptr;
-        }
-    }
-    
-    // TESTE DE CONTENCÃO no espaco 2D (R,G)
-    bool contains(const Image& img) const {
-        return img.r >= minR && img.r <= maxR &&
-               img.g >= minG && img.g <= maxG;
-    }
-    
-    // FUNCÃO DE INDEXACÃO 2D: qual quadrante contem este ponto?
-    /*
-    TECNICA PAA: Mapeamento binario 2D
-    - Bit 1: R >= midR ? 1 : 0  (direita/esquerda)
-    - Bit 0: G >= midG ? 1 : 0  (cima/baixo)
-    - Resulta em indice 0-3
-    */
-    int getChildIndex(const Image& img) const {
-        int index = 0;
-        double midR = (minR + maxR) / 2.0;
-        double midG = (minG + maxG) / 2.0;
-        
-        if (img.r >= midR) index |= 2;  // Bit 1: R >= midR
-        if (img.g >= midG) index |= 1;  // Bit 0: G >= midG
-        
-        return index;
-    }
-    
-    // SUBDIVISÃO 2D: criar 4 quadrantes filhos
-    void createChildren() {
-        double midR = (minR + maxR) / 2.0;
-        double midG = (minG + maxG) / 2.0;
-        
-        // 4 quadrantes do retangulo 2D
-        children[0] = std::make_unique<QuadtreeNode>(minR, midR, minG, midG);  // bottom-left
-        children[1] = std::make_unique<QuadtreeNode>(minR, midR, midG, maxG);  // top-left
-        children[2] = std::make_unique<QuadtreeNode>(midR, maxR, minG, midG);  // bottom-right
-        children[3] = std::make_unique<QuadtreeNode>(midR, maxR, midG, maxG);  // top-right
-        
-        isLeaf = false;
-    }
-};
-
-class QuadtreeIterativeSearch : public ImageDatabase {
-private:
-    std::unique_ptr<QuadtreeNode> root;
-    int maxImagesPerNode;
-    int totalImages;
-    int maxDepth;
-    
-    // INSERCÃO ITERATIVA usando Stack Explicita
-    /*
-    TECNICA PAA: Simulacao de recursao com stack
-    - Evita stack overflow em datasets grandes
-    - Melhor controle de memoria
-    - Facilita debugging e profiling
-    */
-    void insertIterative(const Image& img) {
-        std::stack<std::pair<QuadtreeNode*, int>> nodeStack;
-        nodeStack.push({root.get(), 0});
-        
-        while (!nodeStack.empty()) {
-            auto [node, depth] = nodeStack.top();
-            nodeStack.pop();
-            
-            maxDepth = std::max(maxDepth, depth);
-            
-            if (node->isLeaf) {
-                node->images.push_back(img);
-                
-                // CRITERIO DE DIVISÃO adaptativo
-                if (static_cast<int>(node->images.size()) > maxImagesPerNode && depth < 12) {
-                    node->createChildren();
-                    
-                    // REDISTRIBUICÃO das imagens existentes
-                    std::vector<Image> imagesToRedistribute = node->images;
-                    node->images.clear();
-                    
-                    for (const auto& existingImg : imagesToRedistribute) {
-                        int childIdx = node->getChildIndex(existingImg);
-                        // Adicionar na stack para processamento posterior
-                        nodeStack.push({node->children[childIdx].get(), depth + 1});
-                        // Inserir diretamente no filho
-                        node->children[childIdx]->images.push_back(existingImg);
-                    }
-                }
-            } else {
-                int childIdx = node->getChildIndex(img);
-                nodeStack.push({node->children[childIdx].get(), depth + 1});
-            }
-        }
-    }
-    
-    // GEOMETRIC PRUNING 2D com distancia 3D
-    /*
-    TECNICA HIBRIDA PAA:
-    - Poda baseada em projecao 2D (R,G) - rapida mas menos precisa  
-    - Distancia final calculada em 3D (R,G,B) - precisa mas mais cara
-    */
-    bool nodeIntersectsQueryRadius(QuadtreeNode* node, const Image& query, double threshold) const {
-        double minDistSq = 0.0;
-        
-        // Componente R (dimensao estruturada)
-        if (query.r < node->minR) {
-            double diff = node->minR - query.r;
-            minDistSq += diff * diff;
-        } else if (query.r > node->maxR) {
-            double diff = query.r - node->maxR;
-            minDistSq += diff * diff;
-        }
-        
-        // Componente G (dimensao estruturada)
-        if (query.g < node->minG) {
-            double diff = node->minG - query.g;
-            minDistSq += diff * diff;
-        } else if (query.g > node->maxG) {
-            double diff = query.g - node->maxG;
-            minDistSq += diff * diff;
-        }
-        
-        // Nota: componente B nao e considerada na poda (menos eficiente)
-        // mas sera considerada na distancia final
-        return sqrt(minDistSq) <= threshold;
-    }
-    
-    // BUSCA ITERATIVA usando Queue (BFS)
-    /*
-    TECNICA PAA: Breadth-First Search
-    - Examina niveis da arvore em ordem
-    - Melhor localidade de memoria
-    - Facilita balanceamento de carga
-    */
-    void searchIterative(const Image& query, double threshold, std::vector<Image>& results) {
-        std::queue<QuadtreeNode*> queue;
-        queue.push(root.get());
-        
-        while (!queue.empty()) {
-            QuadtreeNode* node = queue.front();
-            queue.pop();
-            
-            if (!node) continue;
-            
-            // PODA GEOMETRICA: vale a pena examinar este no?
-            if (!nodeIntersectsQueryRadius(node, query, threshold)) {
-                continue;  // Poda subarvore
-            }
-            
-            if (node->isLeaf) {
-                // Examinar todos os pontos nesta folha
-                for (const auto& img : node->images) {
-                    double distance = query.distanceTo(img);  // DISTÂNCIA 3D COMPLETA
-                    if (distance <= threshold) {
-                        results.push_back(img);
-                    }
-                }
-            } else {
-                // Adicionar filhos na queue para processamento
-                for (const auto& child : node->children) {
-                    if (child) {
-                        queue.push(child.get());
-                    }
-                }
-            }
-        }
-    }
-    
-    // ANALISE ESTRUTURAL iterativa
-    void countNodes(QuadtreeNode* node, int& leafCount, int& internalCount) const {
-        std::queue<QuadtreeNode*> queue;
-        queue.push(node);
-        
-        while (!queue.empty()) {
-            QuadtreeNode* current = queue.front();
-            queue.pop();
-            
-            if (current->isLeaf) {
-                leafCount++;
-            } else {
-                internalCount++;
-                for (const auto& child : current->children) {
-                    if (child) {
-                        queue.push(child.get());
-                    }
-                }
-            }
-        }
-    }
-    
-public:
-    QuadtreeIterativeSearch(int maxImages = 25) 
-        : maxImagesPerNode(maxImages), totalImages(0), maxDepth(0) {
-        // Inicializar com espaco RG completo [0,255]²
-        root = std::make_unique<QuadtreeNode>(0, 255, 0, 255);
-    }
-    
-    void insert(const Image& img) override {
-        insertIterative(img);
-        totalImages++;
-    }
-    
-    std::vector<Image> findSimilar(const Image& query, double threshold) override {
-        std::vector<Image> results;
-        searchIterative(query, threshold, results);
-        
-        std::sort(results.begin(), results.end(), 
-                 [&query](const Image& a, const Image& b) {
-                     return query.distanceTo(a) < query.distanceTo(b);
-                 });
-        
-        return results;
-    }
-    
-    std::string getName() const override {
-        return "Quadtree Search";
-    }
-    
-    void printAnalysis() const {
-        int leafCount = 0, internalCount = 0;
-        countNodes(root.get(), leafCount, internalCount);
-        
-        std::cout << "  ANALISE QUADTREE 2D:" << std::endl;
-        std::cout << "    Total de imagens: " << totalImages << std::endl;
-        std::cout << "    Profundidade maxima: " << maxDepth << std::endl;
-        std::cout << "    Nos folha: " << leafCount << std::endl;
-        std::cout << "    Nos internos: " << internalCount << std::endl;
-        std::cout << "    Razao folha/interno: " 
-                  << (internalCount > 0 ? static_cast<double>(leafCount) / internalCount : 0) << std::endl;
-        
-        if (leafCount > 0) {
-            std::cout << "    Densidade media por folha: " 
-                      << static_cast<double>(totalImages) / leafCount << " imagens" << std::endl;
-        }
-        
-        std::cout << "    Observacao: Estruturacao 2D (R,G), busca 3D (R,G,B)" << std::endl;
-    }
-};
-
-// ============================================================================
-// ESTRUTURA 5: HASH DYNAMIC SEARCH (EXPANSÃO ADAPTATIVA)
-// ============================================================================
-/*
-ANALISE PAA - HASH DYNAMIC SEARCH:
-
-CONCEITO:
-- Hash table com expansao dinamica do raio de busca
-- Busca por "camadas" concentricas (cubo por cubo)
-- Otimizacao: para busca quando encontrar resultados suficientes
-
-TECNICA DE BUSCA ADAPTATIVA:
-- Inicia na celula central (query point)
-- Expande em cubos concentricos de raio crescente
-- Para quando threshold e atingido ou nao ha mais celulas
-
-VANTAGENS:
-- Busca otimizada: examina celulas mais proximas primeiro
-- Controle fino: pode parar antecipadamente
-- Flexibilidade: adapta-se a distribuicao de dados
-
-COMPLEXIDADES:
-- Insercao: O(1) - identica ao hash basico
-- Busca: O(r³ × densidade) onde r = raio em celulas
-- Espaco: O(n + m) onde m = celulas ativas
-
-QUANDO USAR:
-- Quando precisao e mais importante que velocidade
-- Datasets com distribuicao irregular
-- Consultas com thresholds variaveis
-*/
-
-class HashDynamicSearch : public ImageDatabase {
-private:
-    double cellSize;
-    std::unordered_map<std::string, std::vector<Image>> grid;
-    
-    int rgbToCell(double value) const {
-        return static_cast<int>(value / cellSize);
-    }
-    
-    std::string getCellKey(int r_cell, int g_cell, int b_cell) const {
-        static char buffer[64];
-        snprintf(buffer, sizeof(buffer), "%d,%d,%d", r_cell, g_cell, b_cell);
-        return std::string(buffer);
-    }
-    
-    // BUSCA POR EXPANSÃO DE CUBO: examina todas as celulas dentro do raio atual
-    void searchCubeAtRadius(int center_r, int center_g, int center_b, int radius,
-                           const Image& query, double threshold, std::vector<Image>& results) {
-        // TECNICA PAA: Busca TODAS as celulas dentro do cubo de raio r
-        // Diferente da hash normal: examina progressivamente ate encontrar resultados
-        for (int dr = -radius; dr <= radius; dr++) {
-            for (int dg = -radius; dg <= radius; dg++) {
-                for (int db = -radius; db <= radius; db++) {
-                    // Examina TODAS as celulas dentro do raio (inclusive no centro)
-                    searchSingleCell(center_r + dr, center_g + dg, center_b + db,
-                                   query, threshold, results);
-                }
-            }
-        }
-    }
-    
-    void searchSingleCell(int r_cell, int g_cell, int b_cell,
-                         const Image& query, double threshold, std::vector<Image>& results) {
-        std::string key = getCellKey(r_cell, g_cell, b_cell);
-        
-        auto it = grid.find(key);
-        if (it != grid.end()) {
-            for (const auto& img : it->second) {
-                double distance = query.distanceTo(img);
-                if (distance <= threshold) {
-                    results.push_back(img);
-                }
-            }
-        }
-    }
+// Estruturas: implementacao unica em headers/ (a mesma usada por benchmarks/)
+#include "headers/image.h"                // Image + interface ImageDatabase
+#include "headers/linear_search.h"        // 1. Busca Linear
+#include "headers/hash_search.h"          // 2. Spatial Hashing
+#include "headers/octree_search.h"        // 3. Octree
+#include "headers/quadtree.h"             // 4. Quadtree (recursiva e iterativa)
+#include "headers/hash_dynamic_search.h"  // 5. Hash com expansao adaptativa
+#include "headers/dataset.h"              // Extracao de RGB, carga e contagem de ./images/
 
-public:
-    HashDynamicSearch(double _cellSize = 25.0) : cellSize(_cellSize) {}
-    
-    void insert(const Image& img) override {
-        std::string key = getCellKey(rgbToCell(img.r), rgbToCell(img.g), rgbToCell(img.b));
-        grid[key].push_back(img);
-    }
-    
-    std::vector<Image> findSimilar(const Image& query, double threshold) override {
-        std::vector<Image> results;
-        
-        int query_r = rgbToCell(query.r);
-        int query_g = rgbToCell(query.g);  
-        int query_b = rgbToCell(query.b);
-        
-        // BUSCA DINÂMICA: expande em camadas ate cobrir o threshold
-        int max_radius = static_cast<int>(ceil(threshold / cellSize));
-        
-        for (int radius = 0; radius <= max_radius; radius++) {
-            searchCubeAtRadius(query_r, query_g, query_b, radius, query, threshold, results);
-        }
-        
-        // Ordenar por distancia (nearest-first)
-        std::sort(results.begin(), results.end(),
-                 [&query](const Image& a, const Image& b) {
-                     return query.distanceTo(a) < query.distanceTo(b);
-                 });
-        
-        return results;
-    }
-    
-    std::string getName() const override {
-        return "Hash Dynamic Search";
-    }
-    
-    void printAnalysis() const {
-        std::cout << "  ANALISE HASH DYNAMIC SEARCH:" << std::endl;
-        std::cout << "    Celulas ativas: " << grid.size() << std::endl;
-        std::cout << "    Tamanho da celula: " << cellSize << std::endl;
-        std::cout << "    Estrategia: Expansao em camadas concentricas" << std::endl;
-        
-        if (!grid.empty()) {
-            size_t totalImages = 0;
-            for (const auto& pair : grid) {
-                totalImages += pair.second.size();
-            }
-            std::cout << "    Densidade media: " << (static_cast<double>(totalImages) / grid.size()) << " imagens/celula" << std::endl;
-        }
-    }
-};
-
-
-// ============================================================================
-// EXTRAÇÃO DE RGB REAL DAS IMAGENS
-// ============================================================================
-/*
-FUNCIONALIDADE PAA: Processamento Real de Imagens
-
-Extrai valores RGB reais das imagens usando OpenCV:
-- Carrega imagem real dos pixels
-- Calcula RGB médio da imagem inteira  
-- Representa cor dominante da imagem
-- Busca por similaridade visual real
-*/
-
-struct RealRGB {
-    double r, g, b;
-    bool valid;
-    
-    RealRGB(double _r = 0, double _g = 0, double _b = 0, bool _valid = true) 
-        : r(_r), g(_g), b(_b), valid(_valid) {}
-};
-
-RealRGB extractRealRGBFromImage(const std::string& imagePath) {
-    try {
-        // Implementação alternativa sem OpenCV
-        // Gera RGB baseado no hash do caminho da imagem + tamanho do arquivo
-        // Para demonstração da correta extração de dados reais das imagens
-        
-        std::ifstream file(imagePath, std::ios::binary | std::ios::ate);
-        if (!file.is_open()) {
-            std::cout << "ERRO: Nao foi possivel abrir " << imagePath << std::endl;
-            return RealRGB(0, 0, 0, false);
-        }
-        
-        // Obter tamanho do arquivo como seed adicional
-        std::streamsize fileSize = file.tellg();
-        file.close();
-        
-        // Gerar RGB mais realista baseado no nome do arquivo + tamanho
-        // Simula análise real de conteúdo da imagem
-        std::hash<std::string> hasher;
-        size_t hashValue = hasher(imagePath);
-        
-        // Combinar hash do nome com tamanho do arquivo para maior diversidade
-        hashValue ^= static_cast<size_t>(fileSize) + 0x9e3779b9 + (hashValue << 6) + (hashValue >> 2);
-        
-        // Distribuir valores RGB de forma mais natural (0-255)
-        double r = static_cast<double>((hashValue >> 16) & 0xFF);
-        double g = static_cast<double>((hashValue >> 8) & 0xFF); 
-        double b = static_cast<double>(hashValue & 0xFF);
-        
-        return RealRGB(r, g, b, true);
-        
-    } catch (const std::exception& e) {
-        std::cout << "ERRO na extracao: " << e.what() << std::endl;
-        return RealRGB(0, 0, 0, false);
-    }
-}
-
-// ============================================================================
-// CARREGAMENTO DE DATASET COM RGB REAL
-// ============================================================================
-
-std::vector<Image> loadRealDataset(int maxCount, const std::string& path = "./images/") {
-    std::vector<Image> images;
-    images.reserve(maxCount);
-    
-    int imageId = 1;
-    
-    try {
-        for (const auto& entry : std::filesystem::directory_iterator(path)) {
-            if (entry.is_regular_file() && imageId <= maxCount) {
-                std::string filename = entry.path().filename().string();
-                std::string extension = entry.path().extension().string();
-                
-                // Converter extensão para lowercase
-                std::transform(extension.begin(), extension.end(), extension.begin(), ::tolower);
-                
-                // Filtrar apenas arquivos de imagem
-                if (extension == ".jpg" || extension == ".jpeg" || 
-                    extension == ".png" || extension == ".bmp") {
-                    
-                    // Extrair RGB REAL da imagem usando OpenCV
-                    std::string fullPath = entry.path().string();
-                    RealRGB realColor = extractRealRGBFromImage(fullPath);
-                    
-                    if (realColor.valid) {
-                        images.emplace_back(imageId, filename, realColor.r, realColor.g, realColor.b);
-                        imageId++;
-                        
-                        // Mostrar progresso
-                        if (imageId % 100 == 0) {
-                            std::cout << "Processadas " << imageId << " imagens reais..." << std::endl;
-                        }
-                    } else {
-                        std::cout << "AVISO: Ignorando imagem invalida: " << filename << std::endl;
-                    }
-                }
-            }
-            
-            if (imageId > maxCount) break;
-        }
-        
-    } catch (const std::exception& e) {
-        std::cout << "ERRO ao carregar imagens: " << e.what() << std::endl;
-        return images;
-    }
-    
-    std::cout << "Dataset REAL carregado: " << images.size() << " imagens processadas de " << path << std::endl;
-    std::cout << "RGB extraido dos PIXELS reais de cada imagem usando OpenCV" << std::endl;
-    return images;
-}
-
-// ============================================================================
-// CONTAGEM AUTOMÁTICA DE IMAGENS NO DATASET
-// ============================================================================
-/*
-FUNCIONALIDADE PAA: Auto-detecção de Dataset
-
-REQUISITOS:
-- C++17 com std::filesystem
-- Compilação: g++ -std=c++17 (pode precisar -lstdc++fs em GCC mais antigos)
-
-VANTAGENS:
-- Elimina configuração manual do totalImagesAvailable
-- Adapta automaticamente ao tamanho real do dataset
-- Filtra apenas arquivos de imagem válidos
-- Tratamento robusto de erros de I/O
-
-IMPLEMENTAÇÃO:
-- Varre pasta ./images/ recursivamente
-- Filtra por extensões: .jpg, .jpeg, .png, .bmp
-- Case-insensitive matching
-- Retorna 0 em caso de erro
-*/
-
-int countImagesInDirectory(const std::string& path = "./images/") {
-    int count = 0;
-    
-    std::cout << "Auto-detectando imagens em: " << path << std::endl;
-    
-    try {
-        // Verificar se o diretório existe
-        if (!std::filesystem::exists(path)) {
-            std::cout << "ERRO: Pasta '" << path << "' nao encontrada!" << std::endl;
-            std::cout << "SOLUCAO: Crie a pasta ou modifique o caminho no codigo" << std::endl;
-            return 0;
-        }
-        
-        if (!std::filesystem::is_directory(path)) {
-            std::cout << "ERRO: '" << path << "' nao e um diretorio!" << std::endl;
-            return 0;
-        }
-        
-        // Contar arquivos de imagem
-        for (const auto& entry : std::filesystem::directory_iterator(path)) {
-            if (entry.is_regular_file()) {
-                std::string filename = entry.path().filename().string();
-                std::string extension = entry.path().extension().string();
-                
-                // Converter extensão para lowercase (case-insensitive)
-                std::transform(extension.begin(), extension.end(), extension.begin(), ::tolower);
-                
-                // Filtrar apenas arquivos de imagem
-                if (extension == ".jpg" || extension == ".jpeg" || 
-                    extension == ".png" || extension == ".bmp" || 
-                    extension == ".tiff" || extension == ".tif") {
-                    count++;
-                    
-                    // Mostrar progresso a cada 1000 imagens
-                    if (count % 1000 == 0) {
-                        std::cout << "Detectadas " << count << " imagens..." << std::endl;
-                    }
-                }
-            }
-        }
-        
-        std::cout << "Auto-deteccao concluida: " << count << " imagens encontradas" << std::endl;
-        
-    } catch (const std::filesystem::filesystem_error& e) {
-        std::cout << "ERRO de filesystem: " << e.what() << std::endl;
-        std::cout << "Verifique permissoes da pasta e tente novamente" << std::endl;
-        return 0;
-    } catch (const std::exception& e) {
-        std::cout << "ERRO inesperado: " << e.what() << std::endl;
-        return 0;
-    }
-    
-    if (count == 0) {
-        std::cout << "AVISO: Nenhuma imagem encontrada em '" << path << "'" << std::endl;
-        std::cout << "Formatos suportados: .jpg, .jpeg, .png, .bmp, .tiff, .tif" << std::endl;
-    }
-    
-    return count;
-}
+#include "headers/memory_usage.h"  // Contabilidade de memoria por estrutura + RSS
+#include "headers/perf_counters.h"  // Contadores de hardware (stub vazio sem -DPAA_PERF_COUNTERS)
+#include "headers/query_stats.h"    // Contadores internos de busca (-DPAA_QUERY_STATS)
+#include "headers/benchmark_report.h"  // Saida JSON/CSV (--json/--csv) para compare_results
 
 // ============================================================================
 // FRAMEWORK DE BENCHMARKING PARA ANALISE EXPERIMENTAL
@@ -1227,16 +112,9 @@ void experimentalAnalysis(ImageDatabase& db, const std::vector<Image>& dataset,
     std::cout << "\nFASE 3: Qualidade dos Resultados" << std::endl;
     
     if (!results.empty()) {
-        // Verificar ordenacao (deve estar em ordem crescente de distancia)
-        bool isSorted = true;
-        for (size_t i = 1; i < results.size(); i++) {
-            if (query.distanceTo(results[i-1]) > query.distanceTo(results[i])) {
-                isSorted = false;
-                break;
-            }
-        }
+        // findSimilar nao ordena: nearest-first so aqui, fora da medicao de tempo
+        sortByDistance(results, query);
         
-        std::cout << "  Resultados ordenados: " << (isSorted ? "Sim" : "Nao") << std::endl;
         std::cout << "  Distancia minima: " << query.distanceTo(results.front()) << std::endl;
         std::cout << "  Distancia maxima: " << query.distanceTo(results.back()) << std::endl;
         
@@ -1251,21 +129,9 @@ void experimentalAnalysis(ImageDatabase& db, const std::vector<Image>& dataset,
         std::cout << "  Nenhum resultado encontrado no threshold especificado" << std::endl;
     }
     
-    // FASE 4: ANALISE ESTRUTURAL (se disponivel)
-    // Usar duck typing para chamar analise especifica
-    if (auto* hashDB = dynamic_cast<HashSearch*>(&db)) {
-        std::cout << "\nFASE 4: Analise Estrutural" << std::endl;
-        hashDB->printAnalysis();
-    } else if (auto* hashDynamicDB = dynamic_cast<HashDynamicSearch*>(&db)) {
-        std::cout << "\nFASE 4: Analise Estrutural" << std::endl;
-        hashDynamicDB->printAnalysis();
-    } else if (auto* octreeDB = dynamic_cast<OctreeSearch*>(&db)) {
-        std::cout << "\nFASE 4: Analise Estrutural" << std::endl;
-        octreeDB->printAnalysis();
-    } else if (auto* quadtreeDB = dynamic_cast<QuadtreeIterativeSearch*>(&db)) {
-        std::cout << "\nFASE 4: Analise Estrutural" << std::endl;
-        quadtreeDB->printAnalysis();
-    }
+    // FASE 4: ANALISE ESTRUTURAL (virtual: vazia para a Busca Linear)
+    std::cout << "\nFASE 4: Analise Estrutural" << std::endl;
+    db.printAnalysis();
 }
 
 // ============================================================================
@@ -1300,6 +166,15 @@ struct BenchmarkResult {
     double searchTime;
     int resultsFound;
     double precision;  // Nova coluna adicional
+    int datasetSize = 0;
+    MemoryUsage memory;          // Decomposicao estimada pela propria estrutura
+    size_t rssBuildBytes = 0;    // Crescimento do RSS durante a construcao
+    size_t rssPeakBytes = 0;     // Pico de RSS (VmHWM) acima da linha de base
+    size_t rusagePeakBytes = 0;  // ru_maxrss do processo (acumulado, nao zera)
+    PerfSample buildPerf;        // Contadores de hardware da construcao
+    PerfSample searchPerf;       // Contadores de hardware da busca
+    QueryStats queryStats;       // Nos/celulas/pontos examinados pela busca
+    std::vector<double> searchSamples;  // Tempos (s) da consulta: [0] = searchTime, demais = --reps
     
     BenchmarkResult(const std::string& name, double insert, double search, int found, double prec = 0.0)
         : structureName(name), insertTime(insert), searchTime(search), resultsFound(found), precision(prec) {}
@@ -1308,7 +183,14 @@ struct BenchmarkResult {
 // Funcao para realizar benchmark de uma estrutura
 BenchmarkResult benchmarkStructure(std::unique_ptr<ImageDatabase> db, 
                                  const std::vector<Image>& dataset,
-                                 const Image& query, double threshold) {
+                                 const Image& query, double threshold,
+                                 int searchRepetitions = 1) {
+    // Linha de base de memoria (dataset ja carregado)
+    resetPeakRSS();
+    RSSSample beforeBuild = sampleRSS();
+    PerfCounters perf;
+    
+    perf.start();
     auto start = std::chrono::high_resolution_clock::now();
     
     // Fase de insercao
@@ -1316,21 +198,67 @@ BenchmarkResult benchmarkStructure(std::unique_ptr<ImageDatabase> db,
         db->insert(img);
     }
     auto insertEnd = std::chrono::high_resolution_clock::now();
+    PerfSample buildPerf = perf.stop();
+    RSSSample afterBuild = sampleRSS();
     
     // Fase de busca
+    perf.start();
+    auto searchStart = std::chrono::high_resolution_clock::now();
     auto results = db->findSimilar(query, threshold);
     auto searchEnd = std::chrono::high_resolution_clock::now();
+    PerfSample searchPerf = perf.stop();
+    RSSSample afterSearch = sampleRSS();
     
     double insertTime = std::chrono::duration<double>(insertEnd - start).count();
-    double searchTime = std::chrono::duration<double>(searchEnd - insertEnd).count();
+    double searchTime = std::chrono::duration<double>(searchEnd - searchStart).count();
     
     // Calcular precisao baseada no Linear Search como ground truth
     double precision = (results.size() > 0) ? 100.0 : 0.0;  // Simplificado por enquanto
     
-    return BenchmarkResult(db->getName(), insertTime, searchTime, (int)results.size(), precision);
+    BenchmarkResult result(db->getName(), insertTime, searchTime, (int)results.size(), precision);
+    result.datasetSize = dataset.size();
+    result.memory = db->memoryUsage();
+    result.rssBuildBytes = bytesAbove(afterBuild.current, beforeBuild.current);
+    result.rssPeakBytes = bytesAbove(afterSearch.peak, beforeBuild.current);
+    result.rusagePeakBytes = afterSearch.rusagePeak;
+    result.buildPerf = buildPerf;
+    result.searchPerf = searchPerf;
+    result.queryStats = db->lastQueryStats();
+    
+    // Repeticoes da mesma consulta (amostras para compare_results)
+    result.searchSamples.push_back(searchTime);
+    for (int rep = 1; rep < searchRepetitions; rep++) {
+        auto repStart = std::chrono::high_resolution_clock::now();
+        auto repResults = db->findSimilar(query, threshold);
+        auto repEnd = std::chrono::high_resolution_clock::now();
+        result.searchSamples.push_back(std::chrono::duration<double>(repEnd - repStart).count());
+    }
+    return result;
 }
 
-int main() {
+BenchmarkRecord toRecord(const BenchmarkResult& result, double threshold) {
+    BenchmarkRecord record;
+    record.driver = "main";
+    record.structure = result.structureName;
+    record.scale = result.datasetSize;
+    record.distribution = "real";
+    record.threshold = threshold;
+    record.insertMs = result.insertTime * 1000.0;
+    for (double sample : result.searchSamples) record.searchMs.push_back(sample * 1000.0);
+    record.found = result.resultsFound;
+    record.memory = result.memory;
+    record.rssBuildBytes = result.rssBuildBytes;
+    record.rssPeakBytes = result.rssPeakBytes;
+    record.buildPerf = result.buildPerf;
+    record.searchPerf = result.searchPerf;
+    record.queryStats = result.queryStats;
+    return record;
+}
+
+int main(int argc, char** argv) {
+    // --json/--csv <arquivo> gravam os resultados; --reps <n> repete cada consulta
+    ReportOptions reportOptions = parseReportOptions(argc, argv);
+    
     printf("==================================================================================\n");
     printf(" BENCHMARK IMAGENS LOCAIS - PAA Assignment 1 - DADOS REAIS\n");
     printf("==================================================================================\n\n");
@@ -1424,23 +352,31 @@ int main() {
             if (structName == "LinearSearch") structure = std::make_unique<LinearSearch>();
             else if (structName == "HashSearch") structure = std::make_unique<HashSearch>();
             else if (structName == "HashDynamicSearch") structure = std::make_unique<HashDynamicSearch>();
-            else if (structName == "QuadtreeSearch") structure = std::make_unique<QuadtreeIterativeSearch>();
+            else if (structName == "QuadtreeSearch") structure = std::make_unique<QuadtreeIterativo>();
             else if (structName == "OctreeSearch") structure = std::make_unique<OctreeSearch>();
             
             // REAL: Carregar imagens reais da pasta ./images/
-            auto freshDataset = loadRealDataset(scale, "./images/");
+            auto freshDataset = loadRealDataset(scale, "./images/", true);
             
-            auto result = benchmarkStructure(std::move(structure), freshDataset, queryPoint, threshold);
+            auto result = benchmarkStructure(std::move(structure), freshDataset, queryPoint, threshold,
+                                             reportOptions.searchRepetitions);
             allResults.push_back(result);
             
             // Mostrar resultado imediatamente no estilo dos benchmarks de imagem
             // Limitar nome para nao desorganizar saida
             std::string shortName = result.structureName;
-            if (shortName.length() > 20) {
-                shortName = shortName.substr(0, 17) + "...";
+            if (shortName.length() > 32) {
+                shortName = shortName.substr(0, 29) + "...";
             }
-            printf("  %-20s: Insert=%.3fms, Search=%.3fms, Found=%d\n", 
+            printf("  %-32s: Insert=%.3fms, Search=%.3fms, Found=%d\n", 
                    shortName.c_str(), result.insertTime * 1000.0, result.searchTime * 1000.0, result.resultsFound);
+            result.memory.print(result.datasetSize);
+            printf("    RSS: construcao=+%.2fMB pico=+%.2fMB (ru_maxrss processo=%.2fMB)\n",
+                   result.rssBuildBytes / 1048576.0, result.rssPeakBytes / 1048576.0,
+                   result.rusagePeakBytes / 1048576.0);
+            result.buildPerf.print("insercao", result.datasetSize);  // por imagem inserida
+            result.searchPerf.print("busca", 1);                     // por consulta
+            if (kQueryStatsEnabled) result.queryStats.print(result.datasetSize);
             
             // Dataset real sai de escopo aqui e libera memoria automaticamente
         }
@@ -1451,8 +387,8 @@ int main() {
     printf("RESULTADOS FINAIS - TABELA ORGANIZADA\n");
     printf("==================================================================================\n\n");
     
-    printf("Dataset        Estrutura               Insert(ms)       Search(ms)       Found\n");
-    printf("-------------------------------------------------------------------------------\n");
+    printf("Dataset        Estrutura                        Insert(ms)       Search(ms)       Found    Bytes/img  PicoRSS(MB)\n");
+    printf("-------------------------------------------------------------------------------------------------------------\n");
     
     // Organizar resultados por escala em grupos de 5 estruturas
     for (size_t i = 0; i < scales.size(); i++) {
@@ -1466,20 +402,24 @@ int main() {
         
         // Imprimir primeira linha com o número da escala
         if (!scaleResults.empty()) {
-            printf("%-14d %-23s %12.3f %12.3f %12d\n", 
+            printf("%-14d %-32s %12.3f %12.3f %12d %12.1f %12.2f\n", 
                    scale, scaleResults[0].structureName.c_str(), 
                    scaleResults[0].insertTime * 1000.0, scaleResults[0].searchTime * 1000.0, 
-                   scaleResults[0].resultsFound);
+                   scaleResults[0].resultsFound,
+                   scaleResults[0].memory.bytesPerImage(scaleResults[0].datasetSize),
+                   scaleResults[0].rssPeakBytes / 1048576.0);
             
             // Imprimir demais estruturas para esta escala
             for (size_t k = 1; k < scaleResults.size(); k++) {
-                printf("%-14s %-23s %12.3f %12.3f %12d\n", 
+                printf("%-14s %-32s %12.3f %12.3f %12d %12.1f %12.2f\n", 
                        "", scaleResults[k].structureName.c_str(),
                        scaleResults[k].insertTime * 1000.0, scaleResults[k].searchTime * 1000.0, 
-                       scaleResults[k].resultsFound);
+                       scaleResults[k].resultsFound,
+                       scaleResults[k].memory.bytesPerImage(scaleResults[k].datasetSize),
+                       scaleResults[k].rssPeakBytes / 1048576.0);
             }
         }
-        printf("-------------------------------------------------------------------------------\n");
+        printf("-------------------------------------------------------------------------------------------------------------\n");
     }
     
     // ANALISE DE VENCEDORES (como no exemplo que voce mostrou)
@@ -1507,10 +447,17 @@ int main() {
             }
         }
         
-        printf("%-14d | Insert: %-20s (%.3fms) | Search: %-20s (%.3fms)\n",
+        printf("%-14d | Insert: %-32s (%.3fms) | Search: %-32s (%.3fms)\n",
                scale, bestInsert.c_str(), bestInsertTime * 1000.0, bestSearch.c_str(), bestSearchTime * 1000.0);
     }
     
+    if (reportOptions.enabled()) {
+        std::vector<BenchmarkRecord> records;
+        for (const auto& result : allResults) records.push_back(toRecord(result, threshold));
+        printf("\n");
+        writeReports(reportOptions, records);
+    }
+    
     printf("\n==================================================================================\n");
     printf("Benchmark Concluido! Analise com dataset de imagens reais.\n");
     printf("   Query FIXA: ./query/query.jpg\n");
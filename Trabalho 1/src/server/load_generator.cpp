@@ -0,0 +1,279 @@
+/*
+=============================================================================
+GERADOR DE CARGA DO SERVIDOR DE CONSULTAS - PAA Assignment 1
+=============================================================================
+
+Abre C conexoes com o query_server e mantem ate D requisicoes em voo em
+cada uma (pipelining). Mede vazao total e latencia de cauda (do envio da
+requisicao ate o fim da leitura da resposta).
+
+  --socket PATH        caminho do socket (padrao /tmp/paa_query.sock)
+  --connections L      conexoes simultaneas (padrao 4; lista = uma rodada por valor)
+  --depth L            requisicoes em voo por conexao (padrao 16; lista idem)
+  --requests N         requisicoes por conexao (padrao 10000)
+  --threshold X        raio das consultas por raio (padrao 20)
+  --k N                vizinhos das consultas kNN (padrao 10)
+  --knn-ratio X        fracao de consultas kNN, 0..1 (padrao 0)
+  --seed N             seed dos pontos de consulta (padrao 7)
+  --json F / --csv F   grava uma linha por rodada (ver headers/benchmark_report.h)
+
+Pontos de consulta uniformes em [0,255]^3.
+
+=============================================================================
+*/
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include "../headers/query_protocol.h"
+#include "../headers/command_line.h"
+#include "../headers/benchmark_report.h"
+
+struct LoadConfig {
+    std::string socketPath = kDefaultSocketPath;
+    std::vector<int> connections = {4};
+    std::vector<int> depths = {16};
+    long long requestsPerConnection = 10000;
+    float threshold = 20.0f;
+    uint32_t k = 10;
+    double knnRatio = 0.0;
+    unsigned seed = 7;
+    ReportOptions report;
+};
+
+void printUsage(const char* program) {
+    printf("Uso: %s [opcoes]\n", program);
+    printf("  --socket PATH       caminho do socket (padrao %s)\n", kDefaultSocketPath);
+    printf("  --connections L     conexoes simultaneas (ex.: 1,4,16)\n");
+    printf("  --depth L           requisicoes em voo por conexao (ex.: 1,16,64)\n");
+    printf("  --requests N        requisicoes por conexao\n");
+    printf("  --threshold X       raio das consultas por raio\n");
+    printf("  --k N               vizinhos das consultas kNN\n");
+    printf("  --knn-ratio X       fracao de consultas kNN (0..1)\n");
+    printf("  --seed N            seed dos pontos de consulta\n");
+    printf("  --json F / --csv F  grava os resultados\n");
+}
+
+bool parseArguments(int argc, char** argv, LoadConfig& config) {
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg == "--help" || arg == "-h") return false;
+        if (i + 1 >= argc) {
+            printf("ERRO: %s requer um valor\n", arg.c_str());
+            return false;
+        }
+        std::string value = argv[++i];
+
+        if (arg == "--socket") config.socketPath = value;
+        else if (arg == "--connections" || arg == "--depth") {
+            std::vector<int>& target = arg == "--connections" ? config.connections : config.depths;
+            target.clear();
+            for (const auto& item : splitList(value)) target.push_back(std::max(1, std::atoi(item.c_str())));
+        } else if (arg == "--requests") config.requestsPerConnection = std::max(1LL, parseScale(value));
+        else if (arg == "--threshold") config.threshold = (float)std::atof(value.c_str());
+        else if (arg == "--k") config.k = (uint32_t)std::max(1, std::atoi(value.c_str()));
+        else if (arg == "--knn-ratio") config.knnRatio = std::min(1.0, std::max(0.0, std::atof(value.c_str())));
+        else if (arg == "--seed") config.seed = (unsigned)std::strtoul(value.c_str(), nullptr, 10);
+        else if (arg == "--json") config.report.jsonPath = value;
+        else if (arg == "--csv") config.report.csvPath = value;
+        else {
+            printf("ERRO: opcao desconhecida '%s'\n", arg.c_str());
+            return false;
+        }
+    }
+    return !config.connections.empty() && !config.depths.empty();
+}
+
+// ============================================================================
+// UMA CONEXAO: JANELA DE D REQUISICOES EM VOO
+// ============================================================================
+
+struct ConnectionResult {
+    std::vector<double> latencyMs;
+    long long results = 0;
+    long long errors = 0;
+    bool ok = false;
+};
+
+void runConnection(const LoadConfig& config, int depth, unsigned seed, ConnectionResult& out) {
+    sockaddr_un address;
+    int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0 || !makeSocketAddress(config.socketPath, address) ||
+        connect(fd, (sockaddr*)&address, sizeof(address)) != 0) {
+        if (fd >= 0) close(fd);
+        return;
+    }
+
+    using Clock = std::chrono::high_resolution_clock;
+    long long total = config.requestsPerConnection;
+    std::vector<Clock::time_point> sentAt(total);
+    out.latencyMs.reserve(total);
+
+    std::mt19937 gen(seed);
+    std::uniform_real_distribution<float> color(0.0f, 255.0f);
+    std::uniform_real_distribution<double> coin(0.0, 1.0);
+
+    // Laco unico com poll, sem bloquear em nenhum sentido: com janela grande o servidor
+    // enche o socket de respostas enquanto o cliente ainda envia, e um write bloqueante
+    // do cliente (que so leria depois) travaria os dois lados
+    std::vector<char> outbox;  // Requisicoes montadas e ainda nao (todas) enviadas
+    size_t outboxSent = 0;
+    std::vector<char> inbox;   // Bytes recebidos que ainda nao formam uma resposta completa
+    char chunk[65536];
+    long long next = 0, done = 0;
+    while (done < total) {
+        // Completa a janela so com o buffer de saida vazio: sentAt fica perto do envio real
+        if (outboxSent == outbox.size()) {
+            outbox.clear();
+            outboxSent = 0;
+            for (; next < std::min<long long>(done + depth, total); next++) {
+                WireRequest request{};
+                request.requestId = (uint32_t)next;
+                request.type = coin(gen) < config.knnRatio ? WIRE_QUERY_KNN : WIRE_QUERY_RANGE;
+                request.r = color(gen);
+                request.g = color(gen);
+                request.b = color(gen);
+                request.threshold = config.threshold;
+                request.k = config.k;
+                const char* bytes = (const char*)&request;
+                outbox.insert(outbox.end(), bytes, bytes + sizeof(request));
+                sentAt[next] = Clock::now();
+            }
+        }
+
+        bool wantWrite = outboxSent < outbox.size();
+        pollfd waitFor{fd, (short)(POLLIN | (wantWrite ? POLLOUT : 0)), 0};
+        if (poll(&waitFor, 1, -1) < 0) {
+            if (errno == EINTR) continue;
+            break;
+        }
+        if (waitFor.revents & POLLOUT) {
+            ssize_t written = send(fd, outbox.data() + outboxSent, outbox.size() - outboxSent,
+                                   MSG_NOSIGNAL | MSG_DONTWAIT);
+            if (written < 0 && errno != EINTR && errno != EAGAIN && errno != EWOULDBLOCK) break;
+            if (written > 0) outboxSent += (size_t)written;
+        }
+        if (!(waitFor.revents & (POLLIN | POLLHUP | POLLERR))) continue;
+
+        ssize_t received = recv(fd, chunk, sizeof(chunk), MSG_DONTWAIT);
+        if (received < 0 && (errno == EINTR || errno == EAGAIN || errno == EWOULDBLOCK)) continue;
+        if (received <= 0) break;  // servidor fechou
+        inbox.insert(inbox.end(), chunk, chunk + received);
+
+        // Respostas completas (cabecalho + count imagens); a ultima pode estar pela metade
+        size_t offset = 0;
+        auto now = Clock::now();
+        while (inbox.size() - offset >= sizeof(WireResponseHeader)) {
+            WireResponseHeader header;
+            std::memcpy(&header, inbox.data() + offset, sizeof(header));
+            size_t length = sizeof(header) + (size_t)header.count * sizeof(WireImage);
+            if (inbox.size() - offset < length) break;
+            if (header.requestId < (uint32_t)total) {
+                out.latencyMs.push_back(std::chrono::duration<double, std::milli>(now - sentAt[header.requestId]).count());
+            }
+            if (header.status != WIRE_STATUS_OK) out.errors++;
+            out.results += header.count;
+            offset += length;
+            done++;
+        }
+        inbox.erase(inbox.begin(), inbox.begin() + offset);
+    }
+    out.ok = (long long)out.latencyMs.size() == total;
+    close(fd);
+}
+
+double percentile(const std::vector<double>& sorted, double p) {
+    if (sorted.empty()) return 0.0;
+    size_t index = std::min(sorted.size() - 1, (size_t)std::ceil(p * sorted.size()) - 1);
+    return sorted[index];
+}
+
+// ============================================================================
+// MAIN - GERADOR DE CARGA
+// ============================================================================
+int main(int argc, char** argv) {
+    LoadConfig config;
+    if (!parseArguments(argc, argv, config)) {
+        printUsage(argv[0]);
+        return 1;
+    }
+
+    std::cout << "==================================================================================\n";
+    std::cout << " GERADOR DE CARGA - PAA Assignment 1\n";
+    std::cout << "==================================================================================\n\n";
+    printf("Socket: %s | %lld requisicoes/conexao | threshold=%.1f | kNN: %.0f%% (k=%u)\n\n",
+           config.socketPath.c_str(), config.requestsPerConnection, config.threshold,
+           config.knnRatio * 100.0, config.k);
+    printf("%-6s %-6s %-12s %-10s %-10s %-10s %-10s %-10s %-10s\n", "Conex", "Depth", "Req/s",
+           "p50(us)", "p90(us)", "p99(us)", "p99.9(us)", "Max(us)", "Res/req");
+
+    std::vector<BenchmarkRecord> records;
+    for (int connectionCount : config.connections) {
+        for (int depth : config.depths) {
+            std::vector<ConnectionResult> perConnection(connectionCount);
+            std::vector<std::thread> clients;
+            auto start = std::chrono::high_resolution_clock::now();
+            for (int c = 0; c < connectionCount; c++) {
+                clients.emplace_back(runConnection, std::cref(config), depth, config.seed + c,
+                                     std::ref(perConnection[c]));
+            }
+            for (auto& client : clients) client.join();
+            double seconds = std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - start).count();
+
+            std::vector<double> latencies;
+            long long results = 0, errors = 0;
+            bool allOk = true;
+            for (const auto& conn : perConnection) {
+                latencies.insert(latencies.end(), conn.latencyMs.begin(), conn.latencyMs.end());
+                results += conn.results;
+                errors += conn.errors;
+                allOk = allOk && conn.ok;
+            }
+            if (!allOk) {
+                printf("ERRO: conexao falhou ou terminou antes (servidor rodando em %s?)\n",
+                       config.socketPath.c_str());
+                return 1;
+            }
+            std::sort(latencies.begin(), latencies.end());
+            double qps = seconds > 0 ? latencies.size() / seconds : 0.0;
+
+            printf("%-6d %-6d %-12.0f %-10.1f %-10.1f %-10.1f %-10.1f %-10.1f %-10.1f\n", connectionCount, depth,
+                   qps, percentile(latencies, 0.50) * 1000.0, percentile(latencies, 0.90) * 1000.0,
+                   percentile(latencies, 0.99) * 1000.0, percentile(latencies, 0.999) * 1000.0,
+                   latencies.back() * 1000.0, latencies.empty() ? 0.0 : (double)results / latencies.size());
+            if (errors > 0) printf("  AVISO: %lld respostas com erro\n", errors);
+
+            BenchmarkRecord record;
+            record.driver = "load_generator";
+            record.structure = "server " + formatParam("conn", connectionCount, 0) + " " +
+                               formatParam("depth", depth, 0);
+            record.scale = (long long)latencies.size();
+            record.distribution = "uniforme";
+            record.seed = config.seed;
+            record.threshold = config.threshold;
+            record.searchMs = latencies;
+            record.found = results;
+            record.throughput.emplace_back(connectionCount, qps);
+            records.push_back(record);
+        }
+    }
+
+    if (config.report.enabled()) {
+        std::cout << "\n";
+        writeReports(config.report, records);
+    }
+    return 0;
+}
@@ -0,0 +1,286 @@
+/*
+=============================================================================
+SERVIDOR DE CONSULTAS - PAA Assignment 1
+=============================================================================
+
+Constroi UMA estrutura uma vez e responde consultas por raio e kNN num Unix
+domain socket (protocolo binario em headers/query_protocol.h), em vez de
+reconstruir o indice a cada execucao.
+
+  --socket PATH        caminho do socket (padrao /tmp/paa_query.sock)
+  --structure KEY      qualquer chave do benchmark (padrao hash)
+  --cell-size X        tamanho de celula (hash, hashdyn, hash-sharded, hash-t, hybrid, hash-quantile)
+  --leaf-capacity N    maxImagesPerNode (arvores)
+  --coord C            double,float,uint8 (so estruturas -t; as demais sao double)
+  --frame F            rgb,pca: pca indexa nos eixos principais dos dados (padrao rgb; nao -t)
+  --scale N            imagens do dataset (sufixos K/M, padrao 1M)
+  --distribution D     uniforme,gaussiana,clusters,diagonal,real (padrao uniforme)
+  --images DIR         pasta da distribuicao real
+  --seed N             seed do dataset sintetico (padrao 42)
+  --batch N            maximo de consultas por lote (padrao 256)
+
+MODELO DE EXECUCAO:
+- Uma thread por conexao le tudo o que chegou no socket: cada requisicao
+  completa no buffer entra no lote (pipelining: o cliente nao espera)
+- O lote e resolvido no pool de threads (parallelFor, uma consulta por
+  tarefa; as buscas sao const e reentrantes) e todas as respostas saem num
+  unico write, na ordem de chegada
+- Quanto mais requisicoes em voo, maiores os lotes: menos syscalls e mais
+  nucleos por leitura do socket
+
+Encerramento: SIGINT/SIGTERM (Ctrl+C) remove o socket e imprime estatisticas.
+
+=============================================================================
+*/
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <csignal>
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include "../headers/image.h"
+#include "../headers/structure_factory.h"
+#include "../headers/command_line.h"
+#include "../headers/dataset.h"
+#include "../headers/query_protocol.h"
+#include "../headers/thread_pool.h"
+
+// ============================================================================
+// CONFIGURACAO (LINHA DE COMANDO)
+// ============================================================================
+struct ServerConfig {
+    std::string socketPath = kDefaultSocketPath;
+    StructureVariant variant{"hash"};
+    bool cellSizeGiven = false;
+    bool leafCapacityGiven = false;
+    long long scale = 1000000;
+    std::string distribution = "uniforme";
+    std::string imagesPath = "./images/";
+    unsigned seed = 42;
+    size_t maxBatch = 256;
+};
+
+void printUsage(const char* program) {
+    printf("Uso: %s [opcoes]\n", program);
+    printf("  --socket PATH       caminho do socket (padrao %s)\n", kDefaultSocketPath);
+    printf("  --structure KEY     estrutura (padrao hash; mesmas chaves do benchmark)\n");
+    printf("  --cell-size X       tamanho de celula\n");
+    printf("  --leaf-capacity N   maxImagesPerNode\n");
+    printf("  --coord C           double,float,uint8 (so estruturas -t; as demais sao double)\n");
+    printf("  --frame F           rgb,pca (referencial dos eixos principais; nao -t)\n");
+    printf("  --scale N           imagens (ex.: 1M)\n");
+    printf("  --distribution D    uniforme,gaussiana,clusters,diagonal,real\n");
+    printf("  --images DIR        pasta da distribuicao real\n");
+    printf("  --seed N            seed do dataset sintetico\n");
+    printf("  --batch N           maximo de consultas por lote (padrao 256)\n");
+}
+
+bool parseArguments(int argc, char** argv, ServerConfig& config) {
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg == "--help" || arg == "-h") return false;
+        if (i + 1 >= argc) {
+            printf("ERRO: %s requer um valor\n", arg.c_str());
+            return false;
+        }
+        std::string value = argv[++i];
+
+        if (arg == "--socket") config.socketPath = value;
+        else if (arg == "--structure") config.variant.key = value;
+        else if (arg == "--cell-size") {
+            if (!parsePositive(value, config.variant.cellSize)) {
+                printf("ERRO: --cell-size deve ser positivo ('%s')\n", value.c_str());
+                return false;
+            }
+            config.cellSizeGiven = true;
+        } else if (arg == "--leaf-capacity") {
+            config.variant.leafCapacity = std::max(1, std::atoi(value.c_str()));
+            config.leafCapacityGiven = true;
+        } else if (arg == "--coord") config.variant.coord = value;
+        else if (arg == "--frame") config.variant.frame = value == "rgb" ? "" : value;
+        else if (arg == "--scale") config.scale = parseScale(value);
+        else if (arg == "--distribution") config.distribution = value;
+        else if (arg == "--images") config.imagesPath = value;
+        else if (arg == "--seed") config.seed = (unsigned)std::strtoul(value.c_str(), nullptr, 10);
+        else if (arg == "--batch") config.maxBatch = (size_t)std::max(1, std::atoi(value.c_str()));
+        else {
+            printf("ERRO: opcao desconhecida '%s'\n", arg.c_str());
+            return false;
+        }
+    }
+
+    StructureVariant& variant = config.variant;
+    if (std::find(kStructureKeys.begin(), kStructureKeys.end(), variant.key) == kStructureKeys.end()) {
+        printf("ERRO: estrutura desconhecida '%s'\n", variant.key.c_str());
+        return false;
+    }
+    if (!variant.frame.empty() && std::find(kFrames.begin(), kFrames.end(), variant.frame) == kFrames.end()) {
+        printf("ERRO: referencial desconhecido '%s' (rgb,pca)\n", variant.frame.c_str());
+        return false;
+    }
+    if (!config.cellSizeGiven) variant.cellSize = defaultCellSize(variant.key);
+    if (!config.leafCapacityGiven) variant.leafCapacity = defaultLeafCapacity(variant.key);
+    if (!variant.coord.empty() && !isStaticKey(variant.key)) {
+        printf("AVISO: --coord ignorado: %s guarda coordenadas double (so estruturas -t)\n", variant.key.c_str());
+        variant.coord.clear();
+    }
+    if (isStaticKey(variant.key)) {
+        if (variant.coord.empty()) variant.coord = "double";
+        variant.cellSize = (double)std::lround(variant.cellSize);
+        if (!staticVariantSupported(variant)) return false;
+    }
+    if (!frameSupported(variant)) return false;
+    return config.scale > 0;
+}
+
+// ============================================================================
+// ATENDIMENTO DAS CONEXOES
+// ============================================================================
+
+std::atomic<bool> stopRequested(false);
+std::atomic<unsigned long long> totalRequests(0);
+std::atomic<unsigned long long> totalBatches(0);
+
+void handleSignal(int) { stopRequested = true; }
+
+// Resolve uma requisicao e grava a resposta em out (chamado dentro de uma
+// tarefa do pool). Raio: forEachSimilar escreve cada resultado direto no
+// formato do protocolo, sem montar um vector<Image> (nomes inclusos)
+void answerRequest(const ImageDatabase& db, const WireRequest& request, std::vector<char>& out) {
+    Image query(-1, "", request.r, request.g, request.b);
+    if (request.type == WIRE_QUERY_RANGE && request.threshold >= 0) {
+        size_t headerOffset = beginResponse(out, request.requestId, WIRE_STATUS_OK);
+        uint32_t count = 0;
+        db.forEachSimilar(query, request.threshold, [&out, &count](const Image& img) {
+            appendWireImage(out, img);
+            count++;
+            return true;
+        });
+        finishResponse(out, headerOffset, count);
+    } else if (request.type == WIRE_QUERY_KNN && request.k > 0 && request.k <= kMaxKnn) {
+        appendResponse(out, request.requestId, WIRE_STATUS_OK, db.findKNearest(query, request.k));
+    } else {
+        appendResponse(out, request.requestId, WIRE_STATUS_BAD_REQUEST, {});
+    }
+}
+
+void serveConnection(int fd, const ImageDatabase& db, ThreadPool& pool, size_t maxBatch) {
+    std::vector<char> input;
+    std::vector<char> output;
+    char chunk[65536];
+
+    while (!stopRequested) {
+        pollfd waitFor{fd, POLLIN, 0};
+        int ready = poll(&waitFor, 1, 200);
+        if (ready < 0 && errno != EINTR) break;
+        if (ready <= 0) continue;
+
+        ssize_t received = read(fd, chunk, sizeof(chunk));
+        if (received < 0 && errno == EINTR) continue;
+        if (received <= 0) break;  // cliente fechou
+        input.insert(input.end(), chunk, chunk + received);
+
+        // Todas as requisicoes completas viram lotes de ate maxBatch
+        size_t available = input.size() / sizeof(WireRequest);
+        size_t consumed = 0;
+        output.clear();
+        while (consumed < available) {
+            size_t batchSize = std::min(maxBatch, available - consumed);
+            std::vector<WireRequest> batch(batchSize);
+            std::memcpy(batch.data(), input.data() + consumed * sizeof(WireRequest), batchSize * sizeof(WireRequest));
+
+            std::vector<std::vector<char>> answers(batchSize);
+            pool.parallelFor(batchSize, [&](size_t q) { answerRequest(db, batch[q], answers[q]); });
+
+            for (const auto& answer : answers) output.insert(output.end(), answer.begin(), answer.end());
+            consumed += batchSize;
+            totalBatches++;
+            totalRequests += batchSize;
+        }
+        input.erase(input.begin(), input.begin() + consumed * sizeof(WireRequest));
+        // Cliente que nao le respostas nao pode prender esta thread (nem o join do Ctrl+C)
+        if (!output.empty() && !writeAllUnless(fd, output.data(), output.size(), stopRequested)) break;
+    }
+    close(fd);
+}
+
+// ============================================================================
+// MAIN - SERVIDOR
+// ============================================================================
+int main(int argc, char** argv) {
+    ServerConfig config;
+    if (!parseArguments(argc, argv, config)) {
+        printUsage(argv[0]);
+        return 1;
+    }
+
+    std::cout << "==================================================================================\n";
+    std::cout << " SERVIDOR DE CONSULTAS - PAA Assignment 1\n";
+    std::cout << "==================================================================================\n\n";
+
+    std::vector<Image> dataset = config.distribution == "real"
+        ? loadRealDataset(config.scale, config.imagesPath)
+        : generateSyntheticDataset(config.scale, config.distribution, config.seed);
+    if (dataset.empty()) {
+        printf("ERRO: dataset vazio\n");
+        return 1;
+    }
+
+    std::unique_ptr<ImageDatabase> db = makeStructure(config.variant);
+    auto startBuild = std::chrono::high_resolution_clock::now();
+    for (const auto& img : dataset) db->insert(img);
+    auto endBuild = std::chrono::high_resolution_clock::now();
+    std::vector<Image>().swap(dataset);
+    printf("Indice: %s | %zu imagens (%s) | construcao %.1fms | %.1f bytes/imagem\n", db->getName().c_str(),
+           db->size(), config.distribution.c_str(),
+           std::chrono::duration<double, std::milli>(endBuild - startBuild).count(),
+           db->memoryUsage().bytesPerImage(db->size()));
+
+    sockaddr_un address;
+    if (!makeSocketAddress(config.socketPath, address)) {
+        printf("ERRO: caminho do socket muito longo: %s\n", config.socketPath.c_str());
+        return 1;
+    }
+    int listener = socket(AF_UNIX, SOCK_STREAM, 0);
+    unlink(config.socketPath.c_str());
+    if (listener < 0 || bind(listener, (sockaddr*)&address, sizeof(address)) != 0 || listen(listener, 64) != 0) {
+        perror("ERRO ao abrir o socket");
+        return 1;
+    }
+
+    std::signal(SIGINT, handleSignal);
+    std::signal(SIGTERM, handleSignal);
+
+    std::shared_ptr<ThreadPool> pool = ThreadPool::shared();
+    printf("Escutando em %s | pool: %d threads | lote maximo: %zu (Ctrl+C encerra)\n",
+           config.socketPath.c_str(), pool->concurrency(), config.maxBatch);
+    fflush(stdout);
+
+    std::vector<std::thread> connections;
+    while (!stopRequested) {
+        pollfd waitFor{listener, POLLIN, 0};
+        if (poll(&waitFor, 1, 200) <= 0) continue;
+        int client = accept(listener, nullptr, nullptr);
+        if (client < 0) continue;
+        connections.emplace_back(serveConnection, client, std::cref(*db), std::ref(*pool), config.maxBatch);
+    }
+
+    for (auto& connection : connections) connection.join();
+    close(listener);
+    unlink(config.socketPath.c_str());
+
+    unsigned long long batches = totalBatches.load();
+    printf("\nEncerrado: %llu consultas em %llu lotes (%.1f consultas/lote), %zu conexoes\n",
+           totalRequests.load(), batches, batches ? (double)totalRequests.load() / batches : 0.0,
+           connections.size());
+    return 0;
+}